@@ -6,128 +6,362 @@
 
 #include <Wire.h>
 #include <LiquidCrystal_I2C.h>
-#include <DHT.h>
+#include "DhtReader.h"
+#include <HubLink.h>
+#include "CommandReader.h"
+#include "Scheduler.h"
+#include "LcdFrameBuffer.h"
+#include "LoopProfiler.h"
 
 // --- CONSTANTS ---
-const uint8_t PIN_DHT          = 4;      
+const uint8_t PIN_DHT          = 4;      // Port D: PCINT20, serviced by PCINT2_vect
 const uint16_t BAUD_RATE       = 9600;   
 const uint32_t SENSOR_INTERVAL = 2000;   
 
+// Link Protocol: true = binary HubLink frames, false = legacy ASCII lines.
+// Must match USE_BINARY_LINK in the ESP32 sketch.
+const bool USE_BINARY_LINK     = true;
+
+// Profiling build: times every loop() pass and command, tracks stack and free SRAM, and prints
+// a [PROFILE] line every PROFILE_REPORT_INTERVAL ms. The ESP32 ignores these lines.
+// The simavr harness (native/avr) turns it on with -DHUB_PROFILE_LOOP=1.
+#ifndef HUB_PROFILE_LOOP
+#define HUB_PROFILE_LOOP 0
+#endif
+const bool PROFILE_LOOP        = HUB_PROFILE_LOOP;
+const uint16_t PROFILE_REPORT_INTERVAL = 10000;
+
 // LCD Configuration
 const uint8_t LCD_I2C_ADDR     = 0x27;   
 const uint8_t LCD_COLUMNS      = 16;
 const uint8_t LCD_ROWS         = 2;
 
+// LCD Overlay Durations (ms)
+const uint16_t BOOT_SPLASH_DURATION   = 1500;
+const uint16_t RESET_NOTICE_DURATION  = 2000;
+const uint16_t WEB_MESSAGE_DURATION   = 4000;
+
 // --- GLOBAL OBJECTS ---
-DHT dht(PIN_DHT, DHT11);
+DhtReader dht(PIN_DHT);
 LiquidCrystal_I2C lcd(LCD_I2C_ADDR, LCD_COLUMNS, LCD_ROWS);
+LcdFrameBuffer<LCD_COLUMNS, LCD_ROWS> screen(lcd); // All drawing goes through here, never lcd directly
 
 float currentHum = 0.0;
 float minHum     = 100.0;
 float maxHum     = 0.0;
-unsigned long lastSensorReadTime = 0;
+bool hasSample = false;
+bool telemetryPending = false;
+
+// LCD overlay state (boot splash, reset confirmation, web messages)
+bool overlayActive = false;
+unsigned long overlayStartTime = 0;
+uint16_t overlayDuration = 0;
+
+Scheduler scheduler;
+
+HubLinkDecoder linkDecoder;
+CommandReader commandReader;
+uint8_t linkTxSeq = 0;
+uint16_t rejectedCommands = 0;
+
+LoopProfiler profiler;
 
 /**
- * @brief Initialization: Sets up peripherals and displays boot splash.
+ * @brief Initialization: Sets up peripherals, displays boot splash and registers the tasks.
  */
 void setup() {
+  if (PROFILE_LOOP) profiler.begin();
   Serial.begin(BAUD_RATE);
   dht.begin();
   
   lcd.init();
   lcd.backlight();
   
-  // Initial Boot Screen
-  lcd.setCursor(0, 0);
-  lcd.print("SYSTEM STARTING");
-  lcd.setCursor(0, 1);
-  lcd.print("WAITING FOR DATA");
-  delay(1500);
-  lcd.clear();
+  // Initial Boot Screen (expires on its own; sampling starts immediately)
+  showOverlay("SYSTEM STARTING", "WAITING FOR DATA", BOOT_SPLASH_DURATION);
+
+  unsigned long now = millis();
+  scheduler.add(taskSensor, SENSOR_INTERVAL, now);
+  scheduler.add(taskSensorResult, 0, now);
+  scheduler.add(taskTelemetry, 0, now);
+  scheduler.add(taskCommands, 0, now);
+  scheduler.add(taskDisplay, 0, now);
+  if (PROFILE_LOOP) scheduler.add(taskProfile, PROFILE_REPORT_INTERVAL, now);
 }
 
 void loop() {
-  unsigned long currentTime = millis();
+  if (PROFILE_LOOP) profiler.passStart();
+  scheduler.run(millis());
+  if (PROFILE_LOOP) profiler.passEnd();
+}
+
+// --- TASKS ---
+// Every task returns immediately; nothing in the sketch may call delay().
 
-  // --- TASK 1: SENSOR ACQUISITION & OUTBOUND TELEMETRY ---
-  // Uses non-blocking millis() to ensure the Serial port stays responsive
-  if (currentTime - lastSensorReadTime >= SENSOR_INTERVAL)
+/**
+ * @brief Forwards DHT11 line edges to the interrupt-driven reader.
+ */
+ISR(PCINT2_vect)
+{
+  dht.handleEdge();
+}
+
+/**
+ * @brief TASK 1: SENSOR ACQUISITION. Runs every SENSOR_INTERVAL.
+ * Only starts the read; the response is decoded in the background.
+ */
+void taskSensor(unsigned long now)
+{
+  dht.start(now);
+}
+
+/**
+ * @brief TASK 1b: SENSOR RESULT. Picks up a finished DHT11 read.
+ */
+void taskSensorResult(unsigned long now)
+{
+  if (!dht.poll(now)) return;
+
+  // Only process if the reading is valid
+  if (dht.status() == DhtStatus::Ok)
   {
-    float h = dht.readHumidity();
+    currentHum = dht.humidity();
+    
+    // Track lifetime highs and lows
+    if (currentHum < minHum) minHum = currentHum;
+    if (currentHum > maxHum) maxHum = currentHum;
 
-    // Only process if the reading is valid
-    if (!isnan(h))
-    {
-      currentHum = h;
-      
-      // Track lifetime highs and lows
-      if (currentHum < minHum) minHum = currentHum;
-      if (currentHum > maxHum) maxHum = currentHum;
-
-      // Update Local LCD Display (Row 0: Current, Row 1: Stats)
-      lcd.setCursor(0, 0);
-      lcd.print("Humidity: "); 
-      lcd.print(currentHum, 1);
-      lcd.print("% "); 
-      
-      lcd.setCursor(0, 1);
-      lcd.print("L:"); lcd.print(minHum, 0); 
-      lcd.print("%  H:"); lcd.print(maxHum, 0); lcd.print("%  ");
-
-      // TRANSMIT: Sent to ESP32 for parsing. 
-      // Prefix [DHT11] is the trigger for the ESP32's parsing logic.
-      Serial.print("[DHT11] ");
-      Serial.print("Current = ");
-      Serial.print(currentHum, 1);
-      Serial.print(", Min = ");
-      Serial.print(minHum, 1);
-      Serial.print(", Max = ");
-      Serial.print(maxHum, 1);
-      Serial.println(",");
-    }
-    lastSensorReadTime = currentTime;
+    hasSample = true;
+    telemetryPending = true;
+    if (!overlayActive) drawSensorScreen();
   }
+}
+
+/**
+ * @brief TASK 2: OUTBOUND TELEMETRY. Sends each new sample once, whatever the LCD is showing.
+ */
+void taskTelemetry(unsigned long /* now */)
+{
+  if (!telemetryPending) return;
+  telemetryPending = false;
+  sendTelemetry();
+}
 
-  // --- TASK 2: COMMAND INBOUND PROCESSING ---
-  // Listens for commands coming from the ESP32 Web Interface
-  if (Serial.available() > 0) 
+/**
+ * @brief TASK 3: COMMAND INBOUND PROCESSING.
+ * Listens for commands coming from the ESP32 Web Interface.
+ * Only the bytes already received are consumed, so a partial command never stalls the loop.
+ */
+void taskCommands(unsigned long /* now */)
+{
+  while (Serial.available() > 0)
   {
-    String cmd = Serial.readStringUntil('\n');
-    cmd.trim();
+    char c = Serial.read();
 
-    // PROTOCOL: R:1 -> Reset min/max history
-    if (cmd == "R:1")
+    if (USE_BINARY_LINK)
     {
-      Serial.println("[LOG] Reset command received. Clearing history...");
-      
-      minHum = currentHum;
-      maxHum = currentHum;
-      
-      lcd.clear();
-      lcd.setCursor(0,0);
-      lcd.print(">> RESETTING <<");
-      lcd.setCursor(0,1);
-      lcd.print(" MIN/MAX CLEARED");
-      delay(2000); // Temporary block to show status on LCD
-      lcd.clear();
-    } 
-    // PROTOCOL: M:<text> -> Remote message display
-    else if (cmd.startsWith("M:"))
+      if (linkDecoder.feed(c))
+      {
+        if (PROFILE_LOOP) profiler.commandStart(linkDecoder.frame().seq);
+        dispatchFrame(linkDecoder.frame());
+        if (PROFILE_LOOP) profiler.commandEnd();
+      }
+    }
+    else if (commandReader.feed(c))
     {
-      String msg = cmd.substring(2);
-      
-      Serial.print("[LOG] Web Message received: ");
-      Serial.println(msg);
-      
-      lcd.clear();
-      lcd.setCursor(0, 0);
-      lcd.print("WEB MESSAGE:");
-      lcd.setCursor(0, 1);
-      
-      // Truncate to 16 characters to fit standard LCD width
-      lcd.print(msg.substring(0, 16)); 
-      delay(4000); // Display message for 4 seconds before returning to sensor data
-      lcd.clear();
+      if (PROFILE_LOOP) profiler.commandStart();
+      dispatchCommand(commandReader.line(), commandReader.length());
+      if (PROFILE_LOOP) profiler.commandEnd();
     }
   }
 }
+
+/**
+ * @brief TASK 4: LCD OVERLAY EXPIRY. Returns to the sensor screen once an overlay has timed out.
+ */
+void taskDisplay(unsigned long now)
+{
+  if (!overlayActive || now - overlayStartTime < overlayDuration) return;
+
+  overlayActive = false;
+  if (hasSample)
+  {
+    drawSensorScreen();
+  }
+  else
+  {
+    screen.clear();
+    screen.render();
+  }
+}
+
+/**
+ * @brief TASK 5: PROFILE REPORT. Only registered when PROFILE_LOOP is set.
+ * Printing can fill the TX buffer and block, so this pass is left out of the loop figures.
+ */
+void taskProfile(unsigned long /* now */)
+{
+  profiler.report(Serial);
+  profiler.skipPass();
+}
+
+// --- DISPLAY ---
+
+/**
+ * @brief Update Local LCD Display (Row 0: Current, Row 1: Stats)
+ * Only the characters that differ from the panel are sent, so a typical
+ * humidity change costs a couple of cells instead of two full rows.
+ */
+void drawSensorScreen()
+{
+  screen.clear();
+  screen.setCursor(0, 0);
+  screen.print("Humidity: "); 
+  screen.print(currentHum, 1);
+  screen.print("%"); 
+  
+  screen.setCursor(0, 1);
+  screen.print("L:"); screen.print(minHum, 0); 
+  screen.print("%  H:"); screen.print(maxHum, 0); screen.print("%");
+  screen.render();
+}
+
+/**
+ * @brief Shows a two-line status screen that replaces the sensor screen for a while.
+ * @param duration Time in ms before taskDisplay() restores the sensor screen.
+ */
+void showOverlay(const char *row0, const char *row1, uint16_t duration)
+{
+  screen.clear();
+  screen.setCursor(0, 0);
+  screen.print(row0);
+  screen.setCursor(0, 1);
+  screen.print(row1);
+  screen.render();
+
+  overlayActive = true;
+  overlayStartTime = millis();
+  overlayDuration = duration;
+}
+
+// --- COMMANDS ---
+
+/**
+ * @brief Executes one ASCII command line (already trimmed, NUL-terminated).
+ */
+void dispatchCommand(const char *cmd, uint8_t length)
+{
+  // PROTOCOL: R:1 -> Reset min/max history
+  if (strcmp(cmd, "R:1") == 0)
+  {
+    handleResetCommand();
+  }
+  // PROTOCOL: M:<text> -> Remote message display
+  else if (strncmp(cmd, "M:", 2) == 0)
+  {
+    // An over-long message only loses characters the LCD could not show anyway
+    handleMessageCommand(cmd + 2, length - 2);
+  }
+  else
+  {
+    rejectCommand();
+  }
+}
+
+/**
+ * @brief Executes one binary command frame.
+ */
+void dispatchFrame(const HubLinkFrame &frame)
+{
+  if (frame.type == HUBLINK_RESET)
+    handleResetCommand();
+  else if (frame.type == HUBLINK_MESSAGE)
+    handleMessageCommand((const char *)frame.payload, frame.length);
+  else
+    rejectCommand();
+}
+
+/**
+ * @brief Counts an unrecognised command and reports the running error total.
+ */
+void rejectCommand()
+{
+  rejectedCommands++;
+
+  // Each line is counted here once, truncated or not; a truncated M: line is not an error.
+  // Frames with a bad CRC never reach the dispatcher, so the decoder counts those.
+  Serial.print("[LOG] Rejected command. Errors so far: ");
+  Serial.println(rejectedCommands + linkDecoder.rejectedFrames());
+}
+
+/**
+ * @brief Sends the current readings to the ESP32, in the configured link format.
+ */
+void sendTelemetry()
+{
+  if (USE_BINARY_LINK)
+  {
+    HubLinkFrame frame;
+    hubLinkMakeTelemetry(frame, linkTxSeq++, toFixedTenths(currentHum), toFixedTenths(minHum), toFixedTenths(maxHum));
+
+    uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+    Serial.write(wire, hubLinkEncode(frame, wire));
+    return;
+  }
+
+  // TRANSMIT: Sent to ESP32 for parsing. 
+  // Prefix [DHT11] is the trigger for the ESP32's parsing logic.
+  Serial.print("[DHT11] ");
+  Serial.print("Current = ");
+  Serial.print(currentHum, 1);
+  Serial.print(", Min = ");
+  Serial.print(minHum, 1);
+  Serial.print(", Max = ");
+  Serial.print(maxHum, 1);
+  Serial.println(",");
+}
+
+/** Converts a humidity reading to the link's fixed-point format (tenths of a percent) */
+int16_t toFixedTenths(float value)
+{
+  return (int16_t)lround(value * 10.0f);
+}
+
+/**
+ * @brief PROTOCOL: R:1 / HUBLINK_RESET -> Reset min/max history
+ */
+void handleResetCommand()
+{
+  Serial.println("[LOG] Reset command received. Clearing history...");
+  
+  minHum = currentHum;
+  maxHum = currentHum;
+  
+  showOverlay(">> RESETTING <<", " MIN/MAX CLEARED", RESET_NOTICE_DURATION);
+}
+
+/**
+ * @brief PROTOCOL: M:<text> / HUBLINK_MESSAGE -> Remote message display
+ * @param msg Message text, not necessarily NUL-terminated.
+ * @param length Number of characters in msg.
+ */
+void handleMessageCommand(const char *msg, size_t length)
+{
+  // Truncate to 16 characters to fit standard LCD width
+  char line[LCD_COLUMNS + 1];
+  if (length > LCD_COLUMNS) length = LCD_COLUMNS;
+
+  // Only printable ASCII: the HD44780 maps 0x00-0x07 to custom glyphs and 0x80+ to kana,
+  // and an embedded NUL from a binary frame would cut the line short
+  for (size_t i = 0; i < length; i++)
+  {
+    line[i] = (msg[i] >= ' ' && msg[i] <= '~') ? msg[i] : ' ';
+  }
+  line[length] = '\0';
+
+  Serial.print("[LOG] Web Message received: ");
+  Serial.println(line);
+  
+  // Display message for 4 seconds before returning to sensor data
+  showOverlay("WEB MESSAGE:", line, WEB_MESSAGE_DURATION);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file CommandReader.h
+ * @brief Non-blocking line assembler for ASCII commands from the ESP32.
+ * Bytes are pushed in as Serial.available() reports them; a command is handed
+ * back once its '\n' arrives. Uses one fixed buffer, no String and no heap.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Longest command kept: "M:" + one LCD row + slack. Longer lines are truncated.
+const uint8_t COMMAND_BUFFER_SIZE = 24;
+
+class CommandReader {
+public:
+  /**
+   * @brief Consumes one received byte.
+   * @return true when this byte completed a non-empty line, available from line().
+   */
+  bool feed(char c) {
+    if (_complete) {
+      _length = 0;
+      _truncated = false;
+      _complete = false;
+    }
+
+    if (c == '\n') {
+      // Equivalent of String::trim() on the trailing side
+      while (_length > 0 && isSpace(_buffer[_length - 1])) _length--;
+      _buffer[_length] = '\0';
+      if (_truncated) _overflows++;
+      _complete = true;
+      return _length > 0;
+    }
+
+    // Equivalent of String::trim() on the leading side
+    if (_length == 0 && isSpace(c)) return false;
+
+    // A NUL (line noise) would hide the rest of the line from strcmp() in the dispatcher
+    if (c == '\0') return false;
+
+    if (_length < COMMAND_BUFFER_SIZE - 1) _buffer[_length++] = c;
+    else _truncated = true;
+    return false;
+  }
+
+  /** NUL-terminated, trimmed command. Valid until the next feed(). */
+  const char *line() const { return _buffer; }
+  uint8_t length() const { return _length; }
+
+  /** True if the current line was longer than the buffer and lost its tail */
+  bool truncated() const { return _truncated; }
+
+  /** Number of lines that did not fit the buffer */
+  uint16_t overflows() const { return _overflows; }
+
+private:
+  static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+  char _buffer[COMMAND_BUFFER_SIZE];
+  uint8_t _length = 0;
+  bool _truncated = false;
+  bool _complete = false;
+  uint16_t _overflows = 0;
+};
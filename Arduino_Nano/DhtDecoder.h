@@ -0,0 +1,66 @@
+/**
+ * @file DhtDecoder.h
+ * @brief Turns the falling-edge timestamps of a DHT11 response into a reading.
+ * Pure logic with no hardware access, so recorded pulse traces can be replayed on a host.
+ *
+ * After the start signal the sensor pulls the line low for 80us, releases it for 80us,
+ * then sends 40 bits, each a 50us low followed by a 26-28us (0) or 70us (1) high,
+ * and ends with a 50us low. Measured between consecutive falling edges that is
+ * ~160us for the preamble and ~77us / ~120us per bit.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t DHT_DATA_BITS = 40;
+const uint8_t DHT_EDGE_COUNT = DHT_DATA_BITS + 2; // Preamble falling edge + one per bit + trailer
+
+// Falling-edge to falling-edge periods, in microseconds
+const uint16_t DHT_PREAMBLE_MIN_US = 120;
+const uint16_t DHT_PREAMBLE_MAX_US = 220;
+const uint16_t DHT_BIT_MIN_US = 55;
+const uint16_t DHT_BIT_ONE_US = 100; // Periods at or above this are a 1
+const uint16_t DHT_BIT_MAX_US = 160;
+
+enum class DhtStatus : uint8_t {
+  Ok,
+  Timeout,      // Fewer edges than a full response
+  BadTiming,    // An edge period outside the protocol's window
+  BadChecksum
+};
+
+struct DhtReading {
+  uint8_t humidity;          // Integral %RH
+  uint8_t humidityDecimal;   // Always 0 on the DHT11
+  uint8_t temperature;       // Integral degC
+  uint8_t temperatureDecimal;
+};
+
+/**
+ * @brief Decodes one response.
+ * @param edges Low 16 bits of micros() at each falling edge; wraparound is handled.
+ * @param count Number of edges captured.
+ */
+inline DhtStatus dhtDecode(const uint16_t *edges, uint8_t count, DhtReading &reading) {
+  if (count < DHT_EDGE_COUNT) return DhtStatus::Timeout;
+
+  uint16_t preamble = edges[1] - edges[0];
+  if (preamble < DHT_PREAMBLE_MIN_US || preamble > DHT_PREAMBLE_MAX_US) return DhtStatus::BadTiming;
+
+  uint8_t data[5] = {0, 0, 0, 0, 0};
+  for (uint8_t bit = 0; bit < DHT_DATA_BITS; bit++) {
+    uint16_t period = edges[bit + 2] - edges[bit + 1];
+    if (period < DHT_BIT_MIN_US || period > DHT_BIT_MAX_US) return DhtStatus::BadTiming;
+    data[bit / 8] <<= 1;
+    if (period >= DHT_BIT_ONE_US) data[bit / 8] |= 1;
+  }
+
+  if ((uint8_t)(data[0] + data[1] + data[2] + data[3]) != data[4]) return DhtStatus::BadChecksum;
+
+  reading.humidity = data[0];
+  reading.humidityDecimal = data[1];
+  reading.temperature = data[2];
+  reading.temperatureDecimal = data[3];
+  return DhtStatus::Ok;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file DhtReader.h
+ * @brief Interrupt-driven DHT11 driver for AVR.
+ * Unlike the Adafruit library, which bit-bangs the response with interrupts
+ * disabled for ~20-25 ms, this driver issues the start signal as a timed state
+ * and timestamps the response's falling edges from a pin-change interrupt.
+ * The main loop only polls for completion, so UART reception and the LCD keep running.
+ *
+ * The sketch must forward the pin's PCINT vector to handleEdge(), e.g. for D0-D7:
+ *   ISR(PCINT2_vect) { dht.handleEdge(); }
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "DhtDecoder.h"
+
+const uint8_t DHT_START_SIGNAL_MS = 20;    // The DHT11 needs the line held low for at least 18 ms
+const uint8_t DHT_RESPONSE_TIMEOUT_MS = 10; // A full response takes ~4.5 ms
+
+class DhtReader {
+public:
+  explicit DhtReader(uint8_t pin) : _pin(pin) {}
+
+  /** Resolves the pin's port and PCINT registers and enables its pin-change interrupt group */
+  void begin() {
+    _inputRegister = portInputRegister(digitalPinToPort(_pin));
+    _bitMask = digitalPinToBitMask(_pin);
+    _pcmsk = digitalPinToPCMSK(_pin);
+    _pcmskBit = _BV(digitalPinToPCMSKbit(_pin));
+    *digitalPinToPCICR(_pin) |= _BV(digitalPinToPCICRbit(_pin));
+    pinMode(_pin, INPUT_PULLUP);
+  }
+
+  /**
+   * @brief Begins a read by pulling the line low. Returns immediately.
+   * @return false if a read is already in progress.
+   */
+  bool start(unsigned long now) {
+    if (_state != State::Idle) return false;
+    pinMode(_pin, OUTPUT);
+    digitalWrite(_pin, LOW);
+    _stateTime = now;
+    _state = State::StartSignal;
+    return true;
+  }
+
+  /**
+   * @brief Advances the read. Call on every loop pass.
+   * @return true exactly once per read, when it has finished; see status().
+   */
+  bool poll(unsigned long now) {
+    switch (_state) {
+      case State::Idle:
+        return false;
+
+      case State::StartSignal:
+        if (now - _stateTime < DHT_START_SIGNAL_MS) return false;
+        // Arm before releasing the line so the sensor's first edge cannot be missed
+        _edgeCount = 0;
+        *_pcmsk |= _pcmskBit;
+        pinMode(_pin, INPUT_PULLUP);
+        _stateTime = now;
+        _state = State::Capturing;
+        return false;
+
+      case State::Capturing: {
+        uint8_t count = _edgeCount;
+        if (count < DHT_EDGE_COUNT && now - _stateTime < DHT_RESPONSE_TIMEOUT_MS) return false;
+
+        // The ISR no longer touches the edge buffer once its interrupt is masked
+        *_pcmsk &= ~_pcmskBit;
+        _status = dhtDecode((const uint16_t *)_edges, count, _reading);
+        if (_status != DhtStatus::Ok) _failures++;
+        _state = State::Idle;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Pin-change ISR body: timestamps falling edges only */
+  void handleEdge() {
+    if (*_inputRegister & _bitMask) return;
+    if (_edgeCount < DHT_EDGE_COUNT) _edges[_edgeCount++] = (uint16_t)micros();
+  }
+
+  DhtStatus status() const { return _status; }
+
+  /** Relative humidity of the last successful read, in % */
+  float humidity() const { return _reading.humidity + _reading.humidityDecimal * 0.1f; }
+
+  /** Reads that timed out or failed timing/checksum checks */
+  uint16_t failures() const { return _failures; }
+
+private:
+  enum class State : uint8_t { Idle, StartSignal, Capturing };
+
+  const uint8_t _pin;
+  volatile uint8_t *_inputRegister = nullptr;
+  uint8_t _bitMask = 0;
+  volatile uint8_t *_pcmsk = nullptr;
+  uint8_t _pcmskBit = 0;
+
+  State _state = State::Idle;
+  unsigned long _stateTime = 0;
+
+  volatile uint16_t _edges[DHT_EDGE_COUNT];
+  volatile uint8_t _edgeCount = 0;
+
+  DhtStatus _status = DhtStatus::Timeout;
+  DhtReading _reading = {0, 0, 0, 0};
+  uint16_t _failures = 0;
+};
@@ -0,0 +1,105 @@
+/**
+ * @file LcdFrameBuffer.h
+ * @brief Shadow framebuffer for the HD44780 over LiquidCrystal_I2C.
+ * Screens are composed with the usual setCursor()/print() calls into RAM, then
+ * render() compares them with what the panel already shows and only sends the
+ * cells that changed. No lcd.clear() is needed, which removes the flicker and
+ * the ~2 ms clear command.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <LiquidCrystal_I2C.h>
+
+// LiquidCrystal_I2C sends every HD44780 byte as two nibbles; each nibble takes three
+// PCF8574 writes (data, EN high, EN low), and each write is address + data on the bus.
+const uint8_t LCD_I2C_BYTES_PER_LCD_BYTE = 2 * 3 * 2;
+
+/** Cost of the last render() */
+struct LcdFrameStats {
+  uint8_t cellsWritten;  // Character writes
+  uint8_t cursorMoves;   // setCursor() commands
+  uint16_t busBytes;     // Estimated I2C bytes, address bytes included
+  uint16_t micros;       // Time spent inside render()
+};
+
+template <uint8_t Columns, uint8_t Rows>
+class LcdFrameBuffer : public Print {
+public:
+  explicit LcdFrameBuffer(LiquidCrystal_I2C &lcd) : _lcd(lcd) {
+    // After lcd.init()/lcd.clear() the panel shows blanks, which is what both buffers start as
+    memset(_shown, ' ', sizeof(_shown));
+    memset(_pending, ' ', sizeof(_pending));
+  }
+
+  /** Blanks the frame being composed; the panel is untouched until render() */
+  void clear() {
+    memset(_pending, ' ', sizeof(_pending));
+    _col = 0;
+    _row = 0;
+  }
+
+  void setCursor(uint8_t col, uint8_t row) {
+    _col = col;
+    _row = row;
+  }
+
+  /** Print backend; text past the right edge is clipped like on the real panel */
+  size_t write(uint8_t c) override {
+    if (_row < Rows && _col < Columns) _pending[_row][_col] = c;
+    _col++;
+    return 1;
+  }
+  using Print::write;
+
+  /** Pushes the differences between the composed frame and the panel */
+  void render() {
+    unsigned long start = micros();
+    _stats.cellsWritten = 0;
+    _stats.cursorMoves = 0;
+
+    // The HD44780 auto-increments its address, so runs of changed cells share one cursor move.
+    // Past the last column the address leaves the visible row, so the position becomes unknown.
+    uint8_t cursorCol = NO_CURSOR;
+    uint8_t cursorRow = NO_CURSOR;
+
+    for (uint8_t row = 0; row < Rows; row++) {
+      for (uint8_t col = 0; col < Columns; col++) {
+        if (_pending[row][col] == _shown[row][col]) continue;
+
+        if (cursorRow != row || cursorCol != col) {
+          _lcd.setCursor(col, row);
+          _stats.cursorMoves++;
+        }
+        _lcd.write(_pending[row][col]);
+        _shown[row][col] = _pending[row][col];
+        _stats.cellsWritten++;
+
+        cursorRow = row;
+        cursorCol = (col + 1 < Columns) ? col + 1 : NO_CURSOR;
+      }
+    }
+
+    _stats.busBytes = (uint16_t)(_stats.cellsWritten + _stats.cursorMoves) * LCD_I2C_BYTES_PER_LCD_BYTE;
+    _stats.micros = (uint16_t)(micros() - start);
+    _totalBusBytes += _stats.busBytes;
+  }
+
+  const LcdFrameStats &stats() const { return _stats; }
+
+  /** Estimated I2C bytes sent by render() since boot */
+  uint32_t totalBusBytes() const { return _totalBusBytes; }
+
+private:
+  static const uint8_t NO_CURSOR = 0xFF;
+
+  LiquidCrystal_I2C &_lcd;
+  char _shown[Rows][Columns];    // What the panel currently displays
+  char _pending[Rows][Columns];  // Frame being composed
+  uint8_t _col = 0;
+  uint8_t _row = 0;
+
+  LcdFrameStats _stats = {0, 0, 0, 0};
+  uint32_t _totalBusBytes = 0;
+};
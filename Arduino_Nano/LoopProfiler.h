@@ -0,0 +1,136 @@
+/**
+ * @file LoopProfiler.h
+ * @brief On-target loop timing and SRAM usage for the ATmega328P.
+ * Measures every loop() pass and every command handler with micros() (4 us resolution,
+ * i.e. 64 CPU cycles at 16 MHz), and finds the stack high-water mark by painting the free
+ * SRAM between the heap and the stack with a canary at boot: whatever the stack has ever
+ * touched no longer holds it.
+ * Only compiled in when the sketch enables PROFILE_LOOP; the numbers are meant to be
+ * compared before and after a change on the same board.
+ * Built for simavr (HUB_SIMAVR), each pass and command boundary is also written to GPIOR0
+ * (ProfileMarks.h), where native/avr/NanoSim.cpp timestamps it to the cycle.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "ProfileMarks.h"
+
+// One OUT instruction each
+#ifdef HUB_SIMAVR
+#define PROFILE_MARK(marker) (GPIOR0 = (marker))
+#define PROFILE_COMMAND_SEQ(seq) (GPIOR1 = (seq))
+#else
+#define PROFILE_MARK(marker)
+#define PROFILE_COMMAND_SEQ(seq) ((void)(seq))
+#endif
+
+const uint8_t PROFILE_STACK_CANARY = 0xC5;
+const uint8_t PROFILE_PAINT_MARGIN = 16; // Left unpainted below the stack pointer at begin()
+
+extern uint8_t __heap_start;
+extern void *__brkval;
+
+class LoopProfiler {
+public:
+  /** Paints the unused SRAM. Call early in setup(), before the stack has been deep. */
+  void begin() {
+    uint8_t *p = heapEnd();
+    uint8_t *limit = (uint8_t *)SP - PROFILE_PAINT_MARGIN;
+    while (p < limit) *p++ = PROFILE_STACK_CANARY;
+  }
+
+  void passStart() {
+    PROFILE_MARK(PROFILE_MARK_PASS_START);
+    _passStart = micros();
+  }
+
+  void passEnd() {
+    uint32_t elapsed = micros() - _passStart;
+    PROFILE_MARK(PROFILE_MARK_PASS_END);
+    if (_skipPass) {
+      _skipPass = false;
+      return;
+    }
+    _passes++;
+    _totalMicros += elapsed;
+    if (elapsed < _minMicros) _minMicros = elapsed;
+    if (elapsed > _maxMicros) _maxMicros = elapsed;
+    if (elapsed > _peakMicros) _peakMicros = elapsed;
+  }
+
+  /** Leaves the current pass out of the figures, e.g. the one that printed the report */
+  void skipPass() {
+    PROFILE_MARK(PROFILE_MARK_SKIP_PASS);
+    _skipPass = true;
+  }
+
+  /** @param seq The command frame's HubLink sequence number; 0 for ASCII lines */
+  void commandStart(uint8_t seq = 0) {
+    PROFILE_COMMAND_SEQ(seq);
+    PROFILE_MARK(PROFILE_MARK_COMMAND_START);
+    _commandStart = micros();
+  }
+
+  void commandEnd() {
+    uint32_t elapsed = micros() - _commandStart;
+    PROFILE_MARK(PROFILE_MARK_COMMAND_END);
+    if (elapsed > _commandPeakMicros) _commandPeakMicros = elapsed;
+  }
+
+  /** Bytes below the stack that it has never reached since begin() */
+  uint16_t unusedStack() const {
+    const uint8_t *p = heapEnd();
+    const uint8_t *limit = (const uint8_t *)SP;
+    uint16_t count = 0;
+    while (p < limit && *p == PROFILE_STACK_CANARY) {
+      p++;
+      count++;
+    }
+    return count;
+  }
+
+  /** Bytes between the heap and the current stack pointer */
+  uint16_t freeSram() const { return (uint16_t)((uint8_t *)SP - heapEnd()); }
+
+  /**
+   * @brief Prints one report line and starts a new window.
+   * min/avg/max cover the passes since the last report; peak and cmd_peak cover the whole run.
+   */
+  void report(Print &out) {
+    out.print("[PROFILE] passes=");
+    out.print(_passes);
+    out.print(" loop_us=");
+    out.print(_passes ? _minMicros : 0);
+    out.print('/');
+    out.print(_passes ? _totalMicros / _passes : 0);
+    out.print('/');
+    out.print(_maxMicros);
+    out.print(" peak_us=");
+    out.print(_peakMicros);
+    out.print(" cmd_peak_us=");
+    out.print(_commandPeakMicros);
+    out.print(" stack_unused=");
+    out.print(unusedStack());
+    out.print(" sram_free=");
+    out.println(freeSram());
+
+    _passes = 0;
+    _totalMicros = 0;
+    _minMicros = UINT32_MAX;
+    _maxMicros = 0;
+  }
+
+private:
+  static uint8_t *heapEnd() { return __brkval ? (uint8_t *)__brkval : &__heap_start; }
+
+  uint32_t _passStart = 0;
+  uint32_t _passes = 0;
+  uint32_t _totalMicros = 0;
+  uint32_t _minMicros = UINT32_MAX;
+  uint32_t _maxMicros = 0;
+  uint32_t _peakMicros = 0;
+  uint32_t _commandStart = 0;
+  uint32_t _commandPeakMicros = 0;
+  bool _skipPass = false;
+};
@@ -0,0 +1,18 @@
+/**
+ * @file ProfileMarks.h
+ * @brief The markers LoopProfiler writes to GPIOR0 in a simavr build (HUB_SIMAVR), shared
+ * with native/avr/NanoSim.cpp, which timestamps each one to the cycle.
+ * A command's HubLink seq goes to GPIOR1 just before its COMMAND_START, so the simulator
+ * can pair the command with the frame that carried it.
+ * Plain constants only, so the host-side simulator can include this file as well.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t PROFILE_MARK_PASS_START = 1;
+const uint8_t PROFILE_MARK_PASS_END = 2;
+const uint8_t PROFILE_MARK_COMMAND_START = 3;
+const uint8_t PROFILE_MARK_COMMAND_END = 4;
+const uint8_t PROFILE_MARK_SKIP_PASS = 5;
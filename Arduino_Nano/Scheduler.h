@@ -0,0 +1,59 @@
+/**
+ * @file Scheduler.h
+ * @brief Minimal cooperative scheduler driven by millis().
+ * Each task is a plain function that must return quickly; nothing may busy-wait.
+ * Time is passed in by the caller, so the scheduler can also run on a virtual clock.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef void (*TaskFunction)(unsigned long now);
+
+const uint8_t SCHEDULER_MAX_TASKS = 6;
+
+class Scheduler {
+public:
+  /**
+   * @brief Registers a task.
+   * @param interval Period in ms; 0 runs the task on every pass.
+   * @return false if the task table is full.
+   */
+  bool add(TaskFunction function, uint32_t interval, unsigned long now) {
+    if (_count >= SCHEDULER_MAX_TASKS) return false;
+    _tasks[_count].function = function;
+    _tasks[_count].interval = interval;
+    _tasks[_count].lastRun = now;
+    _count++;
+    return true;
+  }
+
+  /** Runs every task that is due at time now */
+  void run(unsigned long now) {
+    for (uint8_t i = 0; i < _count; i++) {
+      Task &task = _tasks[i];
+      if (task.interval == 0) {
+        task.function(now);
+        continue;
+      }
+      if (now - task.lastRun < task.interval) continue;
+
+      // Advance by whole periods so the cadence does not drift with loop jitter,
+      // but resynchronise instead of bursting if we fell more than a period behind.
+      task.lastRun += task.interval;
+      if (now - task.lastRun >= task.interval) task.lastRun = now;
+      task.function(now);
+    }
+  }
+
+private:
+  struct Task {
+    TaskFunction function;
+    uint32_t interval;
+    unsigned long lastRun;
+  };
+
+  Task _tasks[SCHEDULER_MAX_TASKS];
+  uint8_t _count = 0;
+};
@@ -0,0 +1,67 @@
+/**
+ * @file BootBench.h
+ * @brief Microbenchmark runner for hot paths, run once at boot on the ESP32 itself.
+ *
+ * Each run() times a loop of iterations with the CPU cycle counter and prints one entry of a
+ * JSON document shaped like Google Benchmark's --benchmark_format=json output, so runs from
+ * two commits can be diffed with the usual tools (e.g. benchmark's compare.py). The document
+ * goes out on one line, between begin() and end(); grep the serial log for {"context".
+ * Bodies return a value that is folded into a volatile sink, so the compiler cannot drop them.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class BootBench
+{
+public:
+    explicit BootBench(Print &out) : _out(out) {}
+
+    void begin(const char *executable)
+    {
+        _out.print("{\"context\":{\"executable\":\"");
+        _out.print(executable);
+        _out.print("\",\"num_cpus\":2,\"mhz_per_cpu\":");
+        _out.print(getCpuFrequencyMhz());
+        _out.print(",\"library_build_type\":\"release\"},\"benchmarks\":[");
+        _count = 0;
+    }
+
+    /**
+     * @brief Times body(i) for i in [0, iterations).
+     * @param body Returns any integer derived from its work; only the sink sees it.
+     */
+    template <typename Body>
+    void run(const char *name, uint32_t iterations, Body body)
+    {
+        uint32_t sink = 0;
+        uint32_t start = ESP.getCycleCount();
+        for (uint32_t i = 0; i < iterations; i++)
+            sink += (uint32_t)body(i);
+        uint32_t cycles = ESP.getCycleCount() - start; // Wraps after ~17 s at 240 MHz; keep runs short
+        _sink = sink;
+
+        float cyclesPerIteration = (float)cycles / iterations;
+        float nanos = cyclesPerIteration * 1000.0f / getCpuFrequencyMhz();
+
+        _out.print(_count++ ? ",{\"name\":\"" : "{\"name\":\"");
+        _out.print(name);
+        _out.print("\",\"run_type\":\"iteration\",\"iterations\":");
+        _out.print(iterations);
+        _out.print(",\"real_time\":");
+        _out.print(nanos, 1);
+        _out.print(",\"cpu_time\":");
+        _out.print(nanos, 1);
+        _out.print(",\"time_unit\":\"ns\",\"cycles\":");
+        _out.print(cyclesPerIteration, 1);
+        _out.print("}");
+    }
+
+    void end() { _out.println("]}"); }
+
+private:
+    Print &_out;
+    uint8_t _count = 0;
+    volatile uint32_t _sink = 0;
+};
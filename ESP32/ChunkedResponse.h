@@ -0,0 +1,79 @@
+/**
+ * @file ChunkedResponse.h
+ * @brief Streams a response body with chunked transfer encoding from a fixed buffer.
+ * Unlike server.send(code, type, String), the body is never held in memory as a whole,
+ * so responses of any size cost the same RAM.
+ */
+
+#pragma once
+
+#include <WebServer.h>
+#include "FixedPoint.h"
+
+const uint16_t CHUNKED_BUFFER_SIZE = 1024; // One chunk; roughly one TCP segment
+
+class ChunkedResponse
+{
+public:
+    /** Sends the status line and headers; the body follows through the writer methods */
+    ChunkedResponse(WebServer &server, int code, const char *contentType) : _server(server)
+    {
+        _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        _server.send(code, contentType, "");
+    }
+
+    ChunkedResponse &write(const char *data, size_t length)
+    {
+        while (length > 0)
+        {
+            size_t room = sizeof(_buffer) - _length;
+            size_t count = length < room ? length : room;
+            memcpy(_buffer + _length, data, count);
+            _length += count;
+            data += count;
+            length -= count;
+            if (_length == sizeof(_buffer))
+                flush();
+        }
+        return *this;
+    }
+
+    ChunkedResponse &text(const char *s) { return write(s, strlen(s)); }
+
+    ChunkedResponse &number(uint32_t value)
+    {
+        char digits[10];
+        return write(digits, formatNumber(digits, value));
+    }
+
+    ChunkedResponse &tenths(int16_t value)
+    {
+        char digits[TENTHS_MAX_CHARS];
+        return write(digits, formatTenths(digits, value));
+    }
+
+    /** Sends whatever is buffered and the terminating zero-length chunk */
+    void finish()
+    {
+        flush();
+        _server.sendContent("");
+    }
+
+    /** Bytes handed to the server so far */
+    uint32_t sent() const { return _sent; }
+
+private:
+    void flush()
+    {
+        if (_length == 0)
+            return;
+        _server.sendContent(_buffer, _length);
+        _sent += _length;
+        _length = 0;
+    }
+
+    WebServer &_server;
+    char _buffer[CHUNKED_BUFFER_SIZE];
+    size_t _length = 0;
+    uint32_t _sent = 0;
+};
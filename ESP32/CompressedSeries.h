@@ -0,0 +1,277 @@
+/**
+ * @file CompressedSeries.h
+ * @brief Gorilla-style compressed storage for raw humidity samples.
+ *
+ * Samples are appended to fixed-size blocks. The first sample of a block is stored
+ * verbatim in its header; every later one is bit-packed as
+ *   timestamp: delta-of-delta  '0' | '10'+7b | '110'+9b | '1110'+12b | '1111'+32b
+ *   value:     delta           '0' | '10'+4b | '110'+8b | '111'+16b (zigzag-coded)
+ * A DHT11 at a steady 2 s cadence mostly repeats both, i.e. ~2 bits per sample
+ * instead of 12 bytes. Blocks are independent, so a reader can start at any block
+ * and decode sample by sample without inflating anything into RAM.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "PsramAlloc.h"
+
+const uint16_t SAMPLE_BLOCK_SIZE = 256;
+const uint16_t SAMPLE_BLOCK_HEADER_SIZE = 14;
+const uint16_t SAMPLE_BLOCK_PAYLOAD_BITS = (SAMPLE_BLOCK_SIZE - SAMPLE_BLOCK_HEADER_SIZE) * 8;
+const uint8_t SAMPLE_MAX_ENCODED_BITS = 4 + 32 + 3 + 16; // Worst case for one sample
+
+struct SampleBlock
+{
+    uint32_t firstTime;
+    uint32_t lastTime;
+    int16_t firstValue;
+    uint16_t count;
+    uint16_t bitLength;
+    uint8_t bits[SAMPLE_BLOCK_SIZE - SAMPLE_BLOCK_HEADER_SIZE];
+};
+
+inline uint32_t zigzagEncode(int32_t value) { return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31); }
+inline int32_t zigzagDecode(uint32_t value) { return (int32_t)(value >> 1) ^ -(int32_t)(value & 1); }
+
+/** Appends samples to one block */
+class SampleBlockWriter
+{
+public:
+    /** Starts a new block holding a single sample */
+    void start(SampleBlock &block, uint32_t time, int16_t value)
+    {
+        _block = &block;
+        block.firstTime = time;
+        block.lastTime = time;
+        block.firstValue = value;
+        block.count = 1;
+        block.bitLength = 0;
+        memset(block.bits, 0, sizeof(block.bits));
+        _prevDelta = 0;
+        _prevValue = value;
+    }
+
+    /** @return false if the block is full; the sample was not written and belongs in a new block. */
+    bool append(uint32_t time, int16_t value)
+    {
+        if (_block->bitLength + SAMPLE_MAX_ENCODED_BITS > SAMPLE_BLOCK_PAYLOAD_BITS || _block->count == UINT16_MAX)
+            return false;
+
+        int32_t delta = (int32_t)(time - _block->lastTime);
+        int32_t dod = delta - _prevDelta;
+        if (dod == 0)
+            writeBits(0, 1);
+        else if (dod >= -64 && dod <= 63)
+            writeField(0b10, 2, (uint32_t)dod, 7);
+        else if (dod >= -256 && dod <= 255)
+            writeField(0b110, 3, (uint32_t)dod, 9);
+        else if (dod >= -2048 && dod <= 2047)
+            writeField(0b1110, 4, (uint32_t)dod, 12);
+        else
+            writeField(0b1111, 4, (uint32_t)dod, 32);
+
+        uint32_t zigzag = zigzagEncode((int32_t)value - _prevValue);
+        if (zigzag == 0)
+            writeBits(0, 1);
+        else if (zigzag < 16)
+            writeField(0b10, 2, zigzag, 4);
+        else if (zigzag < 256)
+            writeField(0b110, 3, zigzag, 8);
+        else
+            writeField(0b111, 3, (uint16_t)value, 16);
+
+        _prevDelta = delta;
+        _prevValue = value;
+        _block->lastTime = time;
+        _block->count++;
+        return true;
+    }
+
+private:
+    /** Writes a prefix code followed by the low bits of value */
+    void writeField(uint32_t prefix, uint8_t prefixBits, uint32_t value, uint8_t valueBits)
+    {
+        writeBits(prefix, prefixBits);
+        writeBits(valueBits < 32 ? value & ((1UL << valueBits) - 1) : value, valueBits);
+    }
+
+    void writeBits(uint32_t value, uint8_t count)
+    {
+        for (int8_t i = count - 1; i >= 0; i--)
+        {
+            if (value & (1UL << i))
+                _block->bits[_block->bitLength >> 3] |= 0x80 >> (_block->bitLength & 7);
+            _block->bitLength++;
+        }
+    }
+
+    SampleBlock *_block = nullptr;
+    int32_t _prevDelta = 0;
+    int16_t _prevValue = 0;
+};
+
+/** Streams the samples of one block back out, one at a time */
+class SampleBlockReader
+{
+public:
+    explicit SampleBlockReader(const SampleBlock &block) : _block(block) {}
+
+    /** @return false once every sample has been read. */
+    bool next(uint32_t &time, int16_t &value)
+    {
+        if (_index >= _block.count)
+            return false;
+
+        if (_index == 0)
+        {
+            _time = _block.firstTime;
+            _value = _block.firstValue;
+        }
+        else
+        {
+            int32_t dod;
+            if (readBits(1) == 0)
+                dod = 0;
+            else if (readBits(1) == 0)
+                dod = signExtend(readBits(7), 7);
+            else if (readBits(1) == 0)
+                dod = signExtend(readBits(9), 9);
+            else if (readBits(1) == 0)
+                dod = signExtend(readBits(12), 12);
+            else
+                dod = (int32_t)readBits(32);
+            _delta += dod;
+            _time += (uint32_t)_delta;
+
+            // A leading 0 means the value is unchanged
+            if (readBits(1) == 1)
+            {
+                if (readBits(1) == 0)
+                    _value += (int16_t)zigzagDecode(readBits(4));
+                else if (readBits(1) == 0)
+                    _value += (int16_t)zigzagDecode(readBits(8));
+                else
+                    _value = (int16_t)readBits(16);
+            }
+        }
+
+        _index++;
+        time = _time;
+        value = _value;
+        return true;
+    }
+
+private:
+    uint32_t readBits(uint8_t count)
+    {
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            value = (value << 1) | ((_block.bits[_bit >> 3] >> (7 - (_bit & 7))) & 1);
+            _bit++;
+        }
+        return value;
+    }
+
+    static int32_t signExtend(uint32_t value, uint8_t bits)
+    {
+        uint32_t sign = 1UL << (bits - 1);
+        return (int32_t)((value ^ sign) - sign);
+    }
+
+    const SampleBlock &_block;
+    uint16_t _index = 0;
+    uint16_t _bit = 0;
+    uint32_t _time = 0;
+    int32_t _delta = 0;
+    int16_t _value = 0;
+};
+
+/**
+ * @brief Ring of compressed blocks in PSRAM; the oldest block is dropped when full.
+ * The newest block stays open for appends.
+ */
+class CompressedSeries
+{
+public:
+    bool begin(size_t blockCapacity)
+    {
+        _blocks = (SampleBlock *)psramAlloc(blockCapacity * sizeof(SampleBlock));
+        _capacity = _blocks ? blockCapacity : 0;
+        return _blocks != nullptr;
+    }
+
+    void append(uint32_t time, int16_t value)
+    {
+        _samples++;
+        if (_size > 0 && _writer.append(time, value))
+            return;
+
+        // Seal the open block (if any) and start the next one, evicting the oldest when full
+        if (_size < _capacity)
+            _size++;
+        else
+            _start = (_start + 1) % _capacity;
+        _writer.start(slot(_size - 1), time, value);
+    }
+
+    size_t blocks() const { return _size; }
+    bool full() const { return _size == _capacity; }
+
+    /** i = 0 is the oldest block */
+    const SampleBlock &block(size_t i) const { return _blocks[(_start + i) % _capacity]; }
+
+    /** Index of the first block that may hold samples at or after time */
+    size_t findBlock(uint32_t time) const
+    {
+        size_t low = 0;
+        size_t high = _size;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (block(mid).lastTime < time)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return low;
+    }
+
+    /** Calls visit(time, value) for every stored sample in [from, to], oldest first */
+    template <typename Visit>
+    void forEach(uint32_t from, uint32_t to, Visit visit) const
+    {
+        for (size_t i = findBlock(from); i < _size && block(i).firstTime <= to; i++)
+        {
+            SampleBlockReader reader(block(i));
+            uint32_t time;
+            int16_t value;
+            while (reader.next(time, value))
+            {
+                if (time > to)
+                    return;
+                if (time >= from)
+                    visit(time, value);
+            }
+        }
+    }
+
+    /** Samples appended since boot, including those already evicted */
+    uint32_t samplesAppended() const { return _samples; }
+
+    /** Bytes in use by the stored blocks */
+    size_t bytesUsed() const { return _size * sizeof(SampleBlock); }
+
+private:
+    SampleBlock &slot(size_t i) { return _blocks[(_start + i) % _capacity]; }
+
+    SampleBlock *_blocks = nullptr;
+    size_t _capacity = 0;
+    size_t _start = 0;
+    size_t _size = 0;
+    uint32_t _samples = 0;
+    SampleBlockWriter _writer;
+};
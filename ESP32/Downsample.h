@@ -0,0 +1,181 @@
+/**
+ * @file Downsample.h
+ * @brief Streaming Largest-Triangle-Three-Buckets (LTTB) downsampling for charts.
+ *
+ * [from, to] is split into points - 2 equal time buckets; the first and last samples
+ * are always kept, and from each bucket the sample forming the largest triangle with
+ * the previously kept sample and the average of the next bucket is kept. That keeps
+ * peaks and dips that plain averaging would flatten.
+ * Samples are consumed in one pass in time order. Only two buckets are held at a time
+ * (the one being decided and the one supplying its average), in a scratch buffer
+ * allocated once.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "PsramAlloc.h"
+
+struct __attribute__((packed)) LttbPoint
+{
+    uint32_t time;
+    int16_t value;
+};
+
+class LttbDownsampler
+{
+public:
+    /** @param bucketCapacity Samples buffered per bucket; beyond that they only count towards its average */
+    bool begin(size_t bucketCapacity)
+    {
+        _scratch = (LttbPoint *)psramAlloc(2 * bucketCapacity * sizeof(LttbPoint));
+        _capacity = _scratch ? bucketCapacity : 0;
+        return _scratch != nullptr;
+    }
+
+    bool ready() const { return _scratch != nullptr; }
+    size_t bucketCapacity() const { return _capacity; }
+
+    /** Starts a run over [from, to] producing at most points (>= 3) samples */
+    void start(uint32_t from, uint32_t to, uint16_t points)
+    {
+        _from = from;
+        _span = (uint64_t)(to - from) + 1;
+        _buckets = points - 2;
+        _current = {_scratch, 0};
+        _pending = {_scratch + _capacity, 0};
+        _hasFirst = false;
+        _dropped = 0;
+    }
+
+    /** Feeds the next sample in time order; emit(time, value) is called as points are decided */
+    template <typename Emit>
+    void add(uint32_t time, int16_t value, Emit emit)
+    {
+        LttbPoint point = {time, value};
+        if (!_hasFirst)
+        {
+            _hasFirst = true;
+            _anchor = point;
+            emit(time, value);
+            return;
+        }
+
+        uint32_t index = (uint32_t)((uint64_t)(time - _from) * _buckets / _span);
+        if (_current.count > 0 && index != _currentIndex)
+        {
+            if (_pending.count > 0)
+                select(_pending, _current.sumTime, _current.sumValue, _current.count, emit);
+            Bucket next = _pending;
+            _pending = _current;
+            _current = {next.points, 0};
+        }
+        _currentIndex = index;
+        _current.push(point, _capacity, _dropped);
+        _last = point;
+    }
+
+    /** Decides the remaining buckets and emits the last sample */
+    template <typename Emit>
+    void finish(Emit emit)
+    {
+        if (_current.count == 0)
+            return; // Nothing after the first sample
+
+        // The last sample is kept as is, so it takes part only as the final average
+        _current.pop(_last);
+        if (_pending.count > 0)
+        {
+            if (_current.count > 0)
+                select(_pending, _current.sumTime, _current.sumValue, _current.count, emit);
+            else
+                select(_pending, _last.time, _last.value, 1, emit);
+        }
+        if (_current.count > 0)
+            select(_current, _last.time, _last.value, 1, emit);
+        emit(_last.time, _last.value);
+    }
+
+    /** Samples that did not fit the scratch buffer in the last run */
+    uint32_t dropped() const { return _dropped; }
+
+private:
+    struct Bucket
+    {
+        LttbPoint *points;
+        uint32_t count; // All samples added, including any beyond the buffer
+        uint64_t sumTime = 0;
+        int64_t sumValue = 0;
+
+        Bucket(LttbPoint *buffer = nullptr, uint32_t n = 0) : points(buffer), count(n) {}
+
+        void push(const LttbPoint &point, size_t capacity, uint32_t &dropped)
+        {
+            if (count < capacity)
+                points[count] = point;
+            else
+                dropped++;
+            count++;
+            sumTime += point.time;
+            sumValue += point.value;
+        }
+
+        /** Removes the most recently pushed point from the average (and the buffer) */
+        void pop(const LttbPoint &point)
+        {
+            count--;
+            sumTime -= point.time;
+            sumValue -= point.value;
+        }
+    };
+
+    /**
+     * @brief Emits the point of bucket with the largest triangle against the anchor and
+     * the next bucket's average (sumTime / n, sumValue / n); the winner becomes the anchor.
+     * The area is scaled by n instead of dividing, which keeps it exact in 64-bit integers.
+     */
+    template <typename Emit>
+    void select(const Bucket &bucket, uint64_t sumTime, int64_t sumValue, uint32_t n, Emit emit)
+    {
+        // Times relative to the anchor keep every product within int64
+        int64_t nextTime = (int64_t)(sumTime - (uint64_t)_anchor.time * n);
+        int64_t nextValue = sumValue - (int64_t)_anchor.value * n;
+
+        size_t stored = bucket.count < _capacity ? bucket.count : _capacity;
+        size_t best = 0;
+        int64_t bestArea = -1;
+        for (size_t i = 0; i < stored; i++)
+        {
+            int64_t dt = (int64_t)bucket.points[i].time - _anchor.time;
+            int64_t dv = (int64_t)bucket.points[i].value - _anchor.value;
+            int64_t area = dt * nextValue - nextTime * dv;
+            if (area < 0)
+                area = -area;
+            if (area > bestArea)
+            {
+                bestArea = area;
+                best = i;
+            }
+        }
+        if (stored == 0)
+            return;
+
+        _anchor = bucket.points[best];
+        emit(_anchor.time, _anchor.value);
+    }
+
+    LttbPoint *_scratch = nullptr;
+    size_t _capacity = 0;
+
+    uint32_t _from = 0;
+    uint64_t _span = 1;
+    uint32_t _buckets = 1;
+    Bucket _current;        // Bucket being filled
+    Bucket _pending;        // Previous bucket, decided once _current is complete
+    uint32_t _currentIndex = 0;
+    LttbPoint _anchor = {0, 0}; // Last emitted point
+    LttbPoint _last = {0, 0};
+    bool _hasFirst = false;
+    uint32_t _dropped = 0;
+};
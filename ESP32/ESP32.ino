@@ -3,13 +3,31 @@
  * @brief ESP32 Network Gateway & Web Dashboard for Humidity Monitoring.
  * This file handles:
  * 1. WiFi connectivity and Web Server hosting.
- * 2. UART communication with an Arduino Nano (Hardware Serial 2).
+ * 2. UART communication with an Arduino Nano (UART 2, read by a dedicated FreeRTOS task).
  * 3. Parsing logic for the [DHT11] debug string format.
  */
 
 #include <WiFi.h>
 #include <WebServer.h>
+#include <WebSocketsServer.h>
+#include <LittleFS.h>
 #include "esp_log.h"
+#include "esp_timer.h"
+#include <HubLink.h>
+#include "TelemetryParser.h"
+#include "UartIngest.h"
+#include "WifiLink.h"
+#include "EventStream.h"
+#include "FixedPoint.h"
+#include "ChunkedResponse.h"
+#include "HubClock.h"
+#include "HistoryStore.h"
+#include "SampleLog.h"
+#include "Downsample.h"
+#include "Statistics.h"
+#include "SlidingExtremes.h"
+#include "BootBench.h"
+#include "IndexHtml.h" // Generated from web/index.html by tools/build_dashboard.py
 
 // --- HARDWARE & NETWORK CONSTANTS ---
 const uint16_t MONITOR_BAUD = 9600;  // Speed for USB Serial Monitor
@@ -17,199 +35,692 @@ const uint16_t NANO_BAUD = 9600;     // Speed for Nano-ESP32 Interconnect
 const uint8_t PIN_NANO_RX = 27;      // ESP32 RX Pin (Connect to Nano TX)
 const uint8_t PIN_NANO_TX = 14;      // ESP32 TX Pin (Connect to Nano RX)
 const uint8_t HTTP_SERVER_PORT = 80; // Defualt port for http
+const uint8_t WS_SERVER_PORT = 81;   // WebSocket channel for telemetry and commands
+const BaseType_t INGEST_CORE = 0;    // UART ingest task; loop() and the web server run on core 1
+
+// Commands to the Nano: true = binary HubLink frames, false = legacy ASCII lines.
+// Must match USE_BINARY_LINK in the Nano sketch. Telemetry is accepted in either format.
+const bool USE_BINARY_LINK = true;
+
+// Link testing only: damages received Nano bytes before decoding, reproducibly for a given seed.
+// Rates per million bytes: {seed, drop, bit flip, burst start, burst length}
+const bool LINK_FAULT_INJECTION = false;
+const LinkFaultConfig LINK_FAULTS = {0x5EED, 2000, 1000, 200, 16};
+
+// Prints hot-path microbenchmarks as one JSON line at boot (see BootBench.h), before ingest starts
+const bool RUN_BOOT_BENCHMARKS = false;
+const size_t BENCH_HISTORY_BLOCKS = 64;       // 16 KB scratch history for the ingest/query runs, kept after boot
+const uint32_t BENCH_HISTORY_SAMPLES = 20000; // ~11 h at 2 s; fits BENCH_HISTORY_BLOCKS
 
 const char *WIFI_SSID = "SSID";
 const char *WIFI_PASS = "PASSWORD";
+const char *NTP_SERVER = "pool.ntp.org";
+
+// --- HISTORY (PSRAM) ---
+// Rollups take 12 bytes per point; ~1.1 MB in total with the compressed raw tier
+const size_t HISTORY_RAW_BLOCKS = 2048;       // 512 KB compressed; ~4 weeks at ~0.45 B per 2 s sample
+const size_t HISTORY_MINUTE_CAPACITY = 43200; // 30 days of 1-minute rollups
+const size_t HISTORY_HOUR_CAPACITY = 8760;    // 1 year of 1-hour rollups
+const uint16_t HISTORY_MAX_POINTS = 500;      // Per /api/history response; the step is widened to fit
+const size_t LTTB_BUCKET_CAPACITY = 2048;     // Samples per downsampling bucket; 24 KB of scratch
+
+// --- STATISTICS ---
+// Rolling windows in samples at the Nano's 2 s SENSOR_INTERVAL; 90 KB of PSRAM in total
+const size_t STATS_WINDOW_SAMPLES[STATS_WINDOW_COUNT] = {30, 1800, 43200};
+const char *const STATS_WINDOW_NAMES[STATS_WINDOW_COUNT] = {"1m", "1h", "24h"};
+
+// --- SLIDING MIN / MAX ---
+// Unlike the Nano's lifetime min/max these forget old samples on their own; ~34 KB of PSRAM
+const uint8_t EXTREMES_WINDOW_COUNT = 3;
+const uint32_t EXTREMES_WINDOW_SECONDS[EXTREMES_WINDOW_COUNT] = {3600, 86400, 604800};
+const uint32_t EXTREMES_RESOLUTION[EXTREMES_WINDOW_COUNT] = {10, 60, 600}; // Seconds per bucket
+const char *const EXTREMES_WINDOW_NAMES[EXTREMES_WINDOW_COUNT] = {"1h", "24h", "7d"};
+
+// --- SAMPLE LOG (LittleFS) ---
+// Replayed into the history at boot; sized to fit the default 1.5 MB data partition
+const uint32_t SAMPLE_LOG_SEGMENT_RECORDS = 4096;   // 32 KB per segment file, ~2.3 h at 2 s
+const uint32_t SAMPLE_LOG_MAX_SEGMENTS = 40;        // 1.25 MB, ~4 days
+const uint32_t SAMPLE_LOG_RETENTION = 30 * 86400UL; // Also drop segments older than 30 days
 
 // --- GLOBAL STATE ---
 WebServer server(HTTP_SERVER_PORT);
+WebSocketsServer webSocket(WS_SERVER_PORT);
+WifiLink wifiLink;
+bool webStarted = false; // HTTP and WebSocket servers listen from the first WiFi connection on
+UartIngest nanoUart; // Reads telemetry on its own task; also the command channel to the Nano
+uint8_t linkTxSeq = 0;
+EventStream eventStream;
+HubClock hubClock;
+HistoryStore history;
+SampleLog sampleLog;
+LttbDownsampler downsampler;
+HumidityStats stats;
+uint32_t statsUpdateCycles = 0; // Cost of the last stats.add(), in CPU cycles
+SlidingExtremes extremes[EXTREMES_WINDOW_COUNT];
 
-float currentHum = 0.0;
-float minHum = 100.0;
-float maxHum = 0.0;
-
-// --- HTML INTERFACE ---
-const char INDEX_HTML[] PROGMEM = R"=====(
-<!DOCTYPE html>
-<html>
-<head>
-    <meta name='viewport' content='width=device-width, initial-scale=1.0'>
-    <title>Humidity Hub</title>
-    <style>
-        :root { --bg: #f0f2f5; --card: #ffffff; --text: #333; --cyan: #00d2d3; --teal: #0097a7; --blue: #2e86de; }
-        body { font-family: 'Segoe UI', sans-serif; background: var(--bg); color: var(--text); text-align: center; padding: 20px; }
-        .container { max-width: 400px; margin: auto; }
-        .card { background: var(--card); padding: 25px; border-radius: 20px; box-shadow: 0 10px 25px rgba(0,0,0,0.05); margin-bottom: 20px; }
-        .progress-container { background: #eee; border-radius: 15px; height: 20px; width: 100%; margin: 20px 0; overflow: hidden; }
-        #progress-bar { height: 100%; width: 0%; transition: width 0.5s ease, background-color 0.5s ease; border-radius: 15px; }
-        .val-big { font-size: 3.5rem; font-weight: bold; margin: 10px 0; color: #444; }
-        .stats { display: flex; justify-content: space-around; border-top: 1px solid #eee; padding-top: 15px; }
-        input[type=text] { width: 100%; box-sizing: border-box; padding: 12px; border: 1px solid #ddd; border-radius: 12px; margin-bottom: 12px; font-size: 1rem; }
-        button { width: 100%; padding: 14px; border: none; border-radius: 12px; font-weight: bold; cursor: pointer; transition: 0.2s; font-size: 1rem; }
-        .btn-send { background: #007bff; color: white; margin-bottom: 10px; }
-        .btn-reset { background: #6c757d; color: white; }
-        #toast { visibility: hidden; background: #333; color: #fff; padding: 16px; position: fixed; left: 50%; bottom: 30px; transform: translateX(-50%); border-radius: 50px; }
-        #toast.show { visibility: visible; animation: fade 0.5s; }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <h1 style="color: #555;">Humidity Hub</h1>
-        <div class="card">
-            <div id="hum-val" class="val-big">--%</div>
-            <div class="progress-container"><div id="progress-bar"></div></div>
-            <div class="stats">
-                <div>Min: <b id="min-val">--</b>%</div>
-                <div>Max: <b id="max-val">--</b>%</div>
-            </div>
-        </div>
-        <div class="card">
-            <input type="text" id="msgInput" placeholder="LCD Message...">
-            <button class="btn-send" onclick="sendMsg()">Send Message</button>
-            <button class="btn-reset" onclick="resetValues()">Reset History</button>
-        </div>
-    </div>
-    <div id="toast">Sent!</div>
-    <script>
-        setInterval(fetchData, 3000);
-        function fetchData() {
-            fetch('/api/data').then(res => res.json()).then(data => {
-                document.getElementById('hum-val').innerText = data.curr + '%';
-                document.getElementById('min-val').innerText = data.min;
-                document.getElementById('max-val').innerText = data.max;
-                let bar = document.getElementById('progress-bar');
-                let val = data.curr;
-                bar.style.width = val + '%';
-                if(val < 35) bar.style.backgroundColor = 'var(--cyan)';
-                else if(val <= 65) bar.style.backgroundColor = 'var(--teal)';
-                else bar.style.backgroundColor = 'var(--blue)';
-            });
-        }
-        function showToast(m) {
-            var x = document.getElementById("toast"); x.innerText = m; x.className = "show";
-            setTimeout(function(){ x.className = ""; }, 3000);
-        }
-        function sendMsg() {
-            let v = document.getElementById('msgInput').value;
-            if(!v) return;
-            fetch('/api/msg?val=' + encodeURIComponent(v)).then(() => {
-                showToast("Sent to LCD!"); document.getElementById('msgInput').value = "";
-            });
-        }
-        function resetValues() { fetch('/api/reset').then(() => showToast("History Reset!")); }
-    </script>
-</body>
-</html>
-)=====";
+// Latest sample from the Nano, fixed-point tenths of a percent
+TelemetrySample latestSample = {0, 1000, 0};
+uint32_t sampleSeq = 0; // Accepted samples since boot
+
+// /api/data body and its validator, rendered once per accepted sample and reused by every reader
+const uint8_t DATA_JSON_SIZE = 192;
+char dataJson[DATA_JSON_SIZE];
+size_t dataJsonLength = 0;
+char dataEtag[24];
+uint32_t bootId = 0; // Keeps ETags from a previous boot from matching
+
+// --- NANO LINK ---
+
+/** Sends one binary command frame to the Nano; text longer than the payload is truncated */
+void sendLinkFrame(uint8_t type, const char *text, size_t textLength)
+{
+    HubLinkFrame frame;
+    hubLinkMakeCommand(frame, type, linkTxSeq++, text, textLength);
+
+    uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+    nanoUart.write(wire, hubLinkEncode(frame, wire));
+}
+
+/**
+ * @brief Forwards a web message to the Nano's LCD (shared by HTTP and WebSocket)
+ * Control characters become spaces: in ASCII mode a '\n' in the text would otherwise end
+ * the M: line early and let the rest through as a second command (e.g. "hi\nR:1").
+ */
+void forwardLcdMessage(const char *input, size_t length)
+{
+    // Longer text could not be sent in one frame, nor shown on the 16-column LCD
+    char text[HUBLINK_MAX_PAYLOAD];
+    if (length > sizeof(text))
+        length = sizeof(text);
+    for (size_t i = 0; i < length; i++)
+        text[i] = (uint8_t)input[i] < ' ' || input[i] == 0x7F ? ' ' : input[i];
+
+    // Log to Serial Monitor (USB)
+    Serial.print("[WEB] New Message for LCD: ");
+    Serial.write((const uint8_t *)text, length);
+    Serial.println();
+
+    // Send to Nano (UART)
+    if (USE_BINARY_LINK)
+    {
+        sendLinkFrame(HUBLINK_MESSAGE, text, length);
+    }
+    else
+    {
+        nanoUart.print("M:");
+        nanoUart.write((const uint8_t *)text, length);
+        nanoUart.println();
+    }
+}
+
+/** Forwards a min/max reset to the Nano (shared by HTTP and WebSocket) */
+void forwardReset()
+{
+    // Log to Serial Monitor (USB)
+    Serial.println("[WEB] Reset Command Received -> Sending to Nano...");
+
+    // Send to Nano (UART)
+    if (USE_BINARY_LINK)
+        sendLinkFrame(HUBLINK_RESET, nullptr, 0);
+    else
+        nanoUart.println("R:1");
+}
+
+/** Applies a sample received from the Nano, in either link format */
+void onTelemetrySample(const TelemetrySample &sample)
+{
+    latestSample = sample;
+    sampleSeq++;
+    // Uptime rather than HubClock, so the first SNTP sync does not empty the windows; from the
+    // 64-bit esp_timer, since millis() wraps after 49.7 days and would freeze every window
+    uint32_t uptime = (uint32_t)(esp_timer_get_time() / 1000000);
+    for (uint8_t i = 0; i < EXTREMES_WINDOW_COUNT; i++)
+        extremes[i].add(uptime, sample.current);
+    renderDataJson();
+    uint32_t now = hubClock.now();
+    history.add(now, sample.current);
+    sampleLog.append(now, sample.current);
+
+    uint32_t cycles = ESP.getCycleCount();
+    stats.add(sample.current);
+    statsUpdateCycles = ESP.getCycleCount() - cycles;
+
+    Serial.printf("[DHT11->UART] Current = %.1f, Min:%.1f, Max = %.1f,\n",
+                  sample.current / 10.0f, sample.min / 10.0f, sample.max / 10.0f);
+
+    // Push to live dashboards
+    eventStream.broadcast(dataJson);
+    webSocket.broadcastTXT(dataJson, dataJsonLength);
+}
 
 // --- HANDLERS ---
 
-/** Serves the main HTML page */
-void handleRoot() { server.send(200, "text/html", INDEX_HTML); }
+/** Serves the main HTML page, pre-compressed, revalidated through its ETag */
+void handleRoot()
+{
+    // no-cache lets the browser keep the page but makes it ask first; an unchanged page costs a 304
+    server.sendHeader("Cache-Control", "no-cache");
+    server.sendHeader("ETag", INDEX_HTML_ETAG);
+    if (server.header("If-None-Match") == INDEX_HTML_ETAG)
+    {
+        server.send(304);
+        return;
+    }
+
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, "text/html", (const char *)INDEX_HTML_GZ, INDEX_HTML_GZ_LENGTH);
+}
+
+/**
+ * @brief Renders the current stats into dataJson/dataEtag.
+ * Called once per accepted sample; /api/data, /api/stream and the WebSocket all reuse the result.
+ */
+void renderDataJson()
+{
+    FixedWriter json(dataJson, sizeof(dataJson));
+    json.text("{\"curr\":").tenths(latestSample.current)
+        .text(",\"min\":").tenths(latestSample.min)
+        .text(",\"max\":").tenths(latestSample.max)
+        .text(",\"seq\":").number(sampleSeq);
+
+    // Sliding extremes as "min1h"/"max1h" etc.; absent until the window has a sample
+    for (uint8_t i = 0; i < EXTREMES_WINDOW_COUNT; i++)
+    {
+        int16_t min, max;
+        if (!extremes[i].get(min, max))
+            continue;
+        json.text(",\"min").text(EXTREMES_WINDOW_NAMES[i]).text("\":").tenths(min)
+            .text(",\"max").text(EXTREMES_WINDOW_NAMES[i]).text("\":").tenths(max);
+    }
+    json.text("}");
+    dataJsonLength = json.length();
+
+    snprintf(dataEtag, sizeof(dataEtag), "\"%08lx-%lu\"", (unsigned long)bootId, (unsigned long)sampleSeq);
+}
 
 /** Provides current humidity stats in JSON format for the web dashboard */
 void handleGetData()
 {
-    String json = "{\"curr\":" + String(currentHum, 1) + ",\"min\":" + String(minHum, 1) + ",\"max\":" + String(maxHum, 1) + "}";
+    // The ETag only changes with a new sample, so a poll between samples costs a 304
+    server.sendHeader("Cache-Control", "no-cache");
+    server.sendHeader("ETag", dataEtag);
+    if (server.header("If-None-Match") == dataEtag)
+    {
+        server.send(304);
+        return;
+    }
+    server.send_P(200, "application/json", dataJson, dataJsonLength);
+}
+
+/** Opens a Server-Sent Events stream that pushes each new sample as it is parsed */
+void handleStream()
+{
+    // Browsers fall back to polling /api/data when the stream is refused
+    if (!eventStream.subscribe(server.client(), dataJson))
+        server.send(503, "text/plain", "Too many live viewers");
+}
+
+/** Rounds a statistic in tenths back to the fixed-point representation */
+int16_t roundTenths(float value)
+{
+    return (int16_t)lroundf(value);
+}
+
+/**
+ * @brief Running statistics of the accepted samples (humidity in % with one decimal) and UART ingest counters:
+ * {"samples":N,"ewma":E,"p50":P,"p95":P,"mean":M,"stddev":S,"updateCycles":C,
+ *  "ingest":{...UART ingest task counters...},
+ *  "windows":{"1m":{"n":N,"mean":M,"stddev":S},"1h":{...},"24h":{...}}}
+ * mean / stddev / p50 / p95 cover every sample since boot; windows cover the last 1m / 1h / 24h.
+ */
+void handleStats()
+{
+    char json[1024];
+    FixedWriter out(json, sizeof(json));
+    out.text("{\"samples\":").number(stats.lifetime().count())
+        .text(",\"ewma\":").tenths(roundTenths(stats.ewma().value()))
+        .text(",\"p50\":").tenths(roundTenths(stats.p50().value()))
+        .text(",\"p95\":").tenths(roundTenths(stats.p95().value()))
+        .text(",\"mean\":").tenths(roundTenths(stats.lifetime().mean()))
+        .text(",\"stddev\":").tenths(roundTenths(stats.lifetime().stddev()))
+        .text(",\"updateCycles\":").number(statsUpdateCycles);
+
+    IngestSnapshot ingest = nanoUart.snapshot();
+    out.text(",\"ingest\":{\"bytes\":").number(ingest.bytes)
+        .text(",\"samples\":").number(ingest.samples)
+        .text(",\"latest\":").tenths(ingest.latest.current)
+        .text(",\"latestAgeMs\":").number(ingest.samples ? (micros() - ingest.latestMicros) / 1000 : 0)
+        .text(",\"depth\":").number(nanoUart.depth())
+        .text(",\"maxDepth\":").number(ingest.maxDepth)
+        .text(",\"ringDrops\":").number(ingest.ringDrops)
+        .text(",\"uartOverflows\":").number(ingest.uartOverflows)
+        .text(",\"malformedLines\":").number(ingest.malformedLines)
+        .text(",\"rejectedFrames\":").number(ingest.rejectedFrames)
+        .text(",\"sequenceGaps\":").number(ingest.sequenceGaps)
+        .text(",\"senderRestarts\":").number(ingest.senderRestarts)
+        .text(",\"latencyUs\":").number(nanoUart.lastLatencyMicros())
+        .text(",\"maxLatencyUs\":").number(nanoUart.maxLatencyMicros())
+        .text(",\"snapshotRetries\":").number(nanoUart.snapshotRetries());
+    if (LINK_FAULT_INJECTION)
+        out.text(",\"faultDrops\":").number(ingest.faultDrops)
+            .text(",\"faultFlips\":").number(ingest.faultFlips);
+    out.text("}");
+
+    out.text(",\"windows\":{");
+    for (uint8_t i = 0; i < STATS_WINDOW_COUNT; i++)
+    {
+        const RollingWindow &window = stats.window(i);
+        out.text(i ? ",\"" : "\"").text(STATS_WINDOW_NAMES[i])
+            .text("\":{\"n\":").number(window.size())
+            .text(",\"mean\":").tenths(roundTenths(window.mean()))
+            .text(",\"stddev\":").tenths(roundTenths(window.stddev()))
+            .text("}");
+    }
+    out.text("}}");
+
+    server.sendHeader("Cache-Control", "no-cache");
     server.send(200, "application/json", json);
 }
 
+/** Reads a numeric query argument, or returns fallback when it is absent */
+uint32_t argToUint(const char *name, uint32_t fallback)
+{
+    return server.hasArg(name) ? strtoul(server.arg(name).c_str(), nullptr, 10) : fallback;
+}
+
+/**
+ * @brief Humidity history: /api/history?from=<s>&to=<s>&step=<s> or ?from=<s>&to=<s>&points=<n>
+ * Times are HubClock seconds (Unix time once SNTP has synced); defaults are the last hour.
+ * With step: answered from the coarsest stored resolution that fits step.
+ *   {"now":T,"step":S,"tier":"raw|1m|1h","points":[[time,min,mean,max],...]}
+ * With points: LTTB-downsampled to at most n (3..HISTORY_MAX_POINTS) chart points.
+ *   {"now":T,"tier":"raw|1m|1h","lttb":N,"points":[[time,value],...]}
+ */
+void handleHistory()
+{
+    if (!history.ready())
+    {
+        server.send(503, "text/plain", "History unavailable (no PSRAM)");
+        return;
+    }
+
+    uint32_t now = hubClock.now();
+    uint32_t to = argToUint("to", now);
+    uint32_t from = argToUint("from", to > 3600 ? to - 3600 : 0);
+    uint32_t step = argToUint("step", 0);
+    if (from > to)
+    {
+        server.send(400, "text/plain", "from must not be after to");
+        return;
+    }
+    if (server.hasArg("points"))
+    {
+        sendDownsampledHistory(now, from, to, argToUint("points", 0));
+        return;
+    }
+
+    // Bound the response size regardless of what was asked for
+    uint32_t minStep = (to - from) / HISTORY_MAX_POINTS + 1;
+    if (step < minStep)
+        step = minStep;
+
+    HistoryTier tier = history.selectTier(from, step);
+
+    ChunkedResponse out(server, 200, "application/json");
+    out.text("{\"now\":").number(now)
+        .text(",\"step\":").number(step)
+        .text(",\"tier\":\"").text(HISTORY_TIER_NAMES[tier])
+        .text("\",\"points\":[");
+
+    bool first = true;
+    history.query(tier, from, to, step, [&](const HistoryPoint &point) {
+        out.text(first ? "[" : ",[").number(point.time)
+            .text(",").tenths(point.min)
+            .text(",").tenths(point.mean)
+            .text(",").tenths(point.max)
+            .text("]");
+        first = false;
+    });
+
+    out.text("]}");
+    out.finish();
+}
+
+/** /api/history?points=N: one pass over the finest tier whose buckets fit the scratch buffer */
+void sendDownsampledHistory(uint32_t now, uint32_t from, uint32_t to, uint32_t points)
+{
+    if (!downsampler.ready())
+    {
+        server.send(503, "text/plain", "Downsampling unavailable (no PSRAM)");
+        return;
+    }
+    if (points < 3 || points > HISTORY_MAX_POINTS)
+    {
+        server.send(400, "text/plain", "points must be 3..500");
+        return;
+    }
+
+    uint32_t started = micros();
+    uint32_t bucketSeconds = (to - from) / (points - 2) + 1;
+    uint8_t finest = HISTORY_RAW;
+    while (finest + 1 < HISTORY_TIER_COUNT && bucketSeconds / HISTORY_TIER_SECONDS[finest] >= LTTB_BUCKET_CAPACITY)
+        finest++;
+    HistoryTier tier = history.selectTier(from, HISTORY_TIER_SECONDS[finest]);
+
+    ChunkedResponse out(server, 200, "application/json");
+    out.text("{\"now\":").number(now)
+        .text(",\"tier\":\"").text(HISTORY_TIER_NAMES[tier])
+        .text("\",\"lttb\":").number(points)
+        .text(",\"points\":[");
+
+    uint32_t scanned = 0;
+    uint32_t emitted = 0;
+    auto emit = [&](uint32_t time, int16_t value) {
+        out.text(emitted > 0 ? ",[" : "[").number(time).text(",").tenths(value).text("]");
+        emitted++;
+    };
+    downsampler.start(from, to, points);
+    history.scan(tier, from, to, [&](const HistoryPoint &point) {
+        downsampler.add(point.time, point.mean, emit);
+        scanned++;
+    });
+    downsampler.finish(emit);
+
+    out.text("]}");
+    out.finish();
+
+    Serial.printf("[HISTORY] LTTB %lu -> %lu points, %lu bytes, %lu us\n", (unsigned long)scanned,
+                  (unsigned long)emitted, (unsigned long)out.sent(), (unsigned long)(micros() - started));
+}
+
+/**
+ * @brief Raw sample export: /api/export?from=<s>&to=<s>&format=csv|bin
+ * Defaults to the last 24 hours as CSV. Samples are decoded block by block from the
+ * compressed raw tier straight into the chunk buffer, so any range costs the same RAM.
+ *   csv  "time,humidity" header, then one "<time>,<tenths as %.1f>" line per sample
+ *   bin  6 bytes per sample, little-endian: uint32 time, int16 humidity tenths
+ * Only what the raw tier still holds is exported; older data survives only as rollups.
+ */
+void handleExport()
+{
+    if (!history.ready())
+    {
+        server.send(503, "text/plain", "History unavailable (no PSRAM)");
+        return;
+    }
+
+    uint32_t now = hubClock.now();
+    uint32_t to = argToUint("to", now);
+    uint32_t from = argToUint("from", to > 86400 ? to - 86400 : 0);
+    String format = server.arg("format");
+    bool binary = format == "bin";
+    if (from > to || (!binary && format.length() > 0 && format != "csv"))
+    {
+        server.send(400, "text/plain", "Expected from <= to and format=csv|bin");
+        return;
+    }
+
+    uint32_t started = millis();
+    uint32_t heapBefore = ESP.getFreeHeap();
+    uint32_t samples = 0;
+
+    server.sendHeader("Content-Disposition", binary ? "attachment; filename=humidity.bin"
+                                                    : "attachment; filename=humidity.csv");
+    ChunkedResponse out(server, 200, binary ? "application/octet-stream" : "text/csv");
+    if (!binary)
+        out.text("time,humidity\n");
+
+    history.raw().forEach(from, to, [&](uint32_t time, int16_t value) {
+        if (binary)
+        {
+            uint8_t record[6] = {(uint8_t)time, (uint8_t)(time >> 8), (uint8_t)(time >> 16), (uint8_t)(time >> 24),
+                                 (uint8_t)value, (uint8_t)((uint16_t)value >> 8)};
+            out.write((const char *)record, sizeof(record));
+        }
+        else
+        {
+            out.number(time).text(",").tenths(value).text("\n");
+        }
+        samples++;
+    });
+    out.finish();
+
+    Serial.printf("[EXPORT] %lu samples, %lu bytes in %lu ms, free heap %lu -> %lu\n",
+                  (unsigned long)samples, (unsigned long)out.sent(), (unsigned long)(millis() - started),
+                  (unsigned long)heapBefore, (unsigned long)ESP.getFreeHeap());
+}
+
 /** Receives a message string from the web and forwards it to the Nano via UART */
 void handleMsg()
 {
     String message = server.arg("val");
-    
-    // Log to Serial Monitor (USB)
-    Serial.print("[WEB] New Message for LCD: ");
-    Serial.println(message);
-    
-    // Send to Nano (UART)
-    Serial2.println("M:" + message);
-    
+    forwardLcdMessage(message.c_str(), message.length());
     server.send(200, "text/plain", "OK");
 }
 
 /** Sends a reset command to the Nano */
 void handleReset()
 {
-    // Log to Serial Monitor (USB)
-    Serial.println("[WEB] Reset Command Received -> Sending to Nano...");
-    
-    // Send to Nano (UART)
-    Serial2.println("R:1");
-    
+    forwardReset();
     server.send(200, "text/plain", "OK");
 }
 
-void setup() {
-    Serial.begin(MONITOR_BAUD);
-    Serial2.begin(NANO_BAUD, SERIAL_8N1, PIN_NANO_RX, PIN_NANO_TX);
-    delay(2000); 
+// --- WEBSOCKET CHANNEL ---
+// One persistent connection per dashboard carries both directions:
+//   Hub -> browser: telemetry pushes (same JSON as /api/data) and command replies {"id":N,"ok":true|false}
+//   Browser -> hub: "<id> R:1" or "<id> M:<message>", mirroring the Nano protocol
 
-    // --- 1. SILENCE SYSTEM LOGS ---
-    esp_log_level_set("wifi", ESP_LOG_NONE); 
-    
-    Serial.println("\n[SYSTEM] Initializing WiFi...");
+void onWebSocketEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length)
+{
+    if (type == WStype_CONNECTED)
+    {
+        webSocket.sendTXT(num, dataJson, dataJsonLength);
+        return;
+    }
+    if (type != WStype_TEXT)
+        return;
+
+    const char *text = (const char *)payload;
+    char *command = nullptr;
+    unsigned long id = strtoul(text, &command, 10);
 
-    // --- 2. THE "CLEAN" CONNECTION SEQUENCE ---
-    WiFi.persistent(false);
-    WiFi.disconnect(true);  
-    WiFi.mode(WIFI_STA);
-    delay(500);
-
-    WiFi.begin(WIFI_SSID, WIFI_PASS);
-    
-    int attemptCounter = 0;
-    while (WiFi.status() != WL_CONNECTED) {
-        delay(500);
-        Serial.print(".");
-        attemptCounter++;
-
-        if (attemptCounter >= 20) {
-            Serial.println("\n[WiFi] Connection taking too long, retrying...");
-            WiFi.begin(WIFI_SSID, WIFI_PASS);
-            attemptCounter = 0;
+    bool ok = false;
+    if (command != text && *command == ' ')
+    {
+        command++;
+        size_t commandLength = length - (command - text);
+        if (commandLength == 3 && memcmp(command, "R:1", 3) == 0)
+        {
+            forwardReset();
+            ok = true;
+        }
+        else if (commandLength >= 2 && memcmp(command, "M:", 2) == 0)
+        {
+            forwardLcdMessage(command + 2, commandLength - 2);
+            ok = true;
         }
     }
 
-    Serial.println("\n[WiFi] Connected successfully!");
-    Serial.print("[WiFi] IP Address: ");
+    char reply[48];
+    snprintf(reply, sizeof(reply), ok ? "{\"id\":%lu,\"ok\":true}" : "{\"id\":%lu,\"ok\":false}", id);
+    webSocket.sendTXT(num, reply);
+}
+
+// --- NETWORK ---
+
+/** WiFi got an IP address: start serving on the first connect, (re)start SNTP every time */
+void onWifiUp()
+{
+    Serial.print("[WiFi] Connected, IP Address: ");
     Serial.println(WiFi.localIP());
 
-    // Register API endpoints & Start Server
+    // Wall-clock timestamps for history; until the first sync HubClock counts from boot
+    configTime(0, 0, NTP_SERVER);
+
+    // The listening sockets are bound to any address, so they survive later reconnects
+    if (!webStarted)
+    {
+        server.begin();
+        webSocket.begin();
+        webStarted = true;
+    }
+}
+
+void onWifiDown()
+{
+    Serial.printf("[WiFi] Connection lost, reconnecting (%lu connects so far)\n", (unsigned long)wifiLink.connects());
+}
+
+/** Mounts the flash log, replays it into the history and resumes the clock after it */
+void restoreSampleLog()
+{
+    bool mounted = LittleFS.begin(true); // Formats an unformatted partition on first boot
+    if (!mounted || !sampleLog.begin(LittleFS, SAMPLE_LOG_SEGMENT_RECORDS, SAMPLE_LOG_MAX_SEGMENTS,
+                                      SAMPLE_LOG_RETENTION, [](uint32_t time, int16_t value) { history.add(time, value); }))
+    {
+        Serial.println("[LOG] LittleFS unavailable, samples will not survive a reboot");
+        return;
+    }
+
+    const SampleLogRecovery &recovery = sampleLog.recovery();
+    Serial.printf("[LOG] Recovered %lu samples from %lu segments in %lu ms (%lu ended early)\n",
+                  (unsigned long)recovery.records, (unsigned long)recovery.segments,
+                  (unsigned long)recovery.millis, (unsigned long)recovery.corruptSegments);
+    hubClock.resumeFrom(recovery.lastTime);
+}
+
+// --- BOOT BENCHMARKS ---
+
+/**
+ * @brief Times the hot paths on this board and prints the results as JSON (RUN_BOOT_BENCHMARKS).
+ * Everything runs on scratch objects, except renderDataJson(), which only rewrites the same
+ * document from the current state.
+ */
+void runBootBenchmarks()
+{
+    BootBench bench(Serial);
+    bench.begin("ESP32.ino");
+
+    const char line[] = "[DHT11] Current = 45.3, Min = 30.0, Max = 60.0,\r\n";
+    TelemetryParser parser;
+    bench.run("parse_ascii_line", 2000, [&](uint32_t) {
+        bool accepted = false;
+        for (const char *c = line; *c; c++)
+            accepted |= parser.feed(*c);
+        return parser.sample().current + accepted;
+    });
+
+    HubLinkFrame frame;
+    hubLinkMakeTelemetry(frame, 0, 453, 300, 600);
+    uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+    size_t wireLength = hubLinkEncode(frame, wire);
+    HubLinkDecoder decoder;
+    bench.run("decode_hublink_frame", 2000, [&](uint32_t) {
+        TelemetrySample sample = {0, 0, 0};
+        for (size_t i = 0; i < wireLength; i++)
+        {
+            if (decoder.feed(wire[i]))
+                hubLinkReadTelemetry(decoder.frame(), sample.current, sample.min, sample.max);
+        }
+        return sample.current;
+    });
+
+    bench.run("render_data_json", 2000, [&](uint32_t) {
+        renderDataJson();
+        return dataJsonLength;
+    });
+
+    SpscRing<IngestedSample, UART_INGEST_RING> ring;
+    bench.run("spsc_push_pop", 10000, [&](uint32_t i) {
+        IngestedSample item = {{(int16_t)i, 0, 0}, i};
+        ring.push(item);
+        ring.pop(item);
+        return item.decodedMicros;
+    });
+
+    // A slow random walk, like a DHT11 at a steady 2 s cadence
+    static HistoryStore scratch;
+    if (scratch.begin(BENCH_HISTORY_BLOCKS, 1440, 24))
+    {
+        int16_t value = 450;
+        bench.run("history_ingest", BENCH_HISTORY_SAMPLES, [&](uint32_t i) {
+            if (i % 16 == 0)
+                value += (int16_t)(esp_random() % 3) - 1;
+            scratch.add(i * 2, value);
+            return value;
+        });
+
+        bench.run("history_query_raw_1m", 20, [&](uint32_t) {
+            uint32_t points = 0;
+            scratch.query(HISTORY_RAW, 0, BENCH_HISTORY_SAMPLES * 2, 60, [&](const HistoryPoint &) { points++; });
+            return points;
+        });
+    }
+
+    bench.end();
+}
+
+void setup() {
+    Serial.begin(MONITOR_BAUD);
+    bootId = esp_random();
+    renderDataJson();
+
+    if (!history.begin(HISTORY_RAW_BLOCKS, HISTORY_MINUTE_CAPACITY, HISTORY_HOUR_CAPACITY))
+        Serial.println("[HISTORY] PSRAM allocation failed, history disabled");
+    restoreSampleLog();
+    for (uint8_t i = 0; i < EXTREMES_WINDOW_COUNT; i++)
+    {
+        if (!extremes[i].begin(EXTREMES_WINDOW_SECONDS[i], EXTREMES_RESOLUTION[i]))
+            Serial.printf("[STATS] PSRAM allocation failed, no %s min/max\n", EXTREMES_WINDOW_NAMES[i]);
+    }
+    if (!stats.begin(STATS_WINDOW_SAMPLES))
+        Serial.println("[STATS] PSRAM allocation failed, rolling windows disabled");
+    if (!downsampler.begin(LTTB_BUCKET_CAPACITY))
+        Serial.println("[HISTORY] PSRAM allocation failed, ?points= downsampling disabled");
+
+    if (RUN_BOOT_BENCHMARKS)
+        runBootBenchmarks();
+
+    // Samples decoded before loop() starts wait in the ingest ring
+    if (LINK_FAULT_INJECTION)
+    {
+        nanoUart.injectFaults(LINK_FAULTS);
+        Serial.printf("[UART] Fault injection on, seed %lu\n", (unsigned long)LINK_FAULTS.seed);
+    }
+    if (!nanoUart.begin(UART_NUM_2, NANO_BAUD, PIN_NANO_RX, PIN_NANO_TX, INGEST_CORE))
+        Serial.println("[UART] Ingest task failed to start, no telemetry from the Nano");
+
+    // --- SILENCE SYSTEM LOGS ---
+    esp_log_level_set("wifi", ESP_LOG_NONE);
+
+    // Register API endpoints; the server starts listening once WiFi is up
+    const char *collectedHeaders[] = {"If-None-Match"};
+    server.collectHeaders(collectedHeaders, 1);
     server.on("/", handleRoot);
     server.on("/api/data", handleGetData);
+    server.on("/api/stream", handleStream);
+    server.on("/api/history", handleHistory);
+    server.on("/api/export", handleExport);
+    server.on("/api/stats", handleStats);
     server.on("/api/msg", handleMsg);
     server.on("/api/reset", handleReset);
-    server.begin();
+    webSocket.onEvent(onWebSocketEvent);
+
+    // Returns at once; ingest, history and the flash log run while WiFi connects
+    Serial.println("\n[SYSTEM] Initializing WiFi...");
+    wifiLink.begin(WIFI_SSID, WIFI_PASS, onWifiUp, onWifiDown, millis());
 }
 
 void loop()
 {
-    server.handleClient(); // Handle incoming web requests
-
-    // Check for incoming data from the Arduino Nano
-    if (Serial2.available())
+    wifiLink.update(millis());
+    if (webStarted)
     {
-        String incoming = Serial2.readStringUntil('\n');
-        incoming.trim();
-
-        // PARSING LOGIC:
-        // Expected format: "[DHT11] Current = 45.0, Min = 30.0, Max = 60.0,"
-        if (incoming.startsWith("[DHT11]"))
-        {
-            int curIdx = incoming.indexOf("Current = ");
-            int minIdx = incoming.indexOf("Min = ");
-            int maxIdx = incoming.indexOf("Max = ");
-
-            if (curIdx != -1 && minIdx != -1 && maxIdx != -1)
-            {
-                currentHum = incoming.substring(curIdx + 10, incoming.indexOf(",", curIdx)).toFloat();
-                minHum = incoming.substring(minIdx + 6, incoming.indexOf(",", minIdx)).toFloat();
-                maxHum = incoming.substring(maxIdx + 6, incoming.indexOf(",", maxIdx)).toFloat();
-
-                Serial.printf("[DHT11->UART] Current = %.1f, Min:%.1f, Max = %.1f,\n", currentHum, minHum, maxHum);
-            }
-        }
+        server.handleClient(); // Handle incoming web requests
+        webSocket.loop();
     }
+    eventStream.keepAlive(millis());
+
+    // Samples the ingest task decoded from the Nano (binary HubLink frames or ASCII lines)
+    nanoUart.poll(onTelemetrySample);
 }
@@ -0,0 +1,123 @@
+/**
+ * @file EventStream.h
+ * @brief Server-Sent Events fan-out for the synchronous WebServer.
+ * A subscriber's socket is detached from the WebServer after the response
+ * headers are written and kept open here, so each new sample is pushed to
+ * every open dashboard instead of each one polling /api/data.
+ * Detaching releases the server's own handle (WebServer::client() is a reference
+ * since core 3.x); otherwise the server would hold that connection in its close
+ * wait for up to 2 s, serving no one else, on every new subscription.
+ */
+
+#pragma once
+
+#include <WiFi.h>
+#include <WebSocketsServer.h>
+#include "sdkconfig.h"
+
+// Each live dashboard holds a socket from the lwIP pool (CONFIG_LWIP_MAX_SOCKETS, 16 in the
+// stock Arduino build). The rest of the sketch keeps the WebServer's listener and the client
+// it is serving, and the WebSocket server's listener and clients; a stream past what is left
+// would make the next accept fail, so it is refused instead and the browser polls /api/data.
+const uint8_t SSE_RESERVED_SOCKETS = 3 + WEBSOCKETS_SERVER_CLIENT_MAX;
+static_assert(CONFIG_LWIP_MAX_SOCKETS > SSE_RESERVED_SOCKETS, "No lwIP socket left for a live dashboard");
+const uint8_t SSE_MAX_CLIENTS = CONFIG_LWIP_MAX_SOCKETS - SSE_RESERVED_SOCKETS;
+const uint32_t SSE_KEEPALIVE_INTERVAL = 15000;  // ms between comment pings on an idle stream
+const uint16_t SSE_MAX_EVENT_SIZE = 256;        // Framed event, "data: " prefix included
+
+class EventStream
+{
+public:
+    /**
+     * @brief Takes over an HTTP client and sends the event-stream response headers.
+     * @param client The server's client(); on success its handle is released so the server moves on at once.
+     * @param initialEvent Optional event data sent right away so the page renders immediately.
+     * @return false if every slot is in use; the caller should answer with an error instead.
+     */
+    bool subscribe(WiFiClient &client, const char *initialEvent)
+    {
+        for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++)
+        {
+            if (_clients[i].connected())
+                continue;
+
+            client.setNoDelay(true);
+            client.print("HTTP/1.1 200 OK\r\n"
+                         "Content-Type: text/event-stream\r\n"
+                         "Cache-Control: no-cache\r\n"
+                         "Connection: keep-alive\r\n\r\n");
+            // Tells the browser how long to wait before reconnecting after a drop
+            client.print("retry: 3000\n\n");
+            if (initialEvent)
+            {
+                char event[SSE_MAX_EVENT_SIZE];
+                size_t length = formatEvent(event, initialEvent);
+                client.write((const uint8_t *)event, length);
+            }
+
+            _clients[i] = client;
+            client.stop(); // Only drops the server's reference; the slot keeps the socket open
+            return true;
+        }
+        return false;
+    }
+
+    /** Pushes one "message" event to every subscriber; dead sockets are released */
+    void broadcast(const char *data)
+    {
+        // Framed once and written in one call, so each subscriber gets a single TCP segment
+        char event[SSE_MAX_EVENT_SIZE];
+        size_t length = formatEvent(event, data);
+
+        for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++)
+        {
+            if (_clients[i].connected() && _clients[i].write((const uint8_t *)event, length) != length)
+                _clients[i].stop();
+        }
+        _lastActivity = millis();
+    }
+
+    /** Sends a comment ping when the stream has been idle, which also detects closed tabs */
+    void keepAlive(unsigned long now)
+    {
+        if (now - _lastActivity < SSE_KEEPALIVE_INTERVAL)
+            return;
+        _lastActivity = now;
+
+        for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++)
+        {
+            if (_clients[i].connected() && _clients[i].print(": ping\n\n") == 0)
+                _clients[i].stop();
+        }
+    }
+
+    uint8_t subscribers()
+    {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++)
+        {
+            if (_clients[i].connected())
+                count++;
+        }
+        return count;
+    }
+
+private:
+    /** @return Length of the framed event; data that does not fit is truncated but still terminated. */
+    static size_t formatEvent(char (&event)[SSE_MAX_EVENT_SIZE], const char *data)
+    {
+        int length = snprintf(event, sizeof(event), "data: %s\n\n", data);
+        if (length < 0)
+            return 0;
+        if ((size_t)length >= sizeof(event))
+        {
+            length = sizeof(event) - 1;
+            event[length - 2] = '\n';
+            event[length - 1] = '\n';
+        }
+        return (size_t)length;
+    }
+
+    WiFiClient _clients[SSE_MAX_CLIENTS];
+    unsigned long _lastActivity = 0;
+};
@@ -0,0 +1,121 @@
+/**
+ * @file FixedPoint.h
+ * @brief Formatting for humidity values kept as fixed-point tenths (45.3% -> 453).
+ * Avoids String(float, 1) and printf's float path on every response.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Longest output of formatTenths(): "-3276.8" */
+const uint8_t TENTHS_MAX_CHARS = 7;
+
+/**
+ * @brief Writes value / 10 with exactly one decimal, e.g. 453 -> "45.3", -5 -> "-0.5".
+ * @param out Must hold at least TENTHS_MAX_CHARS bytes; no terminator is written.
+ * @return Number of characters written.
+ */
+inline size_t formatTenths(char *out, int16_t value)
+{
+    size_t length = 0;
+    uint16_t magnitude = value < 0 ? (uint16_t)(-(int32_t)value) : (uint16_t)value;
+    if (value < 0)
+        out[length++] = '-';
+
+    uint16_t whole = magnitude / 10;
+    char digits[5];
+    uint8_t count = 0;
+    do
+    {
+        digits[count++] = '0' + whole % 10;
+        whole /= 10;
+    } while (whole > 0);
+    while (count > 0)
+        out[length++] = digits[--count];
+
+    out[length++] = '.';
+    out[length++] = '0' + magnitude % 10;
+    return length;
+}
+
+/**
+ * @brief Writes an unsigned decimal number.
+ * @param out Must hold at least 10 bytes; no terminator is written.
+ * @return Number of characters written.
+ */
+inline size_t formatNumber(char *out, uint32_t value)
+{
+    char digits[10];
+    uint8_t count = 0;
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+
+    size_t length = 0;
+    while (count > 0)
+        out[length++] = digits[--count];
+    return length;
+}
+
+/**
+ * @brief Small append-only writer over a fixed buffer; output that does not fit is dropped.
+ * The buffer is always NUL-terminated.
+ */
+class FixedWriter
+{
+public:
+    FixedWriter(char *buffer, size_t capacity) : _buffer(buffer), _capacity(capacity) { _buffer[0] = '\0'; }
+
+    FixedWriter &text(const char *s)
+    {
+        while (*s)
+            put(*s++);
+        return *this;
+    }
+
+    FixedWriter &tenths(int16_t value)
+    {
+        char digits[TENTHS_MAX_CHARS];
+        size_t count = formatTenths(digits, value);
+        for (size_t i = 0; i < count; i++)
+            put(digits[i]);
+        return *this;
+    }
+
+    FixedWriter &number(uint32_t value)
+    {
+        char digits[10];
+        size_t count = formatNumber(digits, value);
+        for (size_t i = 0; i < count; i++)
+            put(digits[i]);
+        return *this;
+    }
+
+    size_t length() const { return _length; }
+
+    /** False if anything was dropped for lack of space */
+    bool ok() const { return !_overflow; }
+
+private:
+    void put(char c)
+    {
+        if (_length + 1 < _capacity)
+        {
+            _buffer[_length++] = c;
+            _buffer[_length] = '\0';
+        }
+        else
+        {
+            _overflow = true;
+        }
+    }
+
+    char *_buffer;
+    size_t _capacity;
+    size_t _length = 0;
+    bool _overflow = false;
+};
@@ -0,0 +1,269 @@
+/**
+ * @file HistoryStore.h
+ * @brief Multi-resolution humidity history kept in PSRAM.
+ *
+ * Three tiers hold the same history at different resolutions:
+ *   raw     every accepted sample, delta-of-delta compressed (see CompressedSeries.h)
+ *   minute  1-minute rollups (min / mean / max / count)
+ *   hour    1-hour rollups, built from the closed minute buckets
+ * Rollups are maintained incrementally as samples arrive, so a query is answered
+ * from the coarsest tier that still matches the requested step, without touching raw data.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "CompressedSeries.h"
+#include "PsramAlloc.h"
+
+/** One stored point; a raw sample has min == mean == max and count == 1 */
+struct __attribute__((packed)) HistoryPoint
+{
+    uint32_t time; // HubClock seconds; for rollups, the start of the bucket
+    int16_t min;   // Humidity, fixed-point tenths
+    int16_t mean;
+    int16_t max;
+    uint16_t count; // Raw samples represented
+};
+
+enum HistoryTier : uint8_t
+{
+    HISTORY_RAW,
+    HISTORY_MINUTE,
+    HISTORY_HOUR,
+    HISTORY_TIER_COUNT
+};
+
+const uint32_t HISTORY_TIER_SECONDS[HISTORY_TIER_COUNT] = {1, 60, 3600};
+const char *const HISTORY_TIER_NAMES[HISTORY_TIER_COUNT] = {"raw", "1m", "1h"};
+
+/** Fixed-capacity ring of points in time order; the oldest point is overwritten when full */
+class HistoryRing
+{
+public:
+    bool begin(size_t capacity)
+    {
+        _points = (HistoryPoint *)psramAlloc(capacity * sizeof(HistoryPoint));
+        _capacity = _points ? capacity : 0;
+        return _points != nullptr;
+    }
+
+    void push(const HistoryPoint &point)
+    {
+        _points[(_start + _size) % _capacity] = point;
+        if (_size < _capacity)
+            _size++;
+        else
+            _start = (_start + 1) % _capacity;
+    }
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+
+    /** True once old points have started to be overwritten */
+    bool full() const { return _size == _capacity; }
+
+    /** i = 0 is the oldest point */
+    const HistoryPoint &at(size_t i) const { return _points[(_start + i) % _capacity]; }
+
+    /** Index of the first point at or after time, or size() if there is none */
+    size_t lowerBound(uint32_t time) const
+    {
+        size_t low = 0;
+        size_t high = _size;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (at(mid).time < time)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return low;
+    }
+
+private:
+    HistoryPoint *_points = nullptr;
+    size_t _capacity = 0;
+    size_t _start = 0;
+    size_t _size = 0;
+};
+
+/** Running min / sum / max over one bucket */
+struct HistoryBucket
+{
+    uint32_t start = 0;
+    int16_t min = 0;
+    int16_t max = 0;
+    int64_t sum = 0; // Of mean * count, so rollups of rollups keep an exact mean
+    uint32_t count = 0;
+
+    void add(const HistoryPoint &point)
+    {
+        if (count == 0 || point.min < min)
+            min = point.min;
+        if (count == 0 || point.max > max)
+            max = point.max;
+        sum += (int64_t)point.mean * point.count;
+        count += point.count;
+    }
+
+    HistoryPoint toPoint() const
+    {
+        // Rounded to nearest, also for negative sums
+        int64_t mean = (sum >= 0 ? sum + count / 2 : sum - (int64_t)(count / 2)) / (int64_t)count;
+        uint16_t points = count > UINT16_MAX ? UINT16_MAX : (uint16_t)count;
+        return HistoryPoint{start, min, (int16_t)mean, max, points};
+    }
+
+    void reset() { *this = HistoryBucket(); }
+};
+
+class HistoryStore
+{
+public:
+    /**
+     * @param rawBlocks Compressed raw blocks of SAMPLE_BLOCK_SIZE bytes each
+     * @return false if PSRAM could not provide the buffers; the store then stays empty.
+     */
+    bool begin(size_t rawBlocks, size_t minuteCapacity, size_t hourCapacity)
+    {
+        _ready = _raw.begin(rawBlocks) &&
+                 _tiers[HISTORY_MINUTE].begin(minuteCapacity) &&
+                 _tiers[HISTORY_HOUR].begin(hourCapacity);
+        return _ready;
+    }
+
+    bool ready() const { return _ready; }
+
+    /**
+     * @brief Records one sample. O(1); rolls closed buckets up into the coarser tiers.
+     * Samples older than the newest one already stored are dropped.
+     */
+    void add(uint32_t time, int16_t value)
+    {
+        if (!_ready || time < _lastTime)
+            return;
+        _lastTime = time;
+
+        _raw.append(time, value);
+        rollUp(HISTORY_MINUTE, HistoryPoint{time, value, value, value, 1});
+    }
+
+    /**
+     * @brief Picks the coarsest tier whose resolution still fits step.
+     * If that tier no longer reaches back to from, a coarser tier with longer retention is used.
+     */
+    HistoryTier selectTier(uint32_t from, uint32_t step) const
+    {
+        uint8_t tier = HISTORY_RAW;
+        for (uint8_t t = HISTORY_TIER_COUNT - 1; t > HISTORY_RAW; t--)
+        {
+            if (step >= HISTORY_TIER_SECONDS[t])
+            {
+                tier = t;
+                break;
+            }
+        }
+        while (tier + 1 < HISTORY_TIER_COUNT && !covers((HistoryTier)tier, from))
+            tier++;
+        return (HistoryTier)tier;
+    }
+
+    /**
+     * @brief Aggregates [from, to] into buckets of step seconds, aligned to from.
+     * @param emit Called with each non-empty bucket as a HistoryPoint, in time order.
+     */
+    template <typename Emit>
+    void query(HistoryTier tier, uint32_t from, uint32_t to, uint32_t step, Emit emit) const
+    {
+        if (!_ready || step == 0)
+            return;
+
+        HistoryBucket out;
+        scan(tier, from, to, [&](const HistoryPoint &point) {
+            uint32_t start = from + (point.time - from) / step * step;
+            if (out.count > 0 && out.start != start)
+            {
+                emit(out.toPoint());
+                out.reset();
+            }
+            if (out.count == 0)
+                out.start = start;
+            out.add(point);
+        });
+
+        if (out.count > 0)
+            emit(out.toPoint());
+    }
+
+    /** Calls visit(point) for every point of tier in [from, to], in time order, without aggregating */
+    template <typename Visit>
+    void scan(HistoryTier tier, uint32_t from, uint32_t to, Visit visit) const
+    {
+        if (!_ready)
+            return;
+
+        if (tier == HISTORY_RAW)
+        {
+            _raw.forEach(from, to, [&](uint32_t time, int16_t value) {
+                visit(HistoryPoint{time, value, value, value, 1});
+            });
+            return;
+        }
+
+        const HistoryRing &ring = _tiers[tier];
+        for (size_t i = ring.lowerBound(from); i < ring.size() && ring.at(i).time <= to; i++)
+            visit(ring.at(i));
+
+        // Buckets still being filled hold the newest data; coarse ones start earlier than fine ones
+        for (uint8_t t = tier; t > HISTORY_RAW; t--)
+        {
+            if (_open[t].count == 0)
+                continue;
+            HistoryPoint open = _open[t].toPoint();
+            if (open.time >= from && open.time <= to)
+                visit(open);
+        }
+    }
+
+    /** Points held by a rollup tier; for the raw tier, samples appended since boot */
+    size_t size(HistoryTier tier) const { return tier == HISTORY_RAW ? _raw.samplesAppended() : _tiers[tier].size(); }
+
+    const CompressedSeries &raw() const { return _raw; }
+
+private:
+    void rollUp(uint8_t tier, const HistoryPoint &point)
+    {
+        HistoryBucket &bucket = _open[tier];
+        uint32_t start = point.time - point.time % HISTORY_TIER_SECONDS[tier];
+
+        if (bucket.count > 0 && bucket.start != start)
+        {
+            HistoryPoint closed = bucket.toPoint();
+            _tiers[tier].push(closed);
+            if (tier + 1 < HISTORY_TIER_COUNT)
+                rollUp(tier + 1, closed);
+            bucket.reset();
+        }
+        if (bucket.count == 0)
+            bucket.start = start;
+        bucket.add(point);
+    }
+
+    bool covers(HistoryTier tier, uint32_t from) const
+    {
+        // A tier that has never wrapped still holds everything recorded since boot
+        if (tier == HISTORY_RAW)
+            return !_raw.full() || _raw.block(0).firstTime <= from;
+        const HistoryRing &ring = _tiers[tier];
+        return !ring.full() || ring.at(0).time <= from;
+    }
+
+    CompressedSeries _raw;
+    HistoryRing _tiers[HISTORY_TIER_COUNT];  // Index 0 unused: raw samples live in _raw
+    HistoryBucket _open[HISTORY_TIER_COUNT]; // Index 0 unused: raw samples are stored directly
+    uint32_t _lastTime = 0;
+    bool _ready = false;
+};
@@ -0,0 +1,49 @@
+/**
+ * @file HubClock.h
+ * @brief Seconds timestamps for recorded history.
+ * Returns Unix time once SNTP has synchronised, and seconds since boot before that.
+ * The value never goes backwards, so stores that need ordered timestamps can rely on it;
+ * the switch to wall-clock time after the first sync is a single forward jump.
+ * After a reboot, resumeFrom() continues from the last persisted timestamp so the
+ * pre-sync uptime clock does not restart below history recovered from flash.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <time.h>
+
+// Anything earlier means SNTP has not set the clock yet
+const uint32_t HUB_CLOCK_VALID_EPOCH = 1700000000UL; // 2023-11-14
+
+class HubClock
+{
+public:
+    uint32_t now()
+    {
+        // esp_timer is 64-bit; millis() wraps after 49.7 days and would stall the clock at _last
+        uint32_t t = _base + (uint32_t)(esp_timer_get_time() / 1000000);
+        time_t wall = time(nullptr);
+        if (wall > (time_t)HUB_CLOCK_VALID_EPOCH && (uint32_t)wall > t)
+        {
+            t = (uint32_t)wall;
+            _synced = true;
+        }
+        if (t < _last)
+            t = _last;
+        _last = t;
+        return t;
+    }
+
+    /** Counts seconds since boot on top of time instead of from 0; call before the first now() */
+    void resumeFrom(uint32_t time) { _base = time; }
+
+    /** True once timestamps are wall-clock time from this boot's SNTP sync */
+    bool synced() const { return _synced; }
+
+private:
+    uint32_t _base = 0;
+    uint32_t _last = 0;
+    bool _synced = false;
+};
@@ -0,0 +1,142 @@
+/**
+ * @file IndexHtml.h
+ * @brief Gzip-compressed dashboard page. GENERATED by tools/build_dashboard.py
+ * from web/index.html - edit the HTML and re-run the script instead of this file.
+ * Source 6358 bytes, minified 4973 bytes, gzip 2024 bytes.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+const char INDEX_HTML_ETAG[] = "\"c63b8e9deed04cf2\"";
+const size_t INDEX_HTML_GZ_LENGTH = 2024;
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x58, 0x6b, 0x6f, 0xdb, 0x36,
+    0x17, 0xfe, 0xee, 0x5f, 0xc1, 0xa8, 0x28, 0x24, 0xa1, 0xb6, 0x6c, 0x27, 0x71, 0xdd, 0xd7, 0xb2,
+    0x5d, 0x60, 0x6d, 0x81, 0x66, 0x58, 0xb6, 0xa1, 0xe9, 0xb6, 0x77, 0x28, 0xfa, 0x81, 0x16, 0x69,
+    0x9b, 0x8b, 0x24, 0x1a, 0x22, 0x65, 0x3b, 0x0b, 0xfa, 0xdf, 0x77, 0x0e, 0x49, 0x59, 0x17, 0x27,
+    0x45, 0x5b, 0xb4, 0xb6, 0x0e, 0xcf, 0xe5, 0x39, 0x57, 0x1e, 0x79, 0x7e, 0xf1, 0xfe, 0xb7, 0x77,
+    0x9f, 0xff, 0xfe, 0xfd, 0x03, 0xd9, 0xea, 0x2c, 0x5d, 0xce, 0xdd, 0xff, 0x9c, 0xb2, 0xe5, 0x3c,
+    0xe3, 0x9a, 0x92, 0x9c, 0x66, 0x7c, 0xe1, 0xef, 0x05, 0x3f, 0xec, 0x64, 0xa1, 0x7d, 0x92, 0xc8,
+    0x5c, 0xf3, 0x5c, 0x2f, 0xfc, 0x83, 0x60, 0x7a, 0xbb, 0x60, 0x7c, 0x2f, 0x12, 0x3e, 0x30, 0x0f,
+    0x7d, 0x22, 0x72, 0xa1, 0x05, 0x4d, 0x07, 0x2a, 0xa1, 0x29, 0x5f, 0x8c, 0xa3, 0x91, 0xbf, 0x9c,
+    0x6b, 0xa1, 0x53, 0xbe, 0xfc, 0x58, 0x66, 0x82, 0x09, 0xfd, 0x40, 0x3e, 0x96, 0xab, 0xf9, 0xd0,
+    0xd2, 0xe6, 0x4a, 0x3f, 0xc0, 0x47, 0x6f, 0x56, 0x48, 0xa9, 0xc9, 0x23, 0x19, 0x0c, 0x56, 0x9b,
+    0x19, 0x79, 0xb1, 0x1e, 0xad, 0x2f, 0xd7, 0x93, 0x18, 0x1e, 0x13, 0x5a, 0x30, 0x24, 0x98, 0x3f,
+    0x48, 0xd0, 0xfc, 0xa8, 0x81, 0x70, 0x75, 0x75, 0x65, 0x8e, 0x1f, 0x68, 0x0e, 0x4f, 0xa3, 0x11,
+    0xbb, 0x64, 0x57, 0xf6, 0x98, 0xa6, 0x86, 0xf0, 0xbf, 0x29, 0x9d, 0x22, 0x61, 0x95, 0x96, 0x1c,
+    0x08, 0x97, 0xfc, 0xcd, 0x6b, 0xc6, 0x63, 0xf2, 0xad, 0xb7, 0x92, 0xec, 0x01, 0x2c, 0xad, 0xc1,
+    0x89, 0xc1, 0x9a, 0x66, 0x22, 0x7d, 0x98, 0x11, 0xff, 0x8e, 0x6f, 0x24, 0x27, 0x7f, 0xdc, 0xf8,
+    0x7d, 0xa2, 0x68, 0xae, 0x06, 0x8a, 0x17, 0x02, 0xcc, 0xad, 0x68, 0x72, 0xbf, 0x29, 0x64, 0x99,
+    0x03, 0x86, 0x3d, 0x2d, 0x02, 0x84, 0x17, 0xc6, 0x10, 0x80, 0x54, 0x16, 0x15, 0x05, 0x01, 0x01,
+    0x0d, 0x3f, 0x06, 0x34, 0x15, 0x1b, 0xc0, 0x93, 0x40, 0x74, 0x78, 0x11, 0x93, 0x1d, 0x65, 0x4c,
+    0xe4, 0xe0, 0xd0, 0xe5, 0x68, 0x77, 0x44, 0xdb, 0x11, 0x86, 0x8e, 0x8a, 0x9c, 0x17, 0x80, 0x20,
+    0xa3, 0x47, 0x1b, 0xb4, 0x19, 0xb9, 0x1e, 0x19, 0x86, 0x8c, 0x16, 0x1b, 0x01, 0xf2, 0xb4, 0xd4,
+    0xd2, 0xb2, 0x83, 0xf7, 0xc0, 0x79, 0x0e, 0x03, 0x0f, 0xc2, 0xa6, 0x81, 0x09, 0xca, 0xaf, 0x64,
+    0xc1, 0x78, 0x31, 0x28, 0x28, 0x13, 0xa5, 0xaa, 0xac, 0xae, 0xe4, 0x71, 0xa0, 0xb6, 0x94, 0xc9,
+    0xc3, 0x8c, 0x8c, 0xc8, 0x18, 0x68, 0x86, 0x9b, 0x14, 0x9b, 0x15, 0x0d, 0x46, 0x7d, 0xf3, 0x37,
+    0x1a, 0x4d, 0xc2, 0xca, 0xfc, 0x60, 0x25, 0xb5, 0x96, 0x59, 0x03, 0xf4, 0xae, 0x90, 0x9b, 0x82,
+    0x2b, 0x35, 0x68, 0xa2, 0x6f, 0x62, 0x7a, 0xc1, 0x39, 0x3f, 0xb3, 0x3e, 0x36, 0x90, 0xb6, 0x5c,
+    0x6c, 0xb6, 0xba, 0x52, 0xe6, 0xdc, 0x1d, 0x8f, 0x46, 0x2f, 0x6b, 0x6f, 0xf1, 0x88, 0x8c, 0x62,
+    0x22, 0xf7, 0xbc, 0x58, 0xa7, 0x08, 0x73, 0x2b, 0x18, 0xe3, 0x39, 0xda, 0x7e, 0x71, 0xb2, 0xbd,
+    0xa2, 0x68, 0xb5, 0x52, 0x67, 0x35, 0x38, 0x75, 0xf8, 0x55, 0x17, 0x90, 0x36, 0xa8, 0x3c, 0x09,
+    0x0a, 0x0d, 0x99, 0x8c, 0xa2, 0x89, 0x22, 0x9c, 0x2a, 0xde, 0x6f, 0x60, 0x1d, 0x98, 0xd4, 0xd5,
+    0x67, 0xcf, 0xa0, 0x06, 0xa7, 0xf7, 0x50, 0xc3, 0x2b, 0xb1, 0xa9, 0x2a, 0x45, 0x89, 0x7f, 0xa1,
+    0x8c, 0xae, 0xa2, 0x49, 0xc1, 0xb3, 0xd8, 0x92, 0x0e, 0x0e, 0xcb, 0x4a, 0xa6, 0xac, 0xf6, 0x66,
+    0xec, 0xbc, 0x71, 0x35, 0xf2, 0xe2, 0xfa, 0xfa, 0xda, 0xe8, 0x53, 0x9a, 0x6a, 0x05, 0xda, 0x98,
+    0x50, 0xbb, 0x94, 0x42, 0xcd, 0xad, 0x53, 0x0e, 0x96, 0xfe, 0x29, 0x95, 0x16, 0xeb, 0x87, 0x81,
+    0xeb, 0xa9, 0x19, 0x51, 0x3b, 0x0a, 0xcd, 0x44, 0x0d, 0xda, 0x13, 0x3a, 0x2d, 0x77, 0xa0, 0x19,
+    0x14, 0x2b, 0x99, 0x0a, 0xe6, 0xe2, 0xed, 0x92, 0xef, 0x0e, 0x2b, 0xdc, 0x05, 0xc7, 0xea, 0x6b,
+    0xc3, 0x1e, 0x45, 0x6f, 0x26, 0x08, 0xbb, 0xc2, 0x34, 0x9d, 0x4e, 0xbb, 0xe2, 0x2e, 0xd7, 0x22,
+    0xdf, 0x95, 0xfa, 0x8b, 0x7e, 0xd8, 0xf1, 0x05, 0x16, 0xf4, 0x57, 0xd0, 0xd3, 0xca, 0x99, 0x29,
+    0x26, 0xf1, 0xaf, 0xa9, 0x39, 0x87, 0x0d, 0x48, 0x8d, 0x42, 0x1c, 0x5f, 0xd6, 0x85, 0xd8, 0x82,
+    0xcc, 0x18, 0x3b, 0x0f, 0xf6, 0x65, 0x5d, 0xf5, 0xa7, 0xb2, 0xb3, 0xc4, 0x06, 0xfa, 0xb1, 0x09,
+    0x39, 0x34, 0x6e, 0x09, 0x0c, 0x79, 0x17, 0x51, 0x6d, 0xf9, 0xba, 0x69, 0x39, 0x97, 0x39, 0x7f,
+    0xc6, 0xde, 0x13, 0xc9, 0x4b, 0xca, 0x42, 0x61, 0x64, 0x76, 0x52, 0xd8, 0xce, 0x6d, 0x96, 0xd3,
+    0x28, 0xba, 0x54, 0x4f, 0x02, 0x8a, 0x56, 0x3a, 0x87, 0x49, 0x91, 0x77, 0x5b, 0x14, 0xa6, 0xcf,
+    0x74, 0x85, 0xd3, 0xca, 0xc5, 0xfb, 0xb0, 0x15, 0x9a, 0x9f, 0xfb, 0x59, 0xb5, 0x17, 0x6a, 0x81,
+    0x12, 0xe7, 0xba, 0xab, 0xe6, 0x75, 0x32, 0x9d, 0x4c, 0x59, 0x57, 0x0d, 0x34, 0x85, 0x96, 0x54,
+    0x21, 0xf7, 0x5e, 0x28, 0xb1, 0x12, 0x29, 0xcc, 0xd4, 0xba, 0x67, 0x5a, 0x1a, 0xcc, 0x94, 0xac,
+    0xb2, 0x6e, 0x06, 0x68, 0x1d, 0xae, 0xd7, 0x68, 0x7e, 0x27, 0x2b, 0x2f, 0xd7, 0xe2, 0xc8, 0xc1,
+    0x56, 0xca, 0xd7, 0x10, 0x95, 0x89, 0xcd, 0xb5, 0x05, 0x7a, 0x65, 0x80, 0x9a, 0x88, 0xac, 0x65,
+    0x01, 0x04, 0xf3, 0x35, 0xa5, 0x9a, 0xff, 0x3f, 0x18, 0x00, 0x67, 0x78, 0x16, 0xe7, 0x89, 0x73,
+    0xcd, 0x02, 0x8d, 0xd4, 0x56, 0x1e, 0x3a, 0x68, 0xcd, 0xf7, 0x14, 0xbc, 0xa1, 0xb9, 0xc8, 0xa8,
+    0x43, 0x40, 0x19, 0x37, 0x9d, 0x89, 0xa2, 0xf3, 0xa1, 0xbd, 0x19, 0xe6, 0x43, 0x7b, 0x11, 0xe1,
+    0xd4, 0x5e, 0xce, 0x99, 0xd8, 0x93, 0x24, 0xa5, 0x4a, 0x2d, 0xbc, 0xd3, 0x2c, 0xf2, 0xe0, 0xae,
+    0x1a, 0x13, 0xc3, 0x8d, 0x54, 0xeb, 0xeb, 0x64, 0x32, 0x89, 0xbd, 0xce, 0x8d, 0xb3, 0x1d, 0xb7,
+    0x15, 0xc0, 0x08, 0xf5, 0x2c, 0x45, 0xb0, 0x85, 0xb7, 0x2d, 0xb3, 0x01, 0xf4, 0xbc, 0x57, 0x1d,
+    0xbb, 0xfe, 0xf7, 0x96, 0x83, 0xc1, 0xcb, 0xf9, 0x10, 0xb8, 0x5a, 0xc2, 0xe7, 0x23, 0xb1, 0xa1,
+    0xaa, 0x39, 0xb3, 0x80, 0x6c, 0x85, 0xcf, 0x54, 0x98, 0x81, 0x60, 0xa5, 0x96, 0xb7, 0x38, 0x39,
+    0xe6, 0x2b, 0x23, 0x9d, 0x41, 0x8d, 0x20, 0x10, 0x30, 0x3c, 0x1f, 0xae, 0x96, 0x0d, 0xe3, 0xcb,
+    0x5b, 0x7a, 0xac, 0xd9, 0xe0, 0xf6, 0x78, 0x82, 0xed, 0x69, 0x33, 0xc4, 0x4e, 0x05, 0x67, 0x6d,
+    0xbc, 0x3d, 0x69, 0x81, 0x4c, 0x6e, 0xf8, 0x60, 0xbc, 0xad, 0xd4, 0x34, 0x8c, 0x5d, 0x5e, 0x77,
+    0xd9, 0x80, 0xf2, 0x04, 0xdf, 0x94, 0x75, 0xd8, 0xa6, 0xac, 0xc3, 0xf5, 0x0c, 0x32, 0x97, 0x00,
+    0x33, 0x72, 0x88, 0x19, 0x39, 0x1e, 0xce, 0x1c, 0xcf, 0xba, 0xa7, 0x36, 0x37, 0x78, 0xe0, 0x11,
+    0x98, 0x96, 0x09, 0xdf, 0x42, 0x9b, 0xf2, 0x62, 0xe1, 0xfd, 0xf2, 0xee, 0x3d, 0xb9, 0x85, 0xd0,
+    0xd2, 0x0d, 0x8f, 0xa2, 0x08, 0xa4, 0xdd, 0x50, 0x70, 0x2a, 0xab, 0x86, 0xf4, 0x88, 0xcc, 0x93,
+    0x54, 0x24, 0xf7, 0xe0, 0x3f, 0x3c, 0xde, 0xaa, 0x4d, 0x10, 0x7a, 0xcb, 0x3b, 0x6c, 0x55, 0x27,
+    0x0d, 0xf0, 0x8c, 0xe4, 0x53, 0x1a, 0x4c, 0x33, 0x36, 0x54, 0x98, 0xe7, 0x3f, 0x29, 0x2c, 0x12,
+    0x0a, 0xd5, 0x7c, 0x32, 0xbd, 0xfa, 0x51, 0x28, 0x2d, 0x8b, 0x87, 0x5a, 0x4f, 0xd7, 0x4b, 0xf4,
+    0xc2, 0xd4, 0xbf, 0x31, 0xac, 0x2f, 0xdc, 0x91, 0x4a, 0x0a, 0xb1, 0xd3, 0xcb, 0x5e, 0x0a, 0x3a,
+    0x94, 0x4c, 0xee, 0xe1, 0x63, 0x41, 0xf2, 0x32, 0x4d, 0xfb, 0x24, 0x07, 0xef, 0x6f, 0x18, 0x3c,
+    0x8e, 0xfb, 0x64, 0x07, 0x58, 0xa1, 0x4f, 0xe1, 0xe1, 0xf1, 0x5b, 0x6c, 0x99, 0x75, 0xc1, 0x69,
+    0x76, 0x62, 0xde, 0xc9, 0x34, 0x85, 0x8b, 0xd8, 0x3e, 0xc6, 0xbd, 0x75, 0x99, 0x27, 0xd8, 0x46,
+    0xc0, 0x46, 0x0b, 0xfd, 0x3b, 0x1c, 0x82, 0x74, 0x10, 0x42, 0xdb, 0x89, 0x35, 0x09, 0x2e, 0x2c,
+    0x37, 0x3e, 0xae, 0xb9, 0x4e, 0xb6, 0xef, 0xa9, 0xa6, 0x01, 0xee, 0x0f, 0x95, 0x12, 0xf0, 0xe8,
+    0x06, 0x27, 0x1f, 0x54, 0x54, 0x70, 0xe2, 0xe8, 0x43, 0xeb, 0x8f, 0x46, 0xc0, 0xf6, 0x0d, 0x1a,
+    0xb2, 0x61, 0x40, 0xee, 0x9a, 0xfa, 0x93, 0x94, 0xd3, 0xe2, 0x24, 0xec, 0x0c, 0xc5, 0x1d, 0x7c,
+    0x6d, 0x05, 0x80, 0xf0, 0xce, 0x78, 0x83, 0x0a, 0x7a, 0x08, 0xd0, 0x3a, 0x17, 0x42, 0x9d, 0xea,
+    0xb2, 0xc8, 0x63, 0x43, 0xbb, 0x38, 0x88, 0x1c, 0xb6, 0x96, 0xe8, 0xc3, 0x1e, 0xc2, 0x77, 0x27,
+    0xcb, 0x22, 0xe1, 0x68, 0xaf, 0xed, 0x60, 0x5c, 0x89, 0x80, 0x85, 0x3a, 0x42, 0xfc, 0x40, 0x1a,
+    0x52, 0x81, 0x3f, 0xa4, 0x3b, 0x31, 0xb4, 0xc7, 0x7e, 0x18, 0x3b, 0xc6, 0x48, 0xe6, 0x99, 0x2d,
+    0x06, 0x10, 0x81, 0x7f, 0x4b, 0x50, 0x95, 0x43, 0x95, 0x05, 0x3f, 0xdf, 0xfd, 0xf6, 0x6b, 0xb4,
+    0xa3, 0x85, 0xe2, 0x01, 0x8f, 0x18, 0x04, 0x22, 0x6c, 0xca, 0x48, 0x48, 0x0d, 0x46, 0xac, 0x0e,
+    0x43, 0xe3, 0x90, 0x17, 0x85, 0x34, 0xf1, 0x6c, 0x80, 0x8c, 0x7b, 0x9d, 0xe8, 0xd5, 0xbe, 0x93,
+    0xa6, 0xef, 0x8f, 0x2e, 0xc5, 0x51, 0x92, 0x4a, 0x30, 0x0d, 0xae, 0xb5, 0x52, 0xde, 0x49, 0x03,
+    0x0c, 0x9e, 0x9c, 0x27, 0xe0, 0x21, 0x96, 0xd0, 0x29, 0x8e, 0x55, 0xcc, 0xfe, 0xe2, 0x2b, 0x7b,
+    0x72, 0x8a, 0x58, 0x65, 0xb4, 0x19, 0x30, 0x2c, 0xab, 0x83, 0x72, 0x01, 0x3b, 0x89, 0x04, 0xfe,
+    0x41, 0xcd, 0x86, 0x43, 0x9f, 0xbc, 0x22, 0xa9, 0x4c, 0xcc, 0x70, 0x8e, 0xb6, 0x52, 0x69, 0x7c,
+    0x0d, 0x00, 0x9a, 0x3f, 0x7b, 0x33, 0x1e, 0x62, 0x14, 0x0f, 0xaa, 0x8e, 0x06, 0x00, 0x80, 0xf8,
+    0x3d, 0xd6, 0x15, 0x7d, 0x50, 0x71, 0xcb, 0xd7, 0xb8, 0x5d, 0x37, 0x60, 0xdd, 0x29, 0xe8, 0xa4,
+    0xe0, 0xd1, 0x80, 0x82, 0xee, 0x07, 0xc2, 0x79, 0x1e, 0x5c, 0x61, 0x04, 0xbe, 0x60, 0x3e, 0xbc,
+    0x69, 0x20, 0x5f, 0x88, 0x1e, 0xba, 0xc4, 0xe1, 0x63, 0xd7, 0x3f, 0x06, 0x49, 0x01, 0x5d, 0xae,
+    0x9f, 0xbe, 0x00, 0x4b, 0x24, 0xd8, 0xd7, 0x98, 0x30, 0x0e, 0xa7, 0xfc, 0x8c, 0x6e, 0x0c, 0xa0,
+    0x4c, 0x68, 0x24, 0x51, 0x65, 0x24, 0xef, 0xc1, 0x70, 0x85, 0xd7, 0x24, 0xe7, 0x29, 0x8f, 0x6d,
+    0x8e, 0x5a, 0x7d, 0xdb, 0x8d, 0x3c, 0x74, 0xd9, 0x67, 0x91, 0x71, 0x59, 0xea, 0xa0, 0x95, 0xbe,
+    0x3e, 0xdc, 0x98, 0xb6, 0xd1, 0x5a, 0xb5, 0x92, 0xc8, 0x2c, 0xa3, 0x39, 0x0b, 0x92, 0x8c, 0xf5,
+    0x49, 0x59, 0x40, 0xd3, 0x5b, 0x60, 0x2e, 0xd5, 0xea, 0x94, 0x60, 0xd3, 0xb1, 0x01, 0x70, 0x84,
+    0x91, 0xde, 0xf2, 0x3c, 0xb0, 0xd8, 0x0c, 0x7e, 0x5d, 0x94, 0x3c, 0x3c, 0x0b, 0x8a, 0x60, 0x26,
+    0xe9, 0x38, 0x6e, 0x5e, 0xbd, 0x8a, 0x7b, 0x55, 0x10, 0x20, 0x00, 0x40, 0x47, 0x39, 0x28, 0x69,
+    0xa3, 0x3d, 0xc2, 0xf1, 0x19, 0x00, 0x3b, 0xe4, 0x9d, 0x60, 0x45, 0x00, 0x16, 0x0c, 0x46, 0xaf,
+    0x53, 0x7e, 0x8d, 0x01, 0xd4, 0x18, 0x30, 0x80, 0xd4, 0x42, 0xb3, 0x0d, 0x88, 0x29, 0xf4, 0x1d,
+    0x44, 0x98, 0xa9, 0xb6, 0xe3, 0x54, 0xf4, 0x8f, 0x92, 0x79, 0x10, 0x9e, 0xe8, 0x98, 0xc9, 0xb0,
+    0x15, 0x07, 0x97, 0x5d, 0x53, 0x01, 0xa0, 0x92, 0xc9, 0xa4, 0xcc, 0xa0, 0xb9, 0xa3, 0x0d, 0xd7,
+    0x1f, 0x52, 0x8e, 0x5f, 0x7f, 0x7a, 0xb8, 0x61, 0x81, 0xef, 0xae, 0x70, 0x30, 0x21, 0x00, 0x5c,
+    0xf1, 0x19, 0xfc, 0x43, 0x77, 0x40, 0x2c, 0x82, 0x05, 0xaf, 0x40, 0x1f, 0x5e, 0xfa, 0xf1, 0xf3,
+    0xf2, 0xee, 0xe6, 0x7d, 0x4a, 0x1e, 0x8e, 0xbe, 0x27, 0x68, 0xef, 0xe2, 0x27, 0x05, 0xe9, 0x31,
+    0xee, 0x7d, 0xf1, 0xc7, 0x5b, 0x78, 0xb3, 0xf4, 0xe1, 0x02, 0xc5, 0x8f, 0x29, 0xf3, 0xbf, 0x46,
+    0xb0, 0x4a, 0x7d, 0xa0, 0x10, 0x9a, 0x43, 0xa3, 0xea, 0x45, 0xee, 0xc4, 0xbe, 0x20, 0x16, 0x0c,
+    0xf7, 0xe1, 0x6b, 0x1f, 0xdf, 0x13, 0x6b, 0x32, 0x3d, 0x5a, 0xf2, 0x77, 0xd0, 0xd8, 0x5b, 0xd8,
+    0xb0, 0xb5, 0x01, 0x19, 0xfd, 0x8b, 0x05, 0x81, 0xdd, 0x90, 0xaf, 0x61, 0x67, 0x61, 0xe4, 0x2d,
+    0xf1, 0x07, 0xc0, 0x39, 0x33, 0x47, 0x10, 0x1e, 0x23, 0x85, 0xf6, 0x5c, 0xa8, 0xbe, 0x85, 0xf6,
+    0xee, 0xc1, 0x97, 0x2f, 0x2c, 0x8c, 0x67, 0x2c, 0x36, 0x17, 0x1e, 0xdf, 0x89, 0x40, 0x3c, 0x9a,
+    0xc1, 0x8f, 0x7b, 0x70, 0x16, 0x99, 0x2d, 0x2d, 0xb2, 0xef, 0x67, 0x0b, 0xc3, 0xe2, 0x0c, 0x89,
+    0x75, 0x80, 0x4f, 0x73, 0x72, 0x35, 0x09, 0x49, 0xcd, 0x59, 0x2f, 0xb3, 0xef, 0xcc, 0x7b, 0xdb,
+    0x82, 0xf8, 0xee, 0xfd, 0x17, 0xde, 0xfb, 0x43, 0x90, 0xe3, 0x29, 0x34, 0x63, 0x25, 0xbc, 0x20,
+    0xaf, 0x7f, 0x4c, 0x1a, 0x7f, 0x24, 0x38, 0x49, 0xff, 0x00, 0x3f, 0xfe, 0x86, 0x80, 0xfc, 0xcd,
+    0x39, 0x0e, 0x3b, 0xed, 0x67, 0xbc, 0xdd, 0x03, 0x9c, 0xdc, 0x3d, 0xe0, 0x23, 0xc7, 0xef, 0x84,
+    0xc8, 0x6d, 0x02, 0xd0, 0x88, 0xc7, 0x76, 0x4a, 0x90, 0x60, 0x56, 0x8f, 0x5f, 0x71, 0xba, 0x2e,
+    0x88, 0x87, 0x8a, 0x3d, 0x68, 0xbf, 0x7a, 0x54, 0x54, 0x36, 0x83, 0xf0, 0xb1, 0xcb, 0xec, 0x41,
+    0x43, 0x57, 0xb7, 0x74, 0x0b, 0x5d, 0xb5, 0xf4, 0xb8, 0xca, 0xda, 0x7f, 0x2f, 0x7b, 0xd5, 0xaa,
+    0x05, 0xe5, 0xbb, 0xc7, 0x25, 0xc7, 0x64, 0xe3, 0x62, 0x5f, 0x5f, 0xc6, 0xd5, 0x1c, 0xf2, 0x6f,
+    0x67, 0x58, 0x1f, 0x7b, 0x28, 0x61, 0xd3, 0xcf, 0x20, 0xf8, 0x16, 0x24, 0x16, 0x48, 0xe4, 0x79,
+    0x22, 0x19, 0xff, 0xe3, 0xd3, 0xcd, 0x3b, 0x99, 0xed, 0x60, 0x80, 0xe4, 0x3a, 0xd8, 0x87, 0x7d,
+    0x22, 0xef, 0x6d, 0x79, 0x9b, 0x81, 0x05, 0x73, 0x14, 0x07, 0xe6, 0x29, 0x72, 0x9e, 0x59, 0xc8,
+    0xd6, 0x54, 0xa4, 0x9c, 0x79, 0xed, 0x9b, 0xbc, 0xc5, 0x03, 0xdb, 0xa1, 0x24, 0xb0, 0xf9, 0x5d,
+    0x20, 0xd3, 0x0f, 0xbb, 0x61, 0xe3, 0x63, 0x4a, 0xb8, 0x35, 0x4b, 0x1a, 0xbb, 0x1c, 0x6e, 0x2f,
+    0x95, 0x6f, 0x9f, 0x66, 0x63, 0xbf, 0x72, 0xcc, 0x30, 0xf9, 0x15, 0xfa, 0x1a, 0x0c, 0x3c, 0xbf,
+    0x25, 0x9e, 0xdb, 0xfc, 0x88, 0xd9, 0x03, 0x2f, 0x3c, 0xe8, 0x1e, 0xcf, 0xae, 0x84, 0x95, 0x27,
+    0xa1, 0x7b, 0x81, 0xb1, 0x9b, 0x1e, 0x6c, 0x88, 0xe6, 0xdd, 0x65, 0x68, 0x7e, 0x57, 0xfb, 0x0f,
+    0x00, 0x02, 0x43, 0x22, 0x6d, 0x13, 0x00, 0x00,
+};
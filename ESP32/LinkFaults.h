@@ -0,0 +1,98 @@
+/**
+ * @file LinkFaults.h
+ * @brief Seedable fault injector for received link bytes.
+ *
+ * Sits between the UART and the decoders and damages the byte stream the way a bad link
+ * would: single byte loss, bursts of loss (a dropped line or a brown-out on the Nano's TX)
+ * and bit flips (noise, baud mismatch). The generator is xorshift32, so a given seed and
+ * byte stream always produce the same faults and a failure can be replayed exactly.
+ * Plain C++, so the same injector drives host-side link tests.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Fault rates are per million received bytes */
+struct LinkFaultConfig
+{
+    uint32_t seed;
+    uint32_t dropPpm;     // Single byte lost
+    uint32_t flipPpm;     // One bit inverted
+    uint32_t burstPpm;    // Start of a run of burstLength lost bytes
+    uint16_t burstLength;
+};
+
+class LinkFaultInjector
+{
+public:
+    void begin(const LinkFaultConfig &config)
+    {
+        _config = config;
+        _rng = config.seed ? config.seed : 1; // xorshift never leaves 0
+        _burstLeft = 0;
+        _dropped = _flipped = _bursts = 0;
+    }
+
+    /**
+     * @brief Applies faults to a received chunk in place.
+     * @return The chunk's new length; dropped bytes are removed.
+     */
+    size_t apply(uint8_t *data, size_t length)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            if (_burstLeft > 0)
+            {
+                _burstLeft--;
+                _dropped++;
+                continue;
+            }
+            if (roll(_config.burstPpm))
+            {
+                _burstLeft = _config.burstLength ? _config.burstLength - 1 : 0;
+                _bursts++;
+                _dropped++;
+                continue;
+            }
+            if (roll(_config.dropPpm))
+            {
+                _dropped++;
+                continue;
+            }
+
+            uint8_t byte = data[i];
+            if (roll(_config.flipPpm))
+            {
+                byte ^= (uint8_t)(1u << (next() & 7));
+                _flipped++;
+            }
+            data[kept++] = byte;
+        }
+        return kept;
+    }
+
+    uint32_t droppedBytes() const { return _dropped; }
+    uint32_t flippedBits() const { return _flipped; }
+    uint32_t bursts() const { return _bursts; }
+
+private:
+    uint32_t next()
+    {
+        _rng ^= _rng << 13;
+        _rng ^= _rng >> 17;
+        _rng ^= _rng << 5;
+        return _rng;
+    }
+
+    bool roll(uint32_t ppm) { return ppm && next() % 1000000 < ppm; }
+
+    LinkFaultConfig _config = {1, 0, 0, 0, 0};
+    uint32_t _rng = 1;
+    uint16_t _burstLeft = 0;
+    uint32_t _dropped = 0;
+    uint32_t _flipped = 0;
+    uint32_t _bursts = 0;
+};
@@ -0,0 +1,22 @@
+/**
+ * @file PsramAlloc.h
+ * @brief Allocation from the WROVER's external PSRAM for large, long-lived buffers.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdlib.h>
+#ifdef ARDUINO
+#include <esp_heap_caps.h>
+#endif
+
+/** @return nullptr when the module has no (enabled) PSRAM or it is exhausted. Never freed. */
+inline void *psramAlloc(size_t bytes)
+{
+#ifdef ARDUINO
+    return heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+    return malloc(bytes);
+#endif
+}
@@ -0,0 +1,250 @@
+/**
+ * @file SampleLog.h
+ * @brief Crash-safe, append-only log of accepted samples on flash (LittleFS).
+ *
+ * Records are fixed 8-byte {time, value, crc16} entries. They are collected in a
+ * page-sized RAM buffer and written and synced one page at a time, so flash sees
+ * one small append per SAMPLE_LOG_PAGE_RECORDS samples instead of one per sample.
+ * The log is split into numbered segment files under SAMPLE_LOG_DIR:
+ *   - a full segment is closed and a new one started (rotation);
+ *   - whole segments are deleted once over the count limit or past the retention age
+ *     (segments stamped before SNTP synced have no known age and only go by count);
+ *   - at boot every segment is scanned in order and each valid record is replayed.
+ * A power cut loses at most the unsynced page. A torn or corrupt tail ends the scan of
+ * its segment, and appends always resume in a fresh segment, never after garbage.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <HubLink.h>
+#include "HubClock.h"
+
+const char *const SAMPLE_LOG_DIR = "/log";
+const uint16_t SAMPLE_LOG_PAGE_SIZE = 256; // One flash program page
+
+struct __attribute__((packed)) SampleRecord
+{
+    uint32_t time; // HubClock seconds
+    int16_t value; // Humidity, fixed-point tenths
+    uint16_t crc;  // hubLinkCrc16 over time and value
+};
+
+const uint16_t SAMPLE_LOG_PAGE_RECORDS = SAMPLE_LOG_PAGE_SIZE / sizeof(SampleRecord);
+
+/** What begin() found on flash; timed so boot-time recovery cost can be watched */
+struct SampleLogRecovery
+{
+    uint32_t segments = 0;
+    uint32_t records = 0;
+    uint32_t corruptSegments = 0; // Segments whose scan ended at a bad record
+    uint32_t lastTime = 0;        // Newest recovered timestamp, 0 if none
+    uint32_t millis = 0;
+};
+
+class SampleLog
+{
+public:
+    /**
+     * @brief Mounts the log directory and replays every valid record, oldest first.
+     * @param segmentRecords Records per segment file before rotating, rounded up to whole pages
+     * @param maxSegments Segment files kept; the oldest are deleted beyond this
+     * @param retentionSeconds Segments whose first record is older than this are deleted; ones
+     * stamped with seconds since boot are kept until the segment limit removes them
+     * @param replay Called as replay(time, value) for each recovered record
+     * @return false if the filesystem could not be used; appends are then ignored.
+     */
+    template <typename Replay>
+    bool begin(fs::FS &fs, uint32_t segmentRecords, uint32_t maxSegments, uint32_t retentionSeconds, Replay replay)
+    {
+        _fs = &fs;
+        _segmentRecords = segmentRecords;
+        _maxSegments = maxSegments;
+        _retention = retentionSeconds;
+
+        unsigned long started = millis();
+        if (!_fs->exists(SAMPLE_LOG_DIR) && !_fs->mkdir(SAMPLE_LOG_DIR))
+            return false;
+        if (!findSegments())
+            return false;
+
+        for (uint32_t seq = _oldestSeq; seq < _nextSeq; seq++)
+            recoverSegment(seq, replay);
+        _recovery.millis = millis() - started;
+
+        // Never append after a possibly torn tail: the next record opens a new segment
+        _ready = true;
+        return true;
+    }
+
+    bool ready() const { return _ready; }
+
+    /** Queues one record; a full page is written and synced */
+    void append(uint32_t time, int16_t value)
+    {
+        if (!_ready)
+            return;
+
+        SampleRecord &record = _page[_pageRecords++];
+        record.time = time;
+        record.value = value;
+        record.crc = hubLinkCrc16((const uint8_t *)&record, offsetof(SampleRecord, crc));
+        _recordsAppended++;
+
+        if (_pageRecords == SAMPLE_LOG_PAGE_RECORDS)
+            flush();
+    }
+
+    /** Writes out the partly filled page, e.g. before a planned restart */
+    void flush()
+    {
+        if (!_ready || _pageRecords == 0)
+            return;
+
+        if (!_file || _fileRecords >= _segmentRecords)
+            rotate(_page[0].time);
+
+        size_t bytes = _pageRecords * sizeof(SampleRecord);
+        if (_file && _file.write((const uint8_t *)_page, bytes) == bytes)
+        {
+            _file.flush();
+            _fileRecords += _pageRecords;
+            _bytesWritten += bytes;
+            _pagesWritten++;
+        }
+        else
+        {
+            _writeErrors++;
+            _file.close(); // Retry in a fresh segment next time
+        }
+        _pageRecords = 0;
+    }
+
+    const SampleLogRecovery &recovery() const { return _recovery; }
+    uint32_t recordsAppended() const { return _recordsAppended; }
+    uint32_t pagesWritten() const { return _pagesWritten; }
+    uint32_t bytesWritten() const { return _bytesWritten; }
+    uint32_t segments() const { return _nextSeq - _oldestSeq; }
+    uint32_t writeErrors() const { return _writeErrors; }
+
+private:
+    void segmentPath(char *path, size_t size, uint32_t seq) const
+    {
+        snprintf(path, size, "%s/%08lx.seg", SAMPLE_LOG_DIR, (unsigned long)seq);
+    }
+
+    /** Sets the [_oldestSeq, _nextSeq) range from the files present */
+    bool findSegments()
+    {
+        File dir = _fs->open(SAMPLE_LOG_DIR);
+        if (!dir || !dir.isDirectory())
+            return false;
+
+        bool any = false;
+        for (File entry = dir.openNextFile(); entry; entry = dir.openNextFile())
+        {
+            // Older cores report the full path, newer ones just the file name
+            const char *name = entry.name();
+            const char *slash = strrchr(name, '/');
+            if (slash)
+                name = slash + 1;
+
+            char *end;
+            uint32_t seq = strtoul(name, &end, 16);
+            if (end == name || strcmp(end, ".seg") != 0)
+                continue;
+            if (!any || seq < _oldestSeq)
+                _oldestSeq = seq;
+            if (!any || seq >= _nextSeq)
+                _nextSeq = seq + 1;
+            any = true;
+        }
+        return true;
+    }
+
+    template <typename Replay>
+    void recoverSegment(uint32_t seq, Replay &replay)
+    {
+        char path[32];
+        segmentPath(path, sizeof(path), seq);
+        File file = _fs->open(path, FILE_READ);
+        if (!file)
+            return;
+        _recovery.segments++;
+
+        // Read back through the page buffer; it is empty until the first append
+        size_t count;
+        while ((count = file.read((uint8_t *)_page, sizeof(_page)) / sizeof(SampleRecord)) > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                const SampleRecord &record = _page[i];
+                if (!valid(record))
+                {
+                    _recovery.corruptSegments++;
+                    return;
+                }
+                replay(record.time, record.value);
+                _recovery.records++;
+                _recovery.lastTime = record.time;
+            }
+        }
+    }
+
+    static bool valid(const SampleRecord &record)
+    {
+        return record.crc == hubLinkCrc16((const uint8_t *)&record, offsetof(SampleRecord, crc));
+    }
+
+    /** Closes the current segment, opens the next one and applies retention */
+    void rotate(uint32_t now)
+    {
+        if (_file)
+            _file.close();
+
+        char path[32];
+        segmentPath(path, sizeof(path), _nextSeq++);
+        _file = _fs->open(path, FILE_APPEND);
+        _fileRecords = 0;
+
+        while (segments() > 1 && (segments() > _maxSegments || expired(_oldestSeq, now)))
+        {
+            segmentPath(path, sizeof(path), _oldestSeq++);
+            _fs->remove(path);
+        }
+    }
+
+    /** True if the segment's first record is past retention, or unreadable */
+    bool expired(uint32_t seq, uint32_t now)
+    {
+        char path[32];
+        segmentPath(path, sizeof(path), seq);
+        File file = _fs->open(path, FILE_READ);
+        SampleRecord first;
+        if (!file || file.read((uint8_t *)&first, sizeof(first)) != sizeof(first) || !valid(first))
+            return true;
+        // Seconds since boot say nothing about age once the clock has jumped to Unix time
+        if (first.time < HUB_CLOCK_VALID_EPOCH || now < HUB_CLOCK_VALID_EPOCH)
+            return false;
+        return now > first.time && now - first.time > _retention;
+    }
+
+    fs::FS *_fs = nullptr;
+    File _file;
+    SampleRecord _page[SAMPLE_LOG_PAGE_RECORDS];
+    uint16_t _pageRecords = 0;
+    uint32_t _fileRecords = 0;
+    uint32_t _segmentRecords = 0;
+    uint32_t _maxSegments = 0;
+    uint32_t _retention = 0;
+    uint32_t _oldestSeq = 0;
+    uint32_t _nextSeq = 0;
+    bool _ready = false;
+
+    SampleLogRecovery _recovery;
+    uint32_t _recordsAppended = 0;
+    uint32_t _pagesWritten = 0;
+    uint32_t _bytesWritten = 0;
+    uint32_t _writeErrors = 0;
+};
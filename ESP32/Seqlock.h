@@ -0,0 +1,68 @@
+/**
+ * @file Seqlock.h
+ * @brief Single-writer sequence lock for publishing a small struct between tasks.
+ *
+ * The writer bumps the sequence to odd, stores the value and bumps it back to even; it
+ * never waits. A reader copies the value and retries if the sequence was odd or changed
+ * meanwhile, so it always returns one complete, consistent version and never a mix of
+ * two. The value is held as relaxed atomic words, which keeps the copy well-defined on
+ * both ESP32 cores (and race-free under ThreadSanitizer on a host).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+template <typename T>
+class Seqlock
+{
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Pad T to a whole number of 32-bit words");
+    static const size_t WORDS = sizeof(T) / sizeof(uint32_t);
+
+public:
+    /** Writer side; only one task may call this */
+    void write(const T &value)
+    {
+        uint32_t words[WORDS];
+        memcpy(words, &value, sizeof(T));
+
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++)
+            _words[i].store(words[i], std::memory_order_relaxed);
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Reader side; any number of tasks may call this.
+     * @return Number of retries needed because the writer was active, for contention stats.
+     */
+    uint32_t read(T &value) const
+    {
+        uint32_t words[WORDS];
+        for (uint32_t retries = 0;; retries++)
+        {
+            uint32_t before = _seq.load(std::memory_order_acquire);
+            if (before & 1)
+                continue;
+            for (size_t i = 0; i < WORDS; i++)
+                words[i] = _words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_seq.load(std::memory_order_relaxed) == before)
+            {
+                memcpy(&value, words, sizeof(T));
+                return retries;
+            }
+        }
+    }
+
+    /** Versions written so far */
+    uint32_t version() const { return _seq.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<uint32_t> _seq{0};
+    std::atomic<uint32_t> _words[WORDS] = {};
+};
@@ -0,0 +1,153 @@
+/**
+ * @file SlidingExtremes.h
+ * @brief Min / max over a sliding time window using monotonic deques.
+ *
+ * Samples are first folded into buckets of `resolution` seconds. Each closed bucket
+ * goes into two deques: one whose values only increase from front to back (the front is
+ * the window minimum), one whose values only decrease (the front is the maximum).
+ * A new bucket pops every back entry it dominates, and buckets older than the window
+ * leave from the front, so each update is amortized O(1). A deque never holds more than
+ * the window's bucket count, so memory is fixed at begin(). The oldest bucket may reach
+ * up to one resolution past the window's edge.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "PsramAlloc.h"
+
+struct __attribute__((packed)) ExtremeEntry
+{
+    uint32_t start; // Bucket start, seconds
+    int16_t value;
+};
+
+/** Fixed-capacity ring of entries with pops at both ends */
+class ExtremeDeque
+{
+public:
+    bool begin(size_t capacity)
+    {
+        _entries = (ExtremeEntry *)psramAlloc(capacity * sizeof(ExtremeEntry));
+        _capacity = _entries ? capacity : 0;
+        return _entries != nullptr;
+    }
+
+    bool empty() const { return _size == 0; }
+    const ExtremeEntry &front() const { return _entries[_start]; }
+    const ExtremeEntry &back() const { return _entries[(_start + _size - 1) % _capacity]; }
+    void popFront()
+    {
+        _start = (_start + 1) % _capacity;
+        _size--;
+    }
+    void popBack() { _size--; }
+
+    void pushBack(const ExtremeEntry &entry)
+    {
+        if (_size == _capacity)
+            popFront(); // Unreachable when sized per begin(); keeps the ring safe regardless
+        _entries[(_start + _size) % _capacity] = entry;
+        _size++;
+    }
+
+private:
+    ExtremeEntry *_entries = nullptr;
+    size_t _capacity = 0;
+    size_t _start = 0;
+    size_t _size = 0;
+};
+
+class SlidingExtremes
+{
+public:
+    /**
+     * @param window Seconds covered
+     * @param resolution Bucket length in seconds; memory is 2 * 6 bytes per bucket in the window
+     */
+    bool begin(uint32_t window, uint32_t resolution)
+    {
+        _window = window;
+        _resolution = resolution;
+        size_t buckets = window / resolution + 2;
+        _ready = _min.begin(buckets) && _max.begin(buckets);
+        return _ready;
+    }
+
+    void add(uint32_t time, int16_t value)
+    {
+        if (!_ready)
+            return;
+
+        uint32_t start = time - time % _resolution;
+        if (_hasOpen && start != _open.start)
+            close();
+        if (!_hasOpen)
+        {
+            _open = {start, value, value};
+            _hasOpen = true;
+        }
+        else
+        {
+            if (value < _open.min)
+                _open.min = value;
+            if (value > _open.max)
+                _open.max = value;
+        }
+        expire(time);
+    }
+
+    /** @return false if no sample falls within the window. */
+    bool get(int16_t &min, int16_t &max) const
+    {
+        if (!_hasOpen)
+            return false;
+        min = _open.min;
+        max = _open.max;
+        if (!_min.empty() && _min.front().value < min)
+            min = _min.front().value;
+        if (!_max.empty() && _max.front().value > max)
+            max = _max.front().value;
+        return true;
+    }
+
+private:
+    struct OpenBucket
+    {
+        uint32_t start;
+        int16_t min;
+        int16_t max;
+    };
+
+    void close()
+    {
+        while (!_min.empty() && _min.back().value >= _open.min)
+            _min.popBack();
+        _min.pushBack({_open.start, _open.min});
+
+        while (!_max.empty() && _max.back().value <= _open.max)
+            _max.popBack();
+        _max.pushBack({_open.start, _open.max});
+        _hasOpen = false;
+    }
+
+    /** Drops buckets that ended before the window starting at now - window */
+    void expire(uint32_t now)
+    {
+        while (!_min.empty() && outside(_min.front().start, now))
+            _min.popFront();
+        while (!_max.empty() && outside(_max.front().start, now))
+            _max.popFront();
+    }
+
+    bool outside(uint32_t start, uint32_t now) const { return now - start >= _window + _resolution; }
+
+    ExtremeDeque _min;
+    ExtremeDeque _max;
+    uint32_t _window = 0;
+    uint32_t _resolution = 1;
+    OpenBucket _open = {0, 0, 0};
+    bool _hasOpen = false;
+    bool _ready = false;
+};
@@ -0,0 +1,51 @@
+/**
+ * @file SpscRing.h
+ * @brief Lock-free single-producer / single-consumer ring buffer.
+ * One task may push() and one other task may pop(); neither ever blocks or takes a lock.
+ * Indices run freely and are masked on access, so all Capacity slots are usable.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+template <typename T, size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /** Producer side. @return false if the ring is full; the item is not stored. */
+    bool push(const T &item)
+    {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == Capacity)
+            return false;
+        _items[head & (Capacity - 1)] = item;
+        _head.store(head + 1, std::memory_order_release); // Publishes the item
+        return true;
+    }
+
+    /** Consumer side. @return false if the ring is empty. */
+    bool pop(T &item)
+    {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (_head.load(std::memory_order_acquire) == tail)
+            return false;
+        item = _items[tail & (Capacity - 1)];
+        _tail.store(tail + 1, std::memory_order_release); // Hands the slot back
+        return true;
+    }
+
+    /** Items waiting; exact from either side, approximate from anywhere else */
+    size_t size() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    T _items[Capacity];
+    std::atomic<uint32_t> _head{0}; // Written only by the producer
+    std::atomic<uint32_t> _tail{0}; // Written only by the consumer
+};
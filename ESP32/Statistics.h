@@ -0,0 +1,253 @@
+/**
+ * @file Statistics.h
+ * @brief O(1)-per-sample humidity statistics: windowed mean / stddev, EWMA and p50 / p95.
+ *
+ * All inputs are fixed-point tenths, like the rest of the hub.
+ *   RollingWindow  mean and sample stddev over the last N samples. Because the inputs are
+ *                  integers, exact running sums replace Welford's update there: removing the
+ *                  oldest sample is a subtraction and never accumulates rounding drift.
+ *   Welford        mean and stddev since boot, for which no window of values is kept.
+ *   Ewma           exponentially weighted moving average.
+ *   P2Quantile     Jain & Chlamtac's P-square estimator: one quantile in five markers.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "PsramAlloc.h"
+
+/** Mean and sample standard deviation over the most recent samples */
+class RollingWindow
+{
+public:
+    bool begin(size_t capacity)
+    {
+        _values = (int16_t *)psramAlloc(capacity * sizeof(int16_t));
+        _capacity = _values ? capacity : 0;
+        return _values != nullptr;
+    }
+
+    void add(int16_t value)
+    {
+        if (_capacity == 0)
+            return;
+        if (_size == _capacity)
+        {
+            int16_t oldest = _values[_start];
+            _sum -= oldest;
+            _sumSquares -= (int64_t)oldest * oldest;
+            _start = (_start + 1) % _capacity;
+            _size--;
+        }
+        _values[(_start + _size) % _capacity] = value;
+        _size++;
+        _sum += value;
+        _sumSquares += (int64_t)value * value;
+    }
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    float mean() const { return _size ? (float)_sum / _size : 0.0f; }
+
+    /** Sample (n - 1) standard deviation; 0 with fewer than two samples */
+    float stddev() const
+    {
+        if (_size < 2)
+            return 0.0f;
+        int64_t n = _size;
+        return sqrtf((float)(n * _sumSquares - _sum * _sum) / (float)(n * (n - 1)));
+    }
+
+private:
+    int16_t *_values = nullptr;
+    size_t _capacity = 0;
+    size_t _start = 0;
+    size_t _size = 0;
+    int64_t _sum = 0;
+    int64_t _sumSquares = 0;
+};
+
+/** Welford's numerically stable running mean and variance */
+class Welford
+{
+public:
+    void add(float value)
+    {
+        _count++;
+        double delta = value - _mean;
+        _mean += delta / _count;
+        _m2 += delta * (value - _mean);
+    }
+
+    uint32_t count() const { return _count; }
+    float mean() const { return (float)_mean; }
+    float stddev() const { return _count > 1 ? (float)sqrt(_m2 / (_count - 1)) : 0.0f; }
+
+private:
+    uint32_t _count = 0;
+    double _mean = 0;
+    double _m2 = 0;
+};
+
+class Ewma
+{
+public:
+    /** @param alpha Weight of each new sample, 0 < alpha <= 1 */
+    explicit Ewma(float alpha) : _alpha(alpha) {}
+
+    void add(float value)
+    {
+        _value = _primed ? _value + _alpha * (value - _value) : value;
+        _primed = true;
+    }
+
+    float value() const { return _value; }
+
+private:
+    float _alpha;
+    float _value = 0.0f;
+    bool _primed = false;
+};
+
+/** Streaming estimate of one quantile without storing the samples */
+class P2Quantile
+{
+public:
+    /** @param p Quantile in (0, 1), e.g. 0.95 */
+    explicit P2Quantile(float p) : _p(p)
+    {
+        const float increments[5] = {0.0f, p / 2, p, (1 + p) / 2, 1.0f};
+        for (uint8_t i = 0; i < 5; i++)
+            _increment[i] = increments[i];
+    }
+
+    void add(float value)
+    {
+        if (_count < 5)
+        {
+            // Insertion sort the first five samples; they become the initial markers
+            uint8_t i = _count++;
+            for (; i > 0 && _height[i - 1] > value; i--)
+                _height[i] = _height[i - 1];
+            _height[i] = value;
+            if (_count == 5)
+            {
+                for (uint8_t m = 0; m < 5; m++)
+                {
+                    _position[m] = m;
+                    _desired[m] = 4 * _increment[m];
+                }
+            }
+            return;
+        }
+        _count++;
+
+        // Cell k such that height[k] <= value < height[k + 1], widening the ends if needed
+        uint8_t k;
+        if (value < _height[0])
+        {
+            _height[0] = value;
+            k = 0;
+        }
+        else if (value >= _height[4])
+        {
+            _height[4] = value;
+            k = 3;
+        }
+        else
+        {
+            k = 0;
+            while (value >= _height[k + 1])
+                k++;
+        }
+
+        for (uint8_t i = k + 1; i < 5; i++)
+            _position[i]++;
+        for (uint8_t i = 0; i < 5; i++)
+            _desired[i] += _increment[i];
+
+        for (uint8_t i = 1; i < 4; i++)
+        {
+            float d = _desired[i] - _position[i];
+            if ((d >= 1 && _position[i + 1] - _position[i] > 1) || (d <= -1 && _position[i - 1] - _position[i] < -1))
+            {
+                int8_t s = d > 0 ? 1 : -1;
+                float h = parabolic(i, s);
+                if (h <= _height[i - 1] || h >= _height[i + 1])
+                    h = _height[i] + s * (_height[i + s] - _height[i]) / (_position[i + s] - _position[i]);
+                _height[i] = h;
+                _position[i] += s;
+            }
+        }
+    }
+
+    /** Current estimate; exact (nearest rank) until five samples have been seen */
+    float value() const
+    {
+        if (_count >= 5)
+            return _height[2];
+        if (_count == 0)
+            return 0.0f;
+        return _height[(uint8_t)(_p * (_count - 1) + 0.5f)];
+    }
+
+    uint32_t count() const { return _count; }
+
+private:
+    float parabolic(uint8_t i, int8_t s) const
+    {
+        float below = _position[i] - _position[i - 1];
+        float above = _position[i + 1] - _position[i];
+        return _height[i] + s / (float)(_position[i + 1] - _position[i - 1]) *
+                                ((below + s) * (_height[i + 1] - _height[i]) / above +
+                                 (above - s) * (_height[i] - _height[i - 1]) / below);
+    }
+
+    float _p;
+    uint32_t _count = 0;
+    float _height[5] = {};
+    int32_t _position[5] = {};
+    float _desired[5] = {};
+    float _increment[5];
+};
+
+const uint8_t STATS_WINDOW_COUNT = 3;
+
+/** Everything /api/stats reports, updated once per accepted sample */
+class HumidityStats
+{
+public:
+    /** @param windowSamples Sample count of each rolling window, shortest first */
+    bool begin(const size_t (&windowSamples)[STATS_WINDOW_COUNT])
+    {
+        bool ok = true;
+        for (uint8_t i = 0; i < STATS_WINDOW_COUNT; i++)
+            ok = _windows[i].begin(windowSamples[i]) && ok;
+        return ok;
+    }
+
+    void add(int16_t value)
+    {
+        for (uint8_t i = 0; i < STATS_WINDOW_COUNT; i++)
+            _windows[i].add(value);
+        _lifetime.add(value);
+        _ewma.add(value);
+        _p50.add(value);
+        _p95.add(value);
+    }
+
+    const RollingWindow &window(uint8_t i) const { return _windows[i]; }
+    const Welford &lifetime() const { return _lifetime; }
+    const Ewma &ewma() const { return _ewma; }
+    const P2Quantile &p50() const { return _p50; }
+    const P2Quantile &p95() const { return _p95; }
+
+private:
+    RollingWindow _windows[STATS_WINDOW_COUNT];
+    Welford _lifetime;
+    Ewma _ewma{0.1f}; // ~10-sample memory, i.e. ~20 s at the Nano's 2 s cadence
+    P2Quantile _p50{0.5f};
+    P2Quantile _p95{0.95f};
+};
@@ -0,0 +1,238 @@
+/**
+ * @file TelemetryParser.h
+ * @brief Incremental decoder for the Nano's ASCII telemetry line.
+ * Bytes are fed one at a time as they arrive on Serial2, so a line that arrives
+ * in pieces never blocks the loop, and no heap Strings are created.
+ * Expected format: "[DHT11] Current = 45.0, Min = 30.0, Max = 60.0,"
+ * The line has no checksum, so a well-formed line is still only accepted if its values
+ * are a possible humidity (0-100 %) and min <= current <= max, as the Nano always sends.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/** One decoded sample. Humidity is fixed-point in tenths of a percent (45.3% -> 453). */
+struct TelemetrySample
+{
+    int16_t current;
+    int16_t min;
+    int16_t max;
+};
+
+class TelemetryParser
+{
+public:
+    TelemetryParser() { reset(); }
+
+    /**
+     * @brief Consumes one received byte.
+     * @return true when this byte completed a valid telemetry line; the values are then in sample().
+     */
+    bool feed(char c)
+    {
+        if (c == '\n')
+        {
+            bool accepted = (_state == State::Trailer && plausible(_pending));
+            if (accepted)
+            {
+                _sample = _pending;
+            }
+            else if (_state == State::Trailer)
+            {
+                _malformed++;
+            }
+            else if (_state == State::Number || (_state == State::Match && _pos >= TAG_LENGTH))
+            {
+                rejectLine();
+            }
+            _state = State::Idle;
+            _pos = 0;
+            return accepted;
+        }
+
+        switch (_state)
+        {
+        case State::Idle:
+            // Equivalent of String::trim() on the leading side
+            if (c == ' ' || c == '\t' || c == '\r')
+                break;
+            _state = State::Match;
+            _field = 0;
+            matchTemplate(c);
+            break;
+
+        case State::Match:
+            matchTemplate(c);
+            break;
+
+        case State::Number:
+            if (!accumulateNumber(c))
+            {
+                // Any non-numeric byte terminates the field and must match the template
+                if (!finishNumber())
+                {
+                    rejectLine();
+                    break;
+                }
+                matchTemplate(c);
+            }
+            break;
+
+        case State::Trailer:
+            // Equivalent of String::trim() on the trailing side
+            if (c != ' ' && c != '\t' && c != '\r')
+                rejectLine();
+            break;
+
+        case State::Discard:
+            break;
+        }
+        return false;
+    }
+
+    /** Last accepted sample. Only valid after feed() has returned true at least once. */
+    const TelemetrySample &sample() const { return _sample; }
+
+    /** Lines that started with the [DHT11] tag but did not match the format or held impossible values. */
+    uint32_t malformedLines() const { return _malformed; }
+
+    void reset()
+    {
+        _state = State::Idle;
+        _pos = 0;
+        _field = 0;
+        _value = 0;
+        _negative = false;
+        _digits = 0;
+        _fraction = -1;
+        _tenth = 0;
+        _malformed = 0;
+        _pending = TelemetrySample{0, 0, 0};
+        _sample = _pending;
+    }
+
+private:
+    enum class State : uint8_t
+    {
+        Idle,    // Skipping leading whitespace
+        Match,   // Matching literal template characters
+        Number,  // Accumulating a numeric field
+        Trailer, // Template fully matched, waiting for end of line
+        Discard  // Not a telemetry line, waiting for end of line
+    };
+
+    // '#' marks a numeric field. Fields are stored in order: current, min, max.
+    static constexpr const char *TEMPLATE = "[DHT11] Current = #, Min = #, Max = #,";
+    static const uint8_t TAG_LENGTH = 7;          // strlen("[DHT11]")
+    static const int16_t MAX_FIXED_VALUE = 32000; // Guards int16_t overflow on absurd input
+    static const int16_t MAX_HUMIDITY = 1000;     // 100.0 %
+
+    static bool plausible(const TelemetrySample &sample)
+    {
+        return sample.min >= 0 && sample.max <= MAX_HUMIDITY &&
+               sample.min <= sample.current && sample.current <= sample.max;
+    }
+
+    void matchTemplate(char c)
+    {
+        char expected = TEMPLATE[_pos];
+        if (expected == '#')
+        {
+            _state = State::Number;
+            _value = 0;
+            _negative = false;
+            _digits = 0;
+            _fraction = -1;
+            if (!accumulateNumber(c))
+                rejectLine();
+            return;
+        }
+        if (c != expected)
+        {
+            // Only lines carrying the [DHT11] tag count as malformed; [LOG] lines etc. are simply ignored
+            if (_pos >= TAG_LENGTH)
+                rejectLine();
+            else
+                _state = State::Discard;
+            return;
+        }
+        _pos++;
+        if (TEMPLATE[_pos] == '\0')
+            _state = State::Trailer;
+    }
+
+    /** @return false if the byte is not part of a number. */
+    bool accumulateNumber(char c)
+    {
+        if (c == '-' && _digits == 0 && !_negative && _fraction < 0)
+        {
+            _negative = true;
+            return true;
+        }
+        if (c == '.' && _fraction < 0 && _digits > 0)
+        {
+            _fraction = 0;
+            return true;
+        }
+        if (c < '0' || c > '9')
+            return false;
+
+        _digits++;
+        if (_fraction < 0)
+        {
+            if (_value <= MAX_FIXED_VALUE / 10)
+                _value = _value * 10 + (c - '0');
+            else
+                _value = MAX_FIXED_VALUE + 1; // Saturate; rejected in finishNumber()
+        }
+        else if (_fraction == 0)
+        {
+            // Only one decimal is kept (the Nano prints one); further digits are truncated
+            _tenth = c - '0';
+            _fraction = 1;
+        }
+        return true;
+    }
+
+    bool finishNumber()
+    {
+        if (_digits == 0 || _value > MAX_FIXED_VALUE / 10)
+            return false;
+
+        int16_t fixed = _value * 10 + (_fraction > 0 ? _tenth : 0);
+        if (_negative)
+            fixed = -fixed;
+
+        switch (_field)
+        {
+        case 0: _pending.current = fixed; break;
+        case 1: _pending.min = fixed; break;
+        default: _pending.max = fixed; break;
+        }
+        _field = (_field + 1) % 3;
+        _state = State::Match;
+        _pos++;
+        return true;
+    }
+
+    void rejectLine()
+    {
+        _malformed++;
+        _state = State::Discard;
+    }
+
+    State _state;
+    uint8_t _pos;   // Index into TEMPLATE
+    uint8_t _field; // Next numeric field to fill
+
+    int16_t _value;
+    bool _negative;
+    uint8_t _digits;
+    int8_t _fraction; // -1: integer part, 0: after '.', 1: tenth captured
+    uint8_t _tenth;
+
+    uint32_t _malformed;
+    TelemetrySample _pending;
+    TelemetrySample _sample;
+};
@@ -0,0 +1,233 @@
+/**
+ * @file UartIngest.h
+ * @brief Nano UART ingest on its own FreeRTOS task, decoupled from the web server.
+ *
+ * The task sleeps on the ESP-IDF UART driver's event queue, so it wakes only when bytes
+ * arrive. It feeds them to both telemetry decoders and hands each decoded sample to the
+ * loop() side through a lock-free SpscRing. A slow HTTP client therefore only delays
+ * when loop() sees a sample, never the UART read itself, and a burst of UART traffic
+ * never stalls the web server.
+ * The driver owns the UART, so outgoing commands go through this class as well: it is a
+ * Print, used where Serial2 used to be.
+ * Everything the task owns - the newest sample and its counters - is published as one
+ * IngestSnapshot through a Seqlock, so any task can read a consistent set without ever
+ * making the ingest task wait.
+ * For link testing, injectFaults() damages the received bytes before decoding (LinkFaults.h);
+ * the snapshot's sequence gaps and reject counters then show how the link copes.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <driver/uart.h>
+#include <HubLink.h>
+#include "LinkFaults.h"
+#include "Seqlock.h"
+#include "SpscRing.h"
+#include "TelemetryParser.h"
+
+const int UART_INGEST_RX_BUFFER = 1024;       // Driver-side receive buffer, bytes
+const int UART_INGEST_EVENT_QUEUE = 16;       // Pending driver events
+const uint32_t UART_INGEST_STACK = 4096;      // Task stack, bytes
+const UBaseType_t UART_INGEST_PRIORITY = 5;   // Above loop() (1), below WiFi (23)
+const size_t UART_INGEST_RING = 16;           // Samples handed to loop(); ~30 s at the Nano's 2 s cadence
+
+/** A decoded sample and when the ingest task decoded it */
+struct IngestedSample
+{
+    TelemetrySample sample;
+    uint32_t decodedMicros;
+};
+
+/** State of the ingest task, published as a whole after every batch of received bytes */
+struct IngestSnapshot
+{
+    uint32_t bytes = 0;
+    uint32_t samples = 0;       // Decoded; latest is the newest of them
+    uint32_t ringDrops = 0;     // Samples lost because loop() did not drain the ring in time
+    uint32_t uartOverflows = 0; // Driver buffer overruns; buffered input is discarded
+    uint32_t maxDepth = 0;      // Deepest the ring has been right after a push
+    uint32_t malformedLines = 0;
+    uint32_t rejectedFrames = 0;
+    uint32_t sequenceGaps = 0;  // Binary telemetry frames missing between two received ones
+    uint32_t senderRestarts = 0; // Nano resets seen in the frame sequence (HubLinkSequence)
+    uint32_t faultDrops = 0;    // Bytes removed by the fault injector
+    uint32_t faultFlips = 0;    // Bits inverted by the fault injector
+    uint32_t latestMicros = 0;  // When latest was decoded
+    TelemetrySample latest = {0, 0, 0};
+};
+
+class UartIngest : public Print
+{
+public:
+    /** Enables fault injection on received bytes; call before begin() */
+    void injectFaults(const LinkFaultConfig &config)
+    {
+        _faults.begin(config);
+        _faultsEnabled = true;
+    }
+
+    /** Installs the UART driver and starts the ingest task pinned to core */
+    bool begin(uart_port_t port, uint32_t baud, int rxPin, int txPin, BaseType_t core)
+    {
+        _port = port;
+        uart_config_t config = {};
+        config.baud_rate = (int)baud;
+        config.data_bits = UART_DATA_8_BITS;
+        config.parity = UART_PARITY_DISABLE;
+        config.stop_bits = UART_STOP_BITS_1;
+        config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+
+        if (uart_driver_install(port, UART_INGEST_RX_BUFFER, 0, UART_INGEST_EVENT_QUEUE, &_events, 0) != ESP_OK ||
+            uart_param_config(port, &config) != ESP_OK ||
+            uart_set_pin(port, txPin, rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK)
+            return false;
+
+        return xTaskCreatePinnedToCore(taskEntry, "uart-ingest", UART_INGEST_STACK, this,
+                                       UART_INGEST_PRIORITY, &_task, core) == pdPASS;
+    }
+
+    /** loop() side: calls onSample(sample) for every sample decoded since the last call */
+    template <typename OnSample>
+    void poll(OnSample onSample)
+    {
+        IngestedSample item;
+        while (_ring.pop(item))
+        {
+            _lastLatency = micros() - item.decodedMicros;
+            if (_lastLatency > _maxLatency)
+                _maxLatency = _lastLatency;
+            onSample(item.sample);
+        }
+    }
+
+    /** Consistent copy of the ingest task's state; safe from any task, never blocks the ingest task */
+    IngestSnapshot snapshot() const
+    {
+        IngestSnapshot value;
+        _snapshotRetries += _snapshot.read(value);
+        return value;
+    }
+
+    // Print: commands to the Nano. uart_write_bytes is safe to call from loop() alongside the task.
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+    size_t write(const uint8_t *data, size_t length) override
+    {
+        int written = uart_write_bytes(_port, (const char *)data, length);
+        return written > 0 ? (size_t)written : 0;
+    }
+
+    size_t depth() const { return _ring.size(); }
+
+    // Decode-to-consume delay, measured by poll()
+    uint32_t lastLatencyMicros() const { return _lastLatency; }
+    uint32_t maxLatencyMicros() const { return _maxLatency; }
+
+    /** Times snapshot() had to retry because the ingest task was publishing; 0 without contention */
+    uint32_t snapshotRetries() const { return _snapshotRetries; }
+
+private:
+    static void taskEntry(void *self) { static_cast<UartIngest *>(self)->run(); }
+
+    void run()
+    {
+        uint8_t buffer[128];
+        uart_event_t event;
+        for (;;)
+        {
+            if (xQueueReceive(_events, &event, portMAX_DELAY) != pdTRUE)
+                continue;
+
+            switch (event.type)
+            {
+            case UART_DATA:
+            {
+                int length;
+                while ((length = uart_read_bytes(_port, buffer, sizeof(buffer), 0)) > 0)
+                    consume(buffer, length);
+                publishSnapshot();
+                break;
+            }
+            case UART_FIFO_OVF:
+            case UART_BUFFER_FULL:
+                // The driver stops receiving until its buffer is emptied; resync from scratch
+                _state.uartOverflows++;
+                uart_flush_input(_port);
+                xQueueReset(_events);
+                publishSnapshot();
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    /**
+     * Every byte goes to both decoders: binary frames are COBS-delimited by 0x00 and CRC-checked,
+     * ASCII lines must match the [DHT11] template, so neither accepts the other's traffic.
+     */
+    void consume(uint8_t *data, int length)
+    {
+        _state.bytes += length;
+        if (_faultsEnabled)
+            length = (int)_faults.apply(data, length);
+
+        for (int i = 0; i < length; i++)
+        {
+            if (_parser.feed((char)data[i]))
+                publish(_parser.sample());
+
+            TelemetrySample sample;
+            if (_decoder.feed(data[i]) && hubLinkReadTelemetry(_decoder.frame(), sample.current, sample.min, sample.max))
+            {
+                _sequence.track(_decoder.frame().seq);
+                publish(sample);
+            }
+        }
+    }
+
+    void publish(const TelemetrySample &sample)
+    {
+        uint32_t now = micros();
+        _state.samples++;
+        _state.latest = sample;
+        _state.latestMicros = now;
+
+        if (!_ring.push(IngestedSample{sample, now}))
+        {
+            _state.ringDrops++;
+            return;
+        }
+        uint32_t depth = _ring.size();
+        if (depth > _state.maxDepth)
+            _state.maxDepth = depth;
+    }
+
+    void publishSnapshot()
+    {
+        _state.malformedLines = _parser.malformedLines();
+        _state.rejectedFrames = _decoder.rejectedFrames();
+        _state.sequenceGaps = _sequence.gaps();
+        _state.senderRestarts = _sequence.restarts();
+        _state.faultDrops = _faults.droppedBytes();
+        _state.faultFlips = _faults.flippedBits();
+        _snapshot.write(_state);
+    }
+
+    uart_port_t _port = UART_NUM_2;
+    QueueHandle_t _events = nullptr;
+    TaskHandle_t _task = nullptr;
+    SpscRing<IngestedSample, UART_INGEST_RING> _ring;
+    TelemetryParser _parser;
+    HubLinkDecoder _decoder;
+    LinkFaultInjector _faults;
+    bool _faultsEnabled = false;
+    HubLinkSequence _sequence;
+    IngestSnapshot _state; // Ingest task's working copy
+    Seqlock<IngestSnapshot> _snapshot;
+
+    // loop() side
+    uint32_t _lastLatency = 0;
+    uint32_t _maxLatency = 0;
+    mutable uint32_t _snapshotRetries = 0;
+};
@@ -0,0 +1,180 @@
+/**
+ * @file WifiLink.h
+ * @brief Non-blocking WiFi station management with exponential backoff.
+ *
+ * WiFi driver events (got IP / disconnected) only set flags; update(), called from loop(),
+ * runs the state machine:
+ *
+ *   CONNECTING --got IP--> CONNECTED --disconnected--> BACKOFF --delay over--> CONNECTING
+ *       |                                                 ^
+ *       +-------------------- timeout --------------------+
+ *
+ * A disconnect event on its own while CONNECTING is ignored: the driver also reports one for
+ * its own teardown around WiFi.begin(), and a failed attempt is caught by the timeout anyway.
+ * The flags also record whether a disconnect came after the last got-IP, so when both arrive
+ * between two update() calls, a disconnect that followed the IP fails the attempt, while the
+ * teardown's disconnect before it still lets the link come up.
+ * While CONNECTED, WiFi.status() is checked as well, so a missed or coalesced disconnect
+ * event cannot leave the link believed up.
+ * Each failed attempt doubles the backoff delay up to WIFI_BACKOFF_MAX_MS; a successful
+ * connection resets it. Nothing here blocks, so UART ingest, history and the flash log
+ * keep running while the link is down.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <atomic>
+
+const unsigned long WIFI_CONNECT_TIMEOUT_MS = 10000; // Per attempt
+const unsigned long WIFI_BACKOFF_MIN_MS = 1000;
+const unsigned long WIFI_BACKOFF_MAX_MS = 60000;
+
+// Bits of WifiLink::_events, set on the WiFi event task and taken by update()
+const uint8_t WIFI_EVENT_GOT_IP = 0x01;
+const uint8_t WIFI_EVENT_LOST = 0x02;
+const uint8_t WIFI_EVENT_LOST_LAST = 0x04; // A disconnect came after the last got-IP, if any
+
+enum WifiState : uint8_t
+{
+    WIFI_LINK_CONNECTING,
+    WIFI_LINK_CONNECTED,
+    WIFI_LINK_BACKOFF
+};
+
+class WifiLink
+{
+public:
+    typedef void (*Callback)();
+
+    /**
+     * @brief Starts the first connection attempt and returns immediately.
+     * @param onUp Called from update() each time the link gets an IP address
+     * @param onDown Called from update() each time an established link is lost
+     */
+    void begin(const char *ssid, const char *password, Callback onUp, Callback onDown, unsigned long now)
+    {
+        _ssid = ssid;
+        _password = password;
+        _onUp = onUp;
+        _onDown = onDown;
+        instance() = this;
+
+        // Reconnects are ours to pace; the driver's own retries would bypass the backoff
+        WiFi.persistent(false);
+        WiFi.setAutoReconnect(false);
+        WiFi.mode(WIFI_STA);
+        WiFi.onEvent(onWifiEvent);
+        connect(now);
+    }
+
+    void update(unsigned long now)
+    {
+        uint8_t events = _events.exchange(0);
+        bool gotIp = events & WIFI_EVENT_GOT_IP;
+        bool lost = events & WIFI_EVENT_LOST;
+
+        switch (_state)
+        {
+        case WIFI_LINK_CONNECTING:
+            if (gotIp && !(events & WIFI_EVENT_LOST_LAST))
+            {
+                _state = WIFI_LINK_CONNECTED;
+                _backoff = WIFI_BACKOFF_MIN_MS;
+                _connects++;
+                if (_onUp)
+                    _onUp();
+            }
+            else if (gotIp || now - _since >= WIFI_CONNECT_TIMEOUT_MS)
+            {
+                retryLater(now);
+            }
+            break;
+
+        case WIFI_LINK_CONNECTED:
+            if (lost || WiFi.status() != WL_CONNECTED)
+            {
+                if (_onDown)
+                    _onDown();
+                retryLater(now);
+            }
+            break;
+
+        case WIFI_LINK_BACKOFF:
+            if (now - _since >= _delay)
+                connect(now);
+            break;
+        }
+    }
+
+    WifiState state() const { return _state; }
+    bool connected() const { return _state == WIFI_LINK_CONNECTED; }
+
+    /** Successful connections since boot; more than one means the link has dropped and recovered */
+    uint32_t connects() const { return _connects; }
+    uint32_t failedAttempts() const { return _failures; }
+
+    /** Delay before the next attempt while in BACKOFF */
+    unsigned long retryDelay() const { return _delay; }
+
+private:
+    void connect(unsigned long now)
+    {
+        _state = WIFI_LINK_CONNECTING;
+        _since = now;
+        WiFi.begin(_ssid, _password);
+    }
+
+    void retryLater(unsigned long now)
+    {
+        WiFi.disconnect();
+        if (_state == WIFI_LINK_CONNECTING)
+            _failures++;
+
+        _state = WIFI_LINK_BACKOFF;
+        _since = now;
+        _delay = _backoff;
+        _backoff = _backoff * 2 > WIFI_BACKOFF_MAX_MS ? WIFI_BACKOFF_MAX_MS : _backoff * 2;
+    }
+
+    /** Runs on the WiFi event task; only hands the event over to update() */
+    static void onWifiEvent(arduino_event_id_t event, arduino_event_info_t /* info */)
+    {
+        WifiLink *link = instance();
+        if (!link)
+            return;
+        if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP)
+        {
+            // One atomic step, so update() never takes this IP together with a disconnect from before it
+            uint8_t seen = link->_events.load();
+            while (!link->_events.compare_exchange_weak(seen, (seen | WIFI_EVENT_GOT_IP) & ~WIFI_EVENT_LOST_LAST))
+            {
+            }
+        }
+        else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED || event == ARDUINO_EVENT_WIFI_STA_LOST_IP)
+        {
+            link->_events |= WIFI_EVENT_LOST | WIFI_EVENT_LOST_LAST;
+        }
+    }
+
+    /** The driver's callback has no context pointer, so the (single) link registers itself here */
+    static WifiLink *&instance()
+    {
+        static WifiLink *link = nullptr;
+        return link;
+    }
+
+    const char *_ssid = nullptr;
+    const char *_password = nullptr;
+    Callback _onUp = nullptr;
+    Callback _onDown = nullptr;
+
+    WifiState _state = WIFI_LINK_CONNECTING;
+    unsigned long _since = 0;
+    unsigned long _delay = 0;
+    unsigned long _backoff = WIFI_BACKOFF_MIN_MS;
+    uint32_t _connects = 0;
+    uint32_t _failures = 0;
+    std::atomic<uint8_t> _events{0}; // WIFI_EVENT_* since the last update()
+};
@@ -0,0 +1,300 @@
+/**
+ * @file HubLink.h
+ * @brief Binary Nano <-> ESP32 link protocol, shared by both sketches.
+ *
+ * Wire format of one frame (before framing):
+ *   [version:1][type:1][seq:1][length:1][payload:length][crc16:2, big-endian]
+ * The CRC is CRC-16/CCITT-FALSE over everything before it. The frame is then
+ * COBS-encoded and delimited by 0x00 on both sides, so a receiver can resync on
+ * the next zero byte after line noise or interleaved ASCII log output.
+ *
+ * Humidity values travel as fixed-point tenths of a percent (45.3% -> 453).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// --- PROTOCOL CONSTANTS ---
+const uint8_t HUBLINK_VERSION = 1;
+const uint8_t HUBLINK_HEADER_SIZE = 4;
+const uint8_t HUBLINK_CRC_SIZE = 2;
+const uint8_t HUBLINK_MAX_PAYLOAD = 32;
+
+const uint8_t HUBLINK_MAX_RAW_SIZE = HUBLINK_HEADER_SIZE + HUBLINK_MAX_PAYLOAD + HUBLINK_CRC_SIZE;
+// COBS adds one overhead byte per 254 data bytes; plus a leading and trailing delimiter
+const uint8_t HUBLINK_MAX_ENCODED_SIZE = HUBLINK_MAX_RAW_SIZE + 1;
+const uint8_t HUBLINK_MAX_WIRE_SIZE = HUBLINK_MAX_ENCODED_SIZE + 2;
+
+/** Message types carried in the frame header */
+enum HubLinkType : uint8_t
+{
+    HUBLINK_TELEMETRY = 0x01, // Nano -> ESP32: current, min, max (3 x int16)
+    HUBLINK_RESET = 0x02,     // ESP32 -> Nano: reset min/max history (no payload)
+    HUBLINK_MESSAGE = 0x03    // ESP32 -> Nano: text for the LCD (not NUL-terminated)
+};
+
+struct HubLinkFrame
+{
+    uint8_t type;
+    uint8_t seq;
+    uint8_t length;
+    uint8_t payload[HUBLINK_MAX_PAYLOAD];
+};
+
+// --- CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) ---
+
+/** Bitwise implementation; avoids a 512-byte table on the Nano */
+inline uint16_t hubLinkCrc16(const uint8_t *data, size_t len, uint16_t crc = 0xFFFF)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+// --- COBS (Consistent Overhead Byte Stuffing) ---
+
+/**
+ * @brief Encodes len bytes so the output contains no 0x00.
+ * @param dst Must hold at least len + len / 254 + 1 bytes.
+ * @return Number of bytes written.
+ */
+inline size_t hubLinkCobsEncode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t write = 1;
+    size_t codeIndex = 0;
+    uint8_t code = 1;
+
+    for (size_t read = 0; read < len; read++)
+    {
+        if (src[read] == 0)
+        {
+            dst[codeIndex] = code;
+            code = 1;
+            codeIndex = write++;
+            continue;
+        }
+        dst[write++] = src[read];
+        if (++code == 0xFF)
+        {
+            dst[codeIndex] = code;
+            code = 1;
+            codeIndex = write++;
+        }
+    }
+    dst[codeIndex] = code;
+    return write;
+}
+
+/**
+ * @brief Reverses hubLinkCobsEncode(). dst must hold at least len bytes.
+ * @return Decoded length, or 0 if the input is not valid COBS.
+ */
+inline size_t hubLinkCobsDecode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t read = 0;
+    size_t write = 0;
+
+    while (read < len)
+    {
+        uint8_t code = src[read++];
+        if (code == 0)
+            return 0;
+        for (uint8_t i = 1; i < code; i++)
+        {
+            if (read >= len || src[read] == 0)
+                return 0;
+            dst[write++] = src[read++];
+        }
+        if (code != 0xFF && read < len)
+            dst[write++] = 0;
+    }
+    return write;
+}
+
+// --- FRAME ENCODING ---
+
+/**
+ * @brief Serializes a frame into its on-wire form, including both delimiters.
+ * @param out Must hold HUBLINK_MAX_WIRE_SIZE bytes.
+ * @return Bytes to transmit, or 0 if the payload is too long.
+ */
+inline size_t hubLinkEncode(const HubLinkFrame &frame, uint8_t *out)
+{
+    if (frame.length > HUBLINK_MAX_PAYLOAD)
+        return 0;
+
+    uint8_t raw[HUBLINK_MAX_RAW_SIZE];
+    raw[0] = HUBLINK_VERSION;
+    raw[1] = frame.type;
+    raw[2] = frame.seq;
+    raw[3] = frame.length;
+    memcpy(raw + HUBLINK_HEADER_SIZE, frame.payload, frame.length);
+
+    size_t rawLength = HUBLINK_HEADER_SIZE + frame.length;
+    uint16_t crc = hubLinkCrc16(raw, rawLength);
+    raw[rawLength++] = (uint8_t)(crc >> 8);
+    raw[rawLength++] = (uint8_t)(crc & 0xFF);
+
+    // Leading delimiter flushes any partial garbage sitting in the receiver's buffer
+    out[0] = 0;
+    size_t encoded = hubLinkCobsEncode(raw, rawLength, out + 1);
+    out[encoded + 1] = 0;
+    return encoded + 2;
+}
+
+/** Builds a telemetry frame from fixed-point humidity values */
+inline void hubLinkMakeTelemetry(HubLinkFrame &frame, uint8_t seq, int16_t current, int16_t min, int16_t max)
+{
+    const int16_t values[3] = {current, min, max};
+    frame.type = HUBLINK_TELEMETRY;
+    frame.seq = seq;
+    frame.length = 6;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        frame.payload[i * 2] = (uint8_t)((uint16_t)values[i] & 0xFF);
+        frame.payload[i * 2 + 1] = (uint8_t)((uint16_t)values[i] >> 8);
+    }
+}
+
+/** @return false if the frame is not a well-formed telemetry frame. */
+inline bool hubLinkReadTelemetry(const HubLinkFrame &frame, int16_t &current, int16_t &min, int16_t &max)
+{
+    if (frame.type != HUBLINK_TELEMETRY || frame.length != 6)
+        return false;
+    current = (int16_t)(frame.payload[0] | (frame.payload[1] << 8));
+    min = (int16_t)(frame.payload[2] | (frame.payload[3] << 8));
+    max = (int16_t)(frame.payload[4] | (frame.payload[5] << 8));
+    return true;
+}
+
+/** Builds a payload-only command frame (e.g. HUBLINK_RESET), or a text frame truncated to the payload size */
+inline void hubLinkMakeCommand(HubLinkFrame &frame, uint8_t type, uint8_t seq, const char *text = nullptr, size_t textLength = 0)
+{
+    if (textLength > HUBLINK_MAX_PAYLOAD)
+        textLength = HUBLINK_MAX_PAYLOAD;
+    frame.type = type;
+    frame.seq = seq;
+    frame.length = (uint8_t)textLength;
+    if (textLength > 0)
+        memcpy(frame.payload, text, textLength);
+}
+
+// --- FRAME DECODING ---
+
+/**
+ * @brief Incremental receiver. Feed every received byte; a complete, CRC-checked
+ * frame is reported when its closing delimiter arrives.
+ */
+class HubLinkDecoder
+{
+public:
+    /** @return true when this byte completed a valid frame; it is then available from frame(). */
+    bool feed(uint8_t byte)
+    {
+        if (byte != 0)
+        {
+            if (_count < HUBLINK_MAX_ENCODED_SIZE)
+                _buffer[_count++] = byte;
+            else
+                _overflowed = true;
+            return false;
+        }
+
+        // Delimiter: an empty buffer is just the leading delimiter of the next frame
+        if (_count == 0)
+            return false;
+
+        bool valid = !_overflowed && decode();
+        if (!valid)
+            _rejected++;
+        _count = 0;
+        _overflowed = false;
+        return valid;
+    }
+
+    const HubLinkFrame &frame() const { return _frame; }
+
+    /** Frames dropped because of a bad CRC, version, length, or COBS encoding */
+    uint32_t rejectedFrames() const { return _rejected; }
+
+private:
+    bool decode()
+    {
+        uint8_t raw[HUBLINK_MAX_ENCODED_SIZE];
+        size_t rawLength = hubLinkCobsDecode(_buffer, _count, raw);
+        if (rawLength < HUBLINK_HEADER_SIZE + HUBLINK_CRC_SIZE)
+            return false;
+
+        size_t payloadLength = rawLength - HUBLINK_HEADER_SIZE - HUBLINK_CRC_SIZE;
+        if (raw[0] != HUBLINK_VERSION || raw[3] != payloadLength || payloadLength > HUBLINK_MAX_PAYLOAD)
+            return false;
+
+        uint16_t expected = ((uint16_t)raw[rawLength - 2] << 8) | raw[rawLength - 1];
+        if (hubLinkCrc16(raw, rawLength - HUBLINK_CRC_SIZE) != expected)
+            return false;
+
+        _frame.type = raw[1];
+        _frame.seq = raw[2];
+        _frame.length = (uint8_t)payloadLength;
+        memcpy(_frame.payload, raw + HUBLINK_HEADER_SIZE, payloadLength);
+        return true;
+    }
+
+    uint8_t _buffer[HUBLINK_MAX_ENCODED_SIZE];
+    uint8_t _count = 0;
+    bool _overflowed = false;
+    uint32_t _rejected = 0;
+    HubLinkFrame _frame;
+};
+
+// --- SEQUENCE TRACKING ---
+
+/**
+ * @brief Counts telemetry frames lost between received ones from their sequence numbers.
+ * The Nano numbers frames from 0 after every reset, so a frame with seq 0 that was not the
+ * one expected is taken as a restart: the count resyncs and nothing is added as lost.
+ * That leaves two small biases, both towards fewer gaps than really happened: frames lost
+ * just before a counter wrap that ends on seq 0, and frames lost from the tail of the old
+ * run (the restart hides them). If the restart's own seq 0 frame is lost, the first one
+ * heard after it counts as a jump; jumps of half the sequence space or more are also taken
+ * as a restart rather than counted.
+ */
+class HubLinkSequence
+{
+public:
+    /** @return Frames missing just before this one */
+    uint8_t track(uint8_t seq)
+    {
+        uint8_t gap = 0;
+        if (_started)
+        {
+            uint8_t jump = (uint8_t)(seq - _expected);
+            if (jump != 0 && (seq == 0 || jump >= 128))
+                _restarts++;
+            else
+                gap = jump;
+        }
+        _started = true;
+        _expected = (uint8_t)(seq + 1);
+        _gaps += gap;
+        return gap;
+    }
+
+    uint32_t gaps() const { return _gaps; }
+
+    /** Sender restarts (or jumps too large to be losses) seen since the first frame */
+    uint32_t restarts() const { return _restarts; }
+
+private:
+    bool _started = false;
+    uint8_t _expected = 0;
+    uint32_t _gaps = 0;
+    uint32_t _restarts = 0;
+};
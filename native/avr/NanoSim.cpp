@@ -0,0 +1,492 @@
+/**
+ * @file NanoSim.cpp
+ * @brief Runs the Nano firmware on a simulated ATmega328P (simavr) and reports what only
+ * the real chip shows: cycles per loop() pass, command handling latency and SRAM.
+ *
+ * The firmware is Arduino_Nano.ino built with -DHUB_SIMAVR -DHUB_PROFILE_LOOP=1 (see
+ * CMakeLists.txt), so LoopProfiler marks every pass and command in GPIOR0 (ProfileMarks.h)
+ * and this program timestamps each mark to the cycle. Around it:
+ *   - a DHT11 on D4 answers every start signal with a full 40-bit response;
+ *   - the LCD's PCF8574 backpack acknowledges every I2C byte at 0x27, so each screen update
+ *     runs its whole bus transfer as on the board;
+ *   - HubLink commands (reset, a full 16-character LCD row, bursts of both) arrive on the
+ *     UART at 9600 baud. Each command's latency runs from the last byte of its own frame,
+ *     matched by seq, to its handler returning;
+ *   - the stack pointer is sampled after every instruction for the true high-water mark,
+ *     next to the firmware's own [PROFILE] line (painted-stack and free-SRAM figures).
+ * Usage:
+ *   NanoSim FIRMWARE.elf [--seconds N] [--max-loop-cycles N] [--max-command-cycles N]
+ *                        [--min-free-sram N]
+ * Exits 1 when a budget is exceeded or the firmware stops producing telemetry, so the run
+ * can gate every Nano change; a budget of 0 is reported but not checked.
+ */
+
+#include <sim_avr.h>
+#include <sim_elf.h>
+#include <sim_io.h>
+#include <sim_irq.h>
+#include <avr_ioport.h>
+#include <avr_twi.h>
+#include <avr_uart.h>
+#include <HubLink.h>
+#include "ProfileMarks.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const uint32_t CPU_FREQUENCY = 16000000;
+const char *const DEFAULT_MCU = "atmega328p";
+
+// Arduino_Nano.ino
+const uint32_t BAUD_RATE = 9600;
+const uint8_t DHT_BIT = 4;          // PIN_DHT: D4 is PD4
+const uint8_t LCD_I2C_ADDR = 0x27;
+const char *const FULL_ROW_MESSAGE = "HUMIDITY ALERT!!"; // LCD_COLUMNS characters, nothing truncated
+
+// ATmega328P data-space addresses
+const avr_io_addr_t ADDR_GPIOR0 = 0x3E;
+const uint16_t ADDR_GPIOR1 = 0x4A;
+const uint16_t ADDR_DDRD = 0x2A;
+const uint16_t ADDR_PORTD = 0x2B;
+const uint16_t ADDR_SPL = 0x5D;
+const uint16_t ADDR_SPH = 0x5E;
+const uint16_t RAMEND = 0x08FF;
+
+const uint32_t BYTE_MICROS = 10 * 1000000 / BAUD_RATE; // Start, 8 data and stop bits
+const uint32_t DHT_MIN_START_MICROS = 18000;           // The sensor ignores shorter lows
+const uint8_t DHT_HUMIDITY = 47;
+const uint8_t DHT_TEMPERATURE = 22;
+
+struct Options
+{
+    const char *firmware = nullptr;
+    uint32_t seconds = 30;
+    uint64_t maxLoopCycles = 0;
+    uint64_t maxCommandCycles = 0;
+    uint32_t minFreeSram = 0;
+};
+
+/** One byte for the UART; the last one of a frame records when that frame was complete */
+struct TxByte
+{
+    uint8_t value;
+    bool frameEnd;
+    uint8_t seq;
+};
+
+struct Segment
+{
+    uint8_t level;
+    uint32_t micros;
+};
+
+/** Everything the callbacks share */
+struct Sim
+{
+    avr_t *avr = nullptr;
+    avr_irq_t *uartIn = nullptr;
+    avr_irq_t *dhtPin = nullptr;
+
+    // UART in: bytes waiting to go out at the line rate; the cycle each command frame ended, by seq
+    std::deque<TxByte> txQueue;
+    std::array<avr_cycle_count_t, 256> frameEndAt{};
+    uint8_t commandSeq = 0;
+    uint32_t commandsSent = 0;
+
+    // UART out: telemetry frames and the firmware's own report
+    HubLinkDecoder decoder;
+    uint32_t telemetryFrames = 0;
+    std::string outputLine;
+    std::string lastProfileLine;
+
+    // I2C LCD
+    avr_irq_t *twiIn = nullptr;
+    bool lcdSelected = false;
+    uint32_t lcdBytes = 0;
+
+    // DHT11 line
+    bool dhtDrivenLow = false;
+    avr_cycle_count_t dhtLowSince = 0;
+    std::vector<Segment> dhtResponse;
+    size_t dhtSegment = 0;
+    uint32_t dhtResponses = 0;
+
+    // GPIOR0 marks
+    avr_cycle_count_t passStart = 0;
+    avr_cycle_count_t commandStart = 0;
+    uint8_t commandStartSeq = 0;
+    bool skipPass = false;
+    std::vector<uint32_t> passCycles;
+    uint64_t commandPeakCycles = 0;
+    uint64_t commandLatencyPeakCycles = 0;
+    uint32_t commandsHandled = 0;
+    uint32_t commandsUnmatched = 0; // Handled, but their frame's end was not seen
+
+    uint16_t minSp = RAMEND;
+};
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--seconds" && hasValue)
+            options.seconds = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--max-loop-cycles" && hasValue)
+            options.maxLoopCycles = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--max-command-cycles" && hasValue)
+            options.maxCommandCycles = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--min-free-sram" && hasValue)
+            options.minFreeSram = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (arg[0] != '-' && !options.firmware)
+            options.firmware = argv[i];
+        else
+            return false;
+    }
+    return options.firmware && options.seconds > 0;
+}
+
+// --- UART ---
+
+void queueCommand(Sim &sim, uint8_t type, const char *text = nullptr)
+{
+    HubLinkFrame frame;
+    uint8_t seq = sim.commandSeq++;
+    hubLinkMakeCommand(frame, type, seq, text, text ? strlen(text) : 0);
+    uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+    size_t length = hubLinkEncode(frame, wire);
+    for (size_t i = 0; i < length; i++)
+        sim.txQueue.push_back({wire[i], i + 1 == length, seq});
+    sim.commandsSent++;
+}
+
+/** One byte per character time, like the ESP32's UART at the same baud rate */
+avr_cycle_count_t sendNextByte(avr_t *avr, avr_cycle_count_t when, void *param)
+{
+    Sim &sim = *(Sim *)param;
+    if (!sim.txQueue.empty())
+    {
+        TxByte next = sim.txQueue.front();
+        sim.txQueue.pop_front();
+        avr_raise_irq(sim.uartIn, next.value);
+        if (next.frameEnd)
+            sim.frameEndAt[next.seq] = avr->cycle;
+    }
+    return when + avr_usec_to_cycles(avr, BYTE_MICROS);
+}
+
+/** The command script: single frames, then bursts that arrive while the loop is busy */
+avr_cycle_count_t runScript(avr_t *avr, avr_cycle_count_t when, void *param)
+{
+    Sim &sim = *(Sim *)param;
+    uint64_t second = avr_cycles_to_usec(avr, when) / 1000000;
+    if (second % 10 == 4)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            queueCommand(sim, HUBLINK_MESSAGE, "BURST MESSAGE");
+            queueCommand(sim, HUBLINK_RESET);
+        }
+    }
+    else if (second % 2 == 0)
+    {
+        queueCommand(sim, HUBLINK_MESSAGE, FULL_ROW_MESSAGE);
+    }
+    else
+    {
+        queueCommand(sim, HUBLINK_RESET);
+    }
+    return when + avr_usec_to_cycles(avr, 1000000);
+}
+
+void onUartOutput(avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq;
+    Sim &sim = *(Sim *)param;
+    uint8_t byte = (uint8_t)value;
+    if (sim.decoder.feed(byte) && sim.decoder.frame().type == HUBLINK_TELEMETRY)
+        sim.telemetryFrames++;
+
+    // Text lines share the link with binary frames, whose delimiter also ends a line here
+    if (byte == '\n' || byte == 0)
+    {
+        size_t at = sim.outputLine.find("[PROFILE]");
+        if (at != std::string::npos)
+        {
+            sim.lastProfileLine = sim.outputLine.substr(at);
+            printf("%s\n", sim.lastProfileLine.c_str());
+        }
+        sim.outputLine.clear();
+    }
+    else if (byte != '\r' && sim.outputLine.size() < 160)
+    {
+        sim.outputLine += (char)byte;
+    }
+}
+
+// --- I2C LCD ---
+
+/** The PCF8574 backpack: acknowledges its address and every byte written to it */
+void onTwiOutput(avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq;
+    Sim &sim = *(Sim *)param;
+    avr_twi_msg_irq_t message;
+    message.u.v = value;
+
+    if (message.u.twi.msg & TWI_COND_STOP)
+        sim.lcdSelected = false;
+    if (message.u.twi.msg & TWI_COND_START)
+    {
+        sim.lcdSelected = (message.u.twi.addr >> 1) == LCD_I2C_ADDR;
+        if (sim.lcdSelected)
+            avr_raise_irq(sim.twiIn, avr_twi_irq_msg(TWI_COND_ACK, message.u.twi.addr, 1));
+    }
+    else if (sim.lcdSelected && (message.u.twi.msg & TWI_COND_WRITE))
+    {
+        sim.lcdBytes++;
+        avr_raise_irq(sim.twiIn, avr_twi_irq_msg(TWI_COND_ACK, message.u.twi.addr, 1));
+    }
+}
+
+// --- DHT11 ---
+
+/** The response to one start signal, from the sensor's first low to the line's release */
+std::vector<Segment> dhtFrame()
+{
+    const uint8_t data[5] = {DHT_HUMIDITY, 0, DHT_TEMPERATURE, 0, (uint8_t)(DHT_HUMIDITY + DHT_TEMPERATURE)};
+    std::vector<Segment> segments = {{1, 30}, {0, 80}, {1, 80}};
+    for (uint8_t bit = 0; bit < 40; bit++)
+    {
+        bool one = data[bit / 8] & (0x80 >> (bit % 8));
+        segments.push_back({0, 50});
+        segments.push_back({1, one ? 70u : 26u});
+    }
+    segments.push_back({0, 50});
+    segments.push_back({1, 0});
+    return segments;
+}
+
+avr_cycle_count_t driveDht(avr_t *avr, avr_cycle_count_t when, void *param)
+{
+    Sim &sim = *(Sim *)param;
+    const Segment &segment = sim.dhtResponse[sim.dhtSegment++];
+    avr_raise_irq(sim.dhtPin, segment.level);
+    if (sim.dhtSegment == sim.dhtResponse.size())
+    {
+        sim.dhtResponses++;
+        return 0;
+    }
+    return when + avr_usec_to_cycles(avr, segment.micros);
+}
+
+/** Polled after every instruction: the firmware drives the line low, then releases it */
+void watchDhtLine(Sim &sim)
+{
+    avr_t *avr = sim.avr;
+    bool drivenLow = (avr->data[ADDR_DDRD] & (1 << DHT_BIT)) && !(avr->data[ADDR_PORTD] & (1 << DHT_BIT));
+    if (drivenLow == sim.dhtDrivenLow)
+        return;
+    sim.dhtDrivenLow = drivenLow;
+    if (drivenLow)
+    {
+        sim.dhtLowSince = avr->cycle;
+        avr_raise_irq(sim.dhtPin, 0);
+        return;
+    }
+    avr_raise_irq(sim.dhtPin, 1);
+    if (avr_cycles_to_usec(avr, avr->cycle - sim.dhtLowSince) < DHT_MIN_START_MICROS)
+        return;
+    sim.dhtResponse = dhtFrame();
+    sim.dhtSegment = 0;
+    avr_cycle_timer_register(avr, 1, driveDht, &sim);
+}
+
+// --- PROFILE MARKS ---
+
+void onProfileMark(avr_t *avr, avr_io_addr_t addr, uint8_t value, void *param)
+{
+    Sim &sim = *(Sim *)param;
+    avr->data[addr] = value;
+    switch (value)
+    {
+    case PROFILE_MARK_PASS_START:
+        sim.passStart = avr->cycle;
+        break;
+    case PROFILE_MARK_PASS_END:
+        if (!sim.skipPass && sim.passStart)
+            sim.passCycles.push_back((uint32_t)(avr->cycle - sim.passStart));
+        sim.skipPass = false;
+        break;
+    case PROFILE_MARK_SKIP_PASS:
+        sim.skipPass = true;
+        break;
+    case PROFILE_MARK_COMMAND_START:
+        sim.commandStart = avr->cycle;
+        sim.commandStartSeq = avr->data[ADDR_GPIOR1];
+        break;
+    case PROFILE_MARK_COMMAND_END:
+    {
+        sim.commandsHandled++;
+        sim.commandPeakCycles = std::max<uint64_t>(sim.commandPeakCycles, avr->cycle - sim.commandStart);
+        // By seq: a frame the firmware dropped (overrun, bad CRC) must not shift the pairing of later ones
+        avr_cycle_count_t &frameEnd = sim.frameEndAt[sim.commandStartSeq];
+        if (frameEnd)
+            sim.commandLatencyPeakCycles = std::max<uint64_t>(sim.commandLatencyPeakCycles, avr->cycle - frameEnd);
+        else
+            sim.commandsUnmatched++;
+        frameEnd = 0;
+        break;
+    }
+    }
+}
+
+uint32_t percentile(std::vector<uint32_t> sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[(size_t)(p * (sorted.size() - 1) + 0.5)];
+}
+
+/** The value after key= in the firmware's [PROFILE] line, or -1 */
+long profileField(const std::string &line, const char *key)
+{
+    std::string pattern = std::string(" ") + key + "=";
+    size_t at = line.find(pattern);
+    return at == std::string::npos ? -1 : strtol(line.c_str() + at + pattern.size(), nullptr, 10);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: %s FIRMWARE.elf [--seconds N] [--max-loop-cycles N] [--max-command-cycles N] "
+                        "[--min-free-sram N]\n", argv[0]);
+        return 2;
+    }
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+    if (elf_read_firmware(options.firmware, &firmware) != 0)
+    {
+        fprintf(stderr, "[NANOSIM] Cannot read %s\n", options.firmware);
+        return 2;
+    }
+    if (!firmware.frequency)
+        firmware.frequency = CPU_FREQUENCY;
+
+    Sim sim;
+    sim.avr = avr_make_mcu_by_name(firmware.mmcu[0] ? firmware.mmcu : DEFAULT_MCU);
+    if (!sim.avr)
+    {
+        fprintf(stderr, "[NANOSIM] Unknown MCU\n");
+        return 2;
+    }
+    avr_t *avr = sim.avr;
+    avr_init(avr);
+    avr_load_firmware(avr, &firmware);
+
+    // The UART's bytes come here instead of simavr's stdout echo
+    uint32_t uartFlags = 0;
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &uartFlags);
+    uartFlags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &uartFlags);
+    sim.uartIn = avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), onUartOutput, &sim);
+
+    sim.twiIn = avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), onTwiOutput, &sim);
+
+    sim.dhtPin = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), DHT_BIT);
+    avr_raise_irq(sim.dhtPin, 1); // Idle line, held high by the pull-up
+    avr_register_io_write(avr, ADDR_GPIOR0, onProfileMark, &sim);
+
+    // Commands start once the boot splash is up, then keep coming every second
+    avr_cycle_timer_register_usec(avr, 3000000, runScript, &sim);
+    avr_cycle_timer_register_usec(avr, BYTE_MICROS, sendNextByte, &sim);
+
+    avr_cycle_count_t end = avr_usec_to_cycles(avr, (uint64_t)options.seconds * 1000000);
+    int state = cpu_Running;
+    while (avr->cycle < end && state != cpu_Done && state != cpu_Crashed)
+    {
+        state = avr_run(avr);
+        uint16_t sp = avr->data[ADDR_SPL] | (avr->data[ADDR_SPH] << 8);
+        if (sp < sim.minSp && sp > 0)
+            sim.minSp = sp;
+        watchDhtLine(sim);
+    }
+    if (state == cpu_Crashed)
+    {
+        fprintf(stderr, "[NANOSIM] Firmware crashed at pc 0x%04x\n", (unsigned)avr->pc);
+        return 1;
+    }
+
+    uint64_t passTotal = 0;
+    uint32_t passMax = 0;
+    for (uint32_t cycles : sim.passCycles)
+    {
+        passTotal += cycles;
+        passMax = std::max(passMax, cycles);
+    }
+    uint32_t passes = (uint32_t)sim.passCycles.size();
+    long stackUnused = profileField(sim.lastProfileLine, "stack_unused");
+    long sramFree = profileField(sim.lastProfileLine, "sram_free");
+
+    printf("[NANOSIM] %u s simulated, %u loop passes, cycles/pass min=%u p50=%u p99=%u max=%u avg=%llu\n",
+           options.seconds, passes, percentile(sim.passCycles, 0.0), percentile(sim.passCycles, 0.5),
+           percentile(sim.passCycles, 0.99), passMax, (unsigned long long)(passes ? passTotal / passes : 0));
+    printf("[NANOSIM] commands sent=%u handled=%u unmatched=%u handler_peak_cycles=%llu latency_peak_cycles=%llu "
+           "(%.0f us)\n",
+           sim.commandsSent, sim.commandsHandled, sim.commandsUnmatched, (unsigned long long)sim.commandPeakCycles,
+           (unsigned long long)sim.commandLatencyPeakCycles,
+           (double)avr_cycles_to_usec(avr, sim.commandLatencyPeakCycles));
+    printf("[NANOSIM] stack_peak=%u bytes (sp low 0x%04x), firmware: stack_unused=%ld sram_free=%ld\n",
+           (unsigned)(RAMEND - sim.minSp), (unsigned)sim.minSp, stackUnused, sramFree);
+    printf("[NANOSIM] dht_responses=%u telemetry_frames=%u lcd_i2c_bytes=%u\n", sim.dhtResponses,
+           sim.telemetryFrames, sim.lcdBytes);
+
+    bool ok = true;
+    if (sim.telemetryFrames == 0 || sim.lastProfileLine.empty())
+    {
+        printf("[NANOSIM] FAIL: no telemetry or [PROFILE] output\n");
+        ok = false;
+    }
+    // Without the panel's transfers the loop figures would leave out the slowest work there is
+    if (sim.lcdBytes == 0)
+    {
+        printf("[NANOSIM] FAIL: the firmware never wrote to the LCD at 0x%02x\n", LCD_I2C_ADDR);
+        ok = false;
+    }
+    if (options.maxLoopCycles && passMax > options.maxLoopCycles)
+    {
+        printf("[NANOSIM] FAIL: loop pass of %u cycles, budget %llu\n", passMax,
+               (unsigned long long)options.maxLoopCycles);
+        ok = false;
+    }
+    if (options.maxCommandCycles && sim.commandLatencyPeakCycles > options.maxCommandCycles)
+    {
+        printf("[NANOSIM] FAIL: command latency of %llu cycles, budget %llu\n",
+               (unsigned long long)sim.commandLatencyPeakCycles, (unsigned long long)options.maxCommandCycles);
+        ok = false;
+    }
+    if (options.minFreeSram && stackUnused >= 0 && (uint32_t)stackUnused < options.minFreeSram)
+    {
+        printf("[NANOSIM] FAIL: %ld bytes of SRAM never used, budget %u\n", stackUnused, options.minFreeSram);
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file CommandReaderBench.cpp
+ * @brief The Nano's command path from received bytes to LCD text, for both link formats:
+ * CommandReader plus dispatchCommand()'s matching for R:1 / M:<text> lines, and
+ * HubLinkDecoder plus dispatchFrame() for command frames. Both end in
+ * handleMessageCommand()'s copy to a printable LCD row. The mix is the web UI's: resets,
+ * short messages and messages longer than a row.
+ */
+
+#include <benchmark/benchmark.h>
+#include <HubLink.h>
+#include "CommandReader.h"
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const uint8_t LCD_COLUMNS = 16; // Arduino_Nano.ino
+
+const char *const MESSAGES[] = {"HELLO FROM HUB", "WINDOW OPEN", "HUMIDITY ALERT IN THE BASEMENT!"};
+
+struct Dispatched
+{
+    uint32_t resets = 0;
+    uint32_t messages = 0;
+    uint32_t rejected = 0;
+    char line[LCD_COLUMNS + 1];
+};
+
+/** handleMessageCommand(): at most one row, printable ASCII only */
+void showMessage(Dispatched &out, const char *msg, size_t length)
+{
+    if (length > LCD_COLUMNS)
+        length = LCD_COLUMNS;
+    for (size_t i = 0; i < length; i++)
+        out.line[i] = (msg[i] >= ' ' && msg[i] <= '~') ? msg[i] : ' ';
+    out.line[length] = '\0';
+    out.messages++;
+}
+
+void dispatchCommand(Dispatched &out, const char *cmd, uint8_t length)
+{
+    if (strcmp(cmd, "R:1") == 0)
+        out.resets++;
+    else if (strncmp(cmd, "M:", 2) == 0)
+        showMessage(out, cmd + 2, length - 2);
+    else
+        out.rejected++;
+}
+
+void dispatchFrame(Dispatched &out, const HubLinkFrame &frame)
+{
+    if (frame.type == HUBLINK_RESET)
+        out.resets++;
+    else if (frame.type == HUBLINK_MESSAGE)
+        showMessage(out, (const char *)frame.payload, frame.length);
+    else
+        out.rejected++;
+}
+
+/** Reset, then each message, as the ESP32 sends them in either format */
+std::vector<std::string> commandMix(bool binary)
+{
+    std::vector<std::string> commands;
+    uint8_t seq = 0;
+    for (int i = -1; i < (int)(sizeof(MESSAGES) / sizeof(MESSAGES[0])); i++)
+    {
+        const char *text = i < 0 ? nullptr : MESSAGES[i];
+        if (!binary)
+        {
+            commands.push_back(text ? std::string("M:") + text + "\n" : std::string("R:1\n"));
+            continue;
+        }
+        HubLinkFrame frame;
+        hubLinkMakeCommand(frame, text ? HUBLINK_MESSAGE : HUBLINK_RESET, seq++, text, text ? strlen(text) : 0);
+        uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+        commands.push_back(std::string((const char *)wire, hubLinkEncode(frame, wire)));
+    }
+    return commands;
+}
+
+void setCommandCounters(benchmark::State &state, const std::vector<std::string> &commands, const Dispatched &out)
+{
+    size_t bytes = 0;
+    for (const std::string &command : commands)
+        bytes += command.size();
+    state.counters["commands_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+    state.counters["bytes_per_command"] = (double)bytes / commands.size();
+    if (out.rejected)
+        state.SkipWithError("a well-formed command was rejected");
+}
+
+void BM_AsciiCommandParse(benchmark::State &state)
+{
+    std::vector<std::string> commands = commandMix(false);
+    CommandReader reader;
+    Dispatched out;
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        for (char c : commands[next])
+        {
+            if (reader.feed(c))
+                dispatchCommand(out, reader.line(), reader.length());
+        }
+        benchmark::DoNotOptimize(out);
+        next = (next + 1) % commands.size();
+    }
+    setCommandCounters(state, commands, out);
+}
+BENCHMARK(BM_AsciiCommandParse);
+
+void BM_HubLinkCommandParse(benchmark::State &state)
+{
+    std::vector<std::string> commands = commandMix(true);
+    HubLinkDecoder decoder;
+    Dispatched out;
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        for (char c : commands[next])
+        {
+            if (decoder.feed((uint8_t)c))
+                dispatchFrame(out, decoder.frame());
+        }
+        benchmark::DoNotOptimize(out);
+        next = (next + 1) % commands.size();
+    }
+    setCommandCounters(state, commands, out);
+}
+BENCHMARK(BM_HubLinkCommandParse);
+
+} // namespace
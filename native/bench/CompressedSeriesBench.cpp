@@ -0,0 +1,81 @@
+/**
+ * @file CompressedSeriesBench.cpp
+ * @brief CompressedSeries on a DHT11-like trace: whole-percent readings every 2 s with the
+ * odd late sample. Reports bytes per sample, the ratio against an uncompressed 8-byte
+ * (uint32 time, float value) record, and append and streaming-decode throughput.
+ */
+
+#include <benchmark/benchmark.h>
+#include "CompressedSeries.h"
+
+namespace
+{
+
+const size_t TRACE_BLOCKS = 1024;
+const size_t TRACE_SAMPLES = 200000;
+const double RAW_SAMPLE_BYTES = sizeof(uint32_t) + sizeof(float);
+
+/** The DHT11 reports whole percents, i.e. steps of 10 tenths; the Nano's timer jitters by a second now and then */
+void fillTrace(CompressedSeries &series)
+{
+    uint32_t state = 7;
+    uint32_t time = 1700000000UL;
+    int16_t value = 450;
+    for (size_t i = 0; i < TRACE_SAMPLES; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        uint32_t roll = (state >> 16) % 64;
+        time += roll == 0 ? 3 : roll == 1 ? 1 : 2;
+        if (roll >= 60)
+            value += roll % 2 ? 10 : -10;
+        series.append(time, value);
+    }
+}
+
+const CompressedSeries &trace()
+{
+    static CompressedSeries series;
+    if (series.blocks() == 0)
+    {
+        series.begin(TRACE_BLOCKS);
+        fillTrace(series);
+    }
+    return series;
+}
+
+/** Per-sample append cost; the ring keeps evicting its oldest block, as on a hub running for months */
+void BM_CompressedSeriesAppend(benchmark::State &state)
+{
+    static CompressedSeries series;
+    if (series.blocks() == 0)
+        series.begin(TRACE_BLOCKS);
+    static uint32_t time = 1700000000UL; // Carries on across runs, timestamps only move forward
+    int16_t value = 450;
+    for (auto _ : state)
+    {
+        time += 2;
+        value ^= (time & 0x3e) == 0 ? 10 : 0;
+        series.append(time, value);
+    }
+    state.counters["samples_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_CompressedSeriesAppend);
+
+void BM_CompressedSeriesDecode(benchmark::State &state)
+{
+    const CompressedSeries &series = trace();
+    size_t samples = 0;
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+        series.forEach(0, UINT32_MAX, [&](uint32_t time, int16_t value) { sum += time + value; });
+        benchmark::DoNotOptimize(sum);
+        samples += TRACE_SAMPLES;
+    }
+    state.counters["samples_per_second"] = benchmark::Counter((double)samples, benchmark::Counter::kIsRate);
+    state.counters["bytes_per_sample"] = (double)series.bytesUsed() / TRACE_SAMPLES;
+    state.counters["compression_ratio"] = RAW_SAMPLE_BYTES * TRACE_SAMPLES / (double)series.bytesUsed();
+}
+BENCHMARK(BM_CompressedSeriesDecode)->Unit(benchmark::kMillisecond);
+
+} // namespace
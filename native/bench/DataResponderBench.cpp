@@ -0,0 +1,102 @@
+/**
+ * @file DataResponderBench.cpp
+ * @brief /api/data on the booted hub: the cached handleGetData() (200 and 304) against the
+ * String-concatenating handler it replaced. Each iteration is one HTTP request over loopback;
+ * reports request latency (real time, loopback and harness polling included) and, inside the
+ * handler, its time and heap allocations per request. The handler figures include the shim
+ * WebServer's own header building, the same for all three.
+ */
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <benchmark/benchmark.h>
+#include "AllocCounter.h"
+#include "HubHarness.h"
+#include "TelemetryParser.h"
+
+#include <chrono>
+#include <string>
+
+// ESP32.ino
+extern WebServer server;
+extern TelemetrySample latestSample;
+extern char dataEtag[];
+void handleGetData();
+
+namespace
+{
+
+uint64_t handlerAllocations = 0;
+std::chrono::nanoseconds handlerTime(0);
+
+/** Runs a handler with its heap allocations and time counted */
+template <typename Handler> void counted(Handler handler)
+{
+    uint64_t before = alloc_counter::allocations();
+    auto started = std::chrono::steady_clock::now();
+    handler();
+    handlerTime += std::chrono::steady_clock::now() - started;
+    handlerAllocations += alloc_counter::allocations() - before;
+}
+
+/** handleGetData() before the cached responder: six temporary Strings and three float conversions per poll */
+void legacyHandleGetData()
+{
+    float currentHum = latestSample.current / 10.0f;
+    float minHum = latestSample.min / 10.0f;
+    float maxHum = latestSample.max / 10.0f;
+    server.send(200, "application/json",
+                "{\"curr\":" + String(currentHum, 1) + ",\"min\":" + String(minHum, 1) + ",\"max\":" +
+                    String(maxHum, 1) + "}");
+}
+
+void bootOnce()
+{
+    static bool routed = false;
+    harness::boot();
+    if (routed)
+        return;
+    routed = true;
+    harness::sendSample(473, 312, 655);
+    server.on("/bench/data-legacy", [] { counted(legacyHandleGetData); });
+    server.on("/bench/data", [] { counted(handleGetData); });
+}
+
+void requestLoop(benchmark::State &state, const std::string &target, const std::string &headers, int status)
+{
+    bootOnce();
+    handlerAllocations = 0;
+    handlerTime = std::chrono::nanoseconds(0);
+    size_t wireBytes = 0;
+    for (auto _ : state)
+    {
+        harness::HttpResponse response = harness::get(target, headers);
+        if (response.status != status)
+        {
+            state.SkipWithError("unexpected status");
+            break;
+        }
+        wireBytes += response.wireBytes;
+    }
+    state.counters["allocations_per_request"] =
+        benchmark::Counter((double)handlerAllocations, benchmark::Counter::kAvgIterations);
+    state.counters["handler_ns"] =
+        benchmark::Counter((double)handlerTime.count(), benchmark::Counter::kAvgIterations);
+    state.counters["bytes_per_request"] = benchmark::Counter((double)wireBytes, benchmark::Counter::kAvgIterations);
+}
+
+void BM_ApiDataLegacy(benchmark::State &state) { requestLoop(state, "/bench/data-legacy", "", 200); }
+BENCHMARK(BM_ApiDataLegacy)->UseRealTime();
+
+void BM_ApiDataCached(benchmark::State &state) { requestLoop(state, "/bench/data", "", 200); }
+BENCHMARK(BM_ApiDataCached)->UseRealTime();
+
+/** A dashboard polling again before the next sample: the ETag matches and nothing but headers goes out */
+void BM_ApiDataNotModified(benchmark::State &state)
+{
+    bootOnce();
+    requestLoop(state, "/bench/data", std::string("If-None-Match: ") + dataEtag + "\r\n", 304);
+}
+BENCHMARK(BM_ApiDataNotModified)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,117 @@
+/**
+ * @file DownsampleBench.cpp
+ * @brief A day and a week of 2 s samples for a chart: LTTB down to 300 points against
+ * dumping every raw sample, both read from the raw tier and formatted as the
+ * /api/history JSON points ([time,value]). Reports CPU time and payload bytes.
+ */
+
+#include <benchmark/benchmark.h>
+#include "Downsample.h"
+#include "FixedPoint.h"
+#include "HistoryStore.h"
+
+namespace
+{
+
+// ESP32.ino
+const size_t LTTB_BUCKET_CAPACITY = 2048;
+
+const uint32_t SAMPLE_INTERVAL = 2; // s
+const uint32_t DAY = 86400;
+const uint32_t WEEK = 7 * DAY;
+const uint32_t START = 1700000000UL;
+const uint16_t CHART_POINTS = 300;
+
+/** A week of a DHT11 drifting through the day, with the odd spike a chart should keep */
+const HistoryStore &week()
+{
+    static HistoryStore store;
+    if (!store.ready())
+    {
+        store.begin(2048, 43200, 8760);
+        uint32_t state = 3;
+        for (uint32_t t = START; t < START + WEEK; t += SAMPLE_INTERVAL)
+        {
+            state = state * 1103515245u + 12345u;
+            int16_t value = (int16_t)(450 + ((t / 900) % 96 < 48 ? (t / 900) % 48 : 48 - (t / 900) % 48));
+            if ((state >> 16) % 5000 == 0)
+                value += 150;
+            store.add(t, value);
+        }
+    }
+    return store;
+}
+
+/** Counts what the response would carry, formatting each point as the handler does */
+class PayloadCounter
+{
+public:
+    void point(uint32_t time, int16_t value)
+    {
+        char text[24];
+        size_t length = 0;
+        text[length++] = _points > 0 ? ',' : '[';
+        if (_points > 0)
+            text[length++] = '[';
+        length += formatNumber(text + length, time);
+        text[length++] = ',';
+        length += formatTenths(text + length, value);
+        text[length++] = ']';
+        benchmark::DoNotOptimize(text);
+        _bytes += length;
+        _points++;
+    }
+
+    size_t bytes() const { return _bytes; }
+    size_t points() const { return _points; }
+
+private:
+    size_t _bytes = 0;
+    size_t _points = 0;
+};
+
+void setPayloadCounters(benchmark::State &state, const PayloadCounter &payload)
+{
+    state.counters["payload_bytes"] = (double)payload.bytes();
+    state.counters["points"] = (double)payload.points();
+}
+
+/** Arg: span in seconds, ending at the newest sample */
+void BM_ChartRawDump(benchmark::State &state)
+{
+    const HistoryStore &store = week();
+    uint32_t to = START + WEEK - 1;
+    uint32_t from = to - (uint32_t)state.range(0) + 1;
+    PayloadCounter payload;
+    for (auto _ : state)
+    {
+        payload = PayloadCounter();
+        store.scan(HISTORY_RAW, from, to, [&](const HistoryPoint &point) { payload.point(point.time, point.mean); });
+    }
+    setPayloadCounters(state, payload);
+}
+BENCHMARK(BM_ChartRawDump)->Arg(DAY)->Arg(WEEK)->Unit(benchmark::kMillisecond);
+
+void BM_ChartLttb(benchmark::State &state)
+{
+    const HistoryStore &store = week();
+    uint32_t to = START + WEEK - 1;
+    uint32_t from = to - (uint32_t)state.range(0) + 1;
+    static LttbDownsampler downsampler;
+    if (!downsampler.ready())
+        downsampler.begin(LTTB_BUCKET_CAPACITY);
+
+    PayloadCounter payload;
+    auto emit = [&](uint32_t time, int16_t value) { payload.point(time, value); };
+    for (auto _ : state)
+    {
+        payload = PayloadCounter();
+        downsampler.start(from, to, CHART_POINTS);
+        store.scan(HISTORY_RAW, from, to, [&](const HistoryPoint &point) { downsampler.add(point.time, point.mean, emit); });
+        downsampler.finish(emit);
+    }
+    setPayloadCounters(state, payload);
+}
+BENCHMARK(BM_ChartLttb)->Arg(DAY)->Arg(WEEK)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,124 @@
+/**
+ * @file HistoryBench.cpp
+ * @brief HistoryStore with ESP32.ino's tier sizes over 30 days of 2 s samples: ingest cost
+ * per sample and /api/history query latency at each tier, from an hour of raw samples to
+ * the whole month in 1-hour rollups. points_per_query is what a query emits.
+ */
+
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+#include "HistoryStore.h"
+
+namespace
+{
+
+// ESP32.ino
+const size_t HISTORY_RAW_BLOCKS = 2048;
+const size_t HISTORY_MINUTE_CAPACITY = 43200;
+const size_t HISTORY_HOUR_CAPACITY = 8760;
+
+const uint32_t SAMPLE_INTERVAL = 2; // s, SENSOR_INTERVAL on the Nano
+const uint32_t DAY = 86400;
+const uint32_t MONTH = 30 * DAY;
+const uint32_t START = 1700000000UL;
+
+/** A slow random walk, like a DHT11 indoors; deterministic so runs compare */
+class HumidityWalk
+{
+public:
+    int16_t next()
+    {
+        _state = _state * 1103515245u + 12345u;
+        if ((_state >> 16) % 16 == 0)
+            _value += (int16_t)((_state >> 24) % 3) - 1;
+        return _value;
+    }
+
+private:
+    uint32_t _state = 1;
+    int16_t _value = 450;
+};
+
+/** 30 days of history, built once and shared by the query benchmarks */
+const HistoryStore &month()
+{
+    static HistoryStore store;
+    static bool filled = false;
+    if (!filled)
+    {
+        store.begin(HISTORY_RAW_BLOCKS, HISTORY_MINUTE_CAPACITY, HISTORY_HOUR_CAPACITY);
+        HumidityWalk walk;
+        for (uint32_t t = START; t < START + MONTH; t += SAMPLE_INTERVAL)
+            store.add(t, walk.next());
+        filled = true;
+    }
+    return store;
+}
+
+void BM_HistoryIngest(benchmark::State &state)
+{
+    static HistoryStore store;
+    if (!store.ready())
+        store.begin(HISTORY_RAW_BLOCKS, HISTORY_MINUTE_CAPACITY, HISTORY_HOUR_CAPACITY);
+    // Time carries on across runs: the store drops samples older than its newest
+    static HumidityWalk walk;
+    static uint32_t t = START;
+    for (auto _ : state)
+    {
+        store.add(t, walk.next());
+        t += SAMPLE_INTERVAL;
+    }
+    state.counters["samples_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+    const CompressedSeries &raw = store.raw();
+    size_t stored = 0;
+    for (size_t i = 0; i < raw.blocks(); i++)
+        stored += raw.block(i).count;
+    state.counters["raw_bytes_per_sample"] = (double)raw.bytesUsed() / (double)stored;
+}
+BENCHMARK(BM_HistoryIngest);
+
+/** Args: span back from the newest sample (s), step (s); the store picks the tier as /api/history does */
+void BM_HistoryQuery(benchmark::State &state)
+{
+    const HistoryStore &store = month();
+    uint32_t span = (uint32_t)state.range(0);
+    uint32_t step = (uint32_t)state.range(1);
+    uint32_t to = START + MONTH;
+    uint32_t from = to - span;
+    HistoryTier tier = store.selectTier(from, step);
+    size_t points = 0;
+    for (auto _ : state)
+    {
+        points = 0;
+        store.query(tier, from, to, step, [&](const HistoryPoint &point) {
+            benchmark::DoNotOptimize(point);
+            points++;
+        });
+    }
+    state.SetLabel(HISTORY_TIER_NAMES[tier]);
+    state.counters["points_per_query"] = (double)points;
+}
+BENCHMARK(BM_HistoryQuery)
+    ->Args({3600, SAMPLE_INTERVAL})
+    ->Args({DAY, 60})
+    ->Args({7 * DAY, 3600})
+    ->Args({MONTH, 60})
+    ->Args({MONTH, 3600})
+    ->Unit(benchmark::kMicrosecond);
+
+/** The same day at 1-minute buckets, aggregated from raw samples: what the rollup tiers avoid */
+void BM_HistoryQueryDayFromRaw(benchmark::State &state)
+{
+    const HistoryStore &store = month();
+    uint32_t to = START + MONTH;
+    size_t points = 0;
+    for (auto _ : state)
+    {
+        points = 0;
+        store.query(HISTORY_RAW, to - DAY, to, 60, [&](const HistoryPoint &) { points++; });
+    }
+    state.counters["points_per_query"] = (double)points;
+}
+BENCHMARK(BM_HistoryQueryDayFromRaw)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,73 @@
+/**
+ * @file HubLinkBench.cpp
+ * @brief One telemetry sample over the link: HubLink frame vs the legacy ASCII line.
+ * Each iteration encodes a sample as the Nano does and decodes it as the ESP32 does.
+ * bytes_per_sample is what goes on the wire, airtime_us_per_sample its time at 9600 baud.
+ */
+
+#include <benchmark/benchmark.h>
+#include <HubLink.h>
+#include "TelemetryParser.h"
+
+#include <stdio.h>
+
+namespace
+{
+
+const double LINK_BAUD = 9600;
+const double BITS_PER_BYTE = 10; // 8N1
+
+void setWireCounters(benchmark::State &state, size_t bytes)
+{
+    state.counters["bytes_per_sample"] = (double)bytes;
+    state.counters["airtime_us_per_sample"] = bytes * BITS_PER_BYTE / LINK_BAUD * 1e6;
+    state.counters["samples_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+}
+
+void BM_HubLinkTelemetryRoundTrip(benchmark::State &state)
+{
+    HubLinkDecoder decoder;
+    uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+    size_t length = 0;
+    int16_t current = 400;
+    uint8_t seq = 0;
+    for (auto _ : state)
+    {
+        HubLinkFrame frame;
+        hubLinkMakeTelemetry(frame, seq++, current, 300, 600);
+        length = hubLinkEncode(frame, wire);
+
+        int16_t decoded = 0, min = 0, max = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            if (decoder.feed(wire[i]))
+                hubLinkReadTelemetry(decoder.frame(), decoded, min, max);
+        }
+        benchmark::DoNotOptimize(decoded);
+        current = current == 600 ? 400 : current + 1;
+    }
+    setWireCounters(state, length);
+}
+BENCHMARK(BM_HubLinkTelemetryRoundTrip);
+
+void BM_AsciiTelemetryRoundTrip(benchmark::State &state)
+{
+    TelemetryParser parser;
+    char line[64];
+    int length = 0;
+    int16_t current = 400;
+    for (auto _ : state)
+    {
+        // Serial.print(value, 1) of each reading, then println(",")
+        length = snprintf(line, sizeof(line), "[DHT11] Current = %.1f, Min = %.1f, Max = %.1f,\r\n", current / 10.0,
+                          30.0, 60.0);
+        for (int i = 0; i < length; i++)
+            parser.feed(line[i]);
+        benchmark::DoNotOptimize(parser.sample());
+        current = current == 600 ? 400 : current + 1;
+    }
+    setWireCounters(state, (size_t)length);
+}
+BENCHMARK(BM_AsciiTelemetryRoundTrip);
+
+} // namespace
@@ -0,0 +1,93 @@
+/**
+ * @file LcdFrameBufferBench.cpp
+ * @brief The Nano's sensor screen as drawSensorScreen() formats it, on the shim's HD44780,
+ * with a reading that changes every frame: through LcdFrameBuffer (compose, then send the
+ * changed cells) against the clear-and-reprint it replaced. bus_bytes_per_frame is the I2C
+ * traffic the shim's Wire model counted, and panel_us_per_frame what that and the clear
+ * command's ~2 ms busy wait cost on the Nano. The host times cover the CPU side only.
+ */
+
+#include <Arduino.h>
+#include <LiquidCrystal_I2C.h>
+#include <Wire.h>
+#include <benchmark/benchmark.h>
+#include "LcdFrameBuffer.h"
+#include "ShimClock.h"
+
+namespace
+{
+
+const uint8_t LCD_COLUMNS = 16; // Arduino_Nano.ino
+const uint8_t LCD_ROWS = 2;
+const double I2C_BYTE_MICROS = 9 * 1e6 / 100000; // 8 bits and ACK at Wire's default 100 kHz
+const double CLEAR_MICROS = 2000;                // LiquidCrystal_I2C::clear()'s wait
+
+/** A reading drifting by a tenth per frame, as between two DHT11 samples */
+float humidityAt(uint32_t frame) { return 40.0f + (frame % 200) / 10.0f; }
+
+/** drawSensorScreen()'s calls, on either the frame buffer or the panel itself */
+template <typename Target>
+void drawSensorScreen(Target &target, float current, float min, float max)
+{
+    target.setCursor(0, 0);
+    target.print("Humidity: ");
+    target.print(current, 1);
+    target.print("%");
+    target.setCursor(0, 1);
+    target.print("L:");
+    target.print(min, 0);
+    target.print("%  H:");
+    target.print(max, 0);
+    target.print("%");
+}
+
+/** Manual virtual time, so clear()'s wait is not slept on the host whichever bench ran first */
+void useVirtualTime()
+{
+    if (!shim::clock().manual())
+        shim::clock().useManual(shim::clock().micros());
+}
+
+void setFrameCounters(benchmark::State &state, uint32_t busBytesBefore, uint32_t clearsPerFrame)
+{
+    double busBytes = (double)(uint32_t)(Wire.shimBytes() - busBytesBefore) / state.iterations();
+    state.counters["frames_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+    state.counters["bus_bytes_per_frame"] = busBytes;
+    state.counters["panel_us_per_frame"] = busBytes * I2C_BYTE_MICROS + clearsPerFrame * CLEAR_MICROS;
+}
+
+void BM_LcdFrameBuffer(benchmark::State &state)
+{
+    useVirtualTime();
+    LiquidCrystal_I2C lcd(0x27, LCD_COLUMNS, LCD_ROWS);
+    lcd.init();
+    LcdFrameBuffer<LCD_COLUMNS, LCD_ROWS> screen(lcd);
+    uint32_t frame = 0;
+    uint32_t busBytesBefore = Wire.shimBytes();
+    for (auto _ : state)
+    {
+        screen.clear();
+        drawSensorScreen(screen, humidityAt(frame++), 30.0f, 60.0f);
+        screen.render();
+    }
+    setFrameCounters(state, busBytesBefore, 0);
+}
+BENCHMARK(BM_LcdFrameBuffer);
+
+void BM_LcdClearAndReprint(benchmark::State &state)
+{
+    useVirtualTime();
+    LiquidCrystal_I2C lcd(0x27, LCD_COLUMNS, LCD_ROWS);
+    lcd.init();
+    uint32_t frame = 0;
+    uint32_t busBytesBefore = Wire.shimBytes();
+    for (auto _ : state)
+    {
+        lcd.clear();
+        drawSensorScreen(lcd, humidityAt(frame++), 30.0f, 60.0f);
+    }
+    setFrameCounters(state, busBytesBefore, 1);
+}
+BENCHMARK(BM_LcdClearAndReprint);
+
+} // namespace
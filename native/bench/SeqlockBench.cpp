@@ -0,0 +1,137 @@
+/**
+ * @file SeqlockBench.cpp
+ * @brief Publishing UartIngest's IngestSnapshot: the Seqlock against a std::mutex around
+ * the same struct. With one thread the reader runs alone; with more, thread 0 is the
+ * writer (the ingest task) publishing back to back and the rest read (the web side).
+ * Reports reads and writes per second, reader retries, and how often the writer had to
+ * wait (mutex only; the seqlock writer never does). Any torn snapshot fails the run.
+ */
+
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+#include "UartIngest.h"
+
+#include <mutex>
+
+namespace
+{
+
+/** Every field carries the version, so a snapshot mixing two versions is detectable */
+IngestSnapshot snapshotOf(uint32_t version)
+{
+    IngestSnapshot snapshot;
+    snapshot.bytes = version;
+    snapshot.samples = version;
+    snapshot.ringDrops = version;
+    snapshot.uartOverflows = version;
+    snapshot.maxDepth = version;
+    snapshot.malformedLines = version;
+    snapshot.rejectedFrames = version;
+    snapshot.sequenceGaps = version;
+    snapshot.senderRestarts = version;
+    snapshot.faultDrops = version;
+    snapshot.faultFlips = version;
+    snapshot.latestMicros = version;
+    snapshot.latest = {(int16_t)version, (int16_t)version, (int16_t)version};
+    return snapshot;
+}
+
+bool consistent(const IngestSnapshot &s)
+{
+    uint32_t v = s.bytes;
+    return s.samples == v && s.ringDrops == v && s.uartOverflows == v && s.maxDepth == v && s.malformedLines == v &&
+           s.rejectedFrames == v && s.sequenceGaps == v && s.senderRestarts == v && s.faultDrops == v && s.faultFlips == v &&
+           s.latestMicros == v && s.latest.current == (int16_t)v && s.latest.min == (int16_t)v &&
+           s.latest.max == (int16_t)v;
+}
+
+class MutexSnapshot
+{
+public:
+    /** @return 1 if the lock was held by someone else, for the same stats as Seqlock::read() */
+    uint32_t write(const IngestSnapshot &value)
+    {
+        uint32_t waited = 0;
+        if (!_lock.try_lock())
+        {
+            _lock.lock();
+            waited = 1;
+        }
+        _value = value;
+        _lock.unlock();
+        return waited;
+    }
+
+    uint32_t read(IngestSnapshot &value)
+    {
+        uint32_t waited = 0;
+        if (!_lock.try_lock())
+        {
+            _lock.lock();
+            waited = 1;
+        }
+        value = _value;
+        _lock.unlock();
+        return waited;
+    }
+
+private:
+    std::mutex _lock;
+    IngestSnapshot _value;
+};
+
+class SeqlockSnapshot
+{
+public:
+    uint32_t write(const IngestSnapshot &value)
+    {
+        _lock.write(value);
+        return 0;
+    }
+
+    uint32_t read(IngestSnapshot &value) { return _lock.read(value); }
+
+private:
+    Seqlock<IngestSnapshot> _lock;
+};
+
+template <typename Shared> void contention(benchmark::State &state)
+{
+    static Shared shared;
+    bool writer = state.threads() > 1 && state.thread_index() == 0;
+    uint64_t operations = 0;
+    uint64_t retries = 0;
+    uint64_t torn = 0;
+    uint32_t version = 0;
+    IngestSnapshot snapshot;
+
+    for (auto _ : state)
+    {
+        if (writer)
+        {
+            retries += shared.write(snapshotOf(++version));
+        }
+        else
+        {
+            retries += shared.read(snapshot);
+            torn += !consistent(snapshot);
+            benchmark::DoNotOptimize(snapshot);
+        }
+        operations++;
+    }
+
+    if (torn > 0)
+        state.SkipWithError("torn snapshot read");
+    // Counters are summed over threads, so each thread reports under its role
+    const char *role = writer ? "writes" : "reads";
+    state.counters[std::string(role) + "_per_second"] = benchmark::Counter((double)operations, benchmark::Counter::kIsRate);
+    state.counters[std::string(writer ? "writer_waits" : "reader_retries")] = (double)retries;
+}
+
+void BM_SnapshotSeqlock(benchmark::State &state) { contention<SeqlockSnapshot>(state); }
+BENCHMARK(BM_SnapshotSeqlock)->ThreadRange(1, 4)->UseRealTime();
+
+void BM_SnapshotMutex(benchmark::State &state) { contention<MutexSnapshot>(state); }
+BENCHMARK(BM_SnapshotMutex)->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,53 @@
+/**
+ * @file SpscRingBench.cpp
+ * @brief The ingest ring between the UART task and loop(): one sample through it, and a
+ * burst that fills it the way a stalled loop() does. Single-threaded, so it measures the
+ * ring's own cost; SpscRingStressTest covers it under contention.
+ */
+
+#include <benchmark/benchmark.h>
+#include "UartIngest.h"
+
+namespace
+{
+
+typedef SpscRing<IngestedSample, UART_INGEST_RING> IngestRing;
+
+IngestedSample sampleAt(uint32_t i) { return IngestedSample{{(int16_t)(400 + i % 200), 300, 600}, i}; }
+
+void BM_SpscRingPushPop(benchmark::State &state)
+{
+    IngestRing ring;
+    IngestedSample item;
+    uint32_t i = 0;
+    for (auto _ : state)
+    {
+        ring.push(sampleAt(i++));
+        ring.pop(item);
+        benchmark::DoNotOptimize(item);
+    }
+    state.counters["samples_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SpscRingPushPop);
+
+void BM_SpscRingFillDrain(benchmark::State &state)
+{
+    IngestRing ring;
+    IngestedSample item;
+    uint32_t i = 0;
+    uint64_t rejected = 0;
+    for (auto _ : state)
+    {
+        // One sample more than fits: the last push is the ring-drop path
+        for (size_t n = 0; n <= IngestRing::capacity(); n++)
+            rejected += !ring.push(sampleAt(i++));
+        while (ring.pop(item))
+            benchmark::DoNotOptimize(item);
+    }
+    state.counters["samples_per_second"] = benchmark::Counter(
+        (double)state.iterations() * IngestRing::capacity(), benchmark::Counter::kIsRate);
+    state.counters["drops_per_fill"] = benchmark::Counter((double)rejected, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SpscRingFillDrain);
+
+} // namespace
@@ -0,0 +1,102 @@
+/**
+ * @file StatisticsBench.cpp
+ * @brief Per-sample update cost of the /api/stats estimators, alone and together as
+ * HumidityStats with ESP32.ino's 1 min / 1 h / 24 h windows.
+ */
+
+#include <benchmark/benchmark.h>
+#include "Statistics.h"
+
+#include <vector>
+
+namespace
+{
+
+// ESP32.ino
+const size_t STATS_WINDOW_SAMPLES[STATS_WINDOW_COUNT] = {30, 1800, 43200};
+
+const size_t TRACE_LENGTH = 4096;
+
+/** Whole-percent readings wandering around 45%, as tenths */
+const std::vector<int16_t> &trace()
+{
+    static std::vector<int16_t> values;
+    if (values.empty())
+    {
+        uint32_t state = 9;
+        int16_t value = 450;
+        for (size_t i = 0; i < TRACE_LENGTH; i++)
+        {
+            state = state * 1103515245u + 12345u;
+            if ((state >> 16) % 8 == 0)
+                value += (state >> 24) % 2 ? 10 : -10;
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+template <typename Add> void perSample(benchmark::State &state, Add add)
+{
+    const std::vector<int16_t> &values = trace();
+    size_t next = 0;
+    for (auto _ : state)
+        add(values[next++ % TRACE_LENGTH]);
+    state.counters["samples_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+}
+
+void BM_RollingWindow(benchmark::State &state)
+{
+    RollingWindow window;
+    window.begin(STATS_WINDOW_SAMPLES[STATS_WINDOW_COUNT - 1]);
+    perSample(state, [&](int16_t value) {
+        window.add(value);
+        benchmark::DoNotOptimize(window);
+    });
+}
+BENCHMARK(BM_RollingWindow);
+
+void BM_Welford(benchmark::State &state)
+{
+    Welford welford;
+    perSample(state, [&](int16_t value) {
+        welford.add(value);
+        benchmark::DoNotOptimize(welford);
+    });
+}
+BENCHMARK(BM_Welford);
+
+void BM_Ewma(benchmark::State &state)
+{
+    Ewma ewma(0.1f);
+    perSample(state, [&](int16_t value) {
+        ewma.add(value);
+        benchmark::DoNotOptimize(ewma);
+    });
+}
+BENCHMARK(BM_Ewma);
+
+void BM_P2Quantile(benchmark::State &state)
+{
+    P2Quantile p95(0.95f);
+    perSample(state, [&](int16_t value) {
+        p95.add(value);
+        benchmark::DoNotOptimize(p95);
+    });
+}
+BENCHMARK(BM_P2Quantile);
+
+/** What onTelemetrySample() pays per accepted sample */
+void BM_HumidityStats(benchmark::State &state)
+{
+    static HumidityStats stats;
+    if (stats.window(0).capacity() == 0)
+        stats.begin(STATS_WINDOW_SAMPLES);
+    perSample(state, [&](int16_t value) {
+        stats.add(value);
+        benchmark::DoNotOptimize(stats);
+    });
+}
+BENCHMARK(BM_HumidityStats);
+
+} // namespace
@@ -0,0 +1,98 @@
+/**
+ * @file TelemetryParserBench.cpp
+ * @brief Telemetry line parsing: the byte-fed TelemetryParser against the String-based
+ * parsing it replaced in ESP32.ino's loop(). Reports lines/s and heap allocations per line.
+ */
+
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+#include "AllocCounter.h"
+#include "TelemetryParser.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const size_t LINE_COUNT = 64;
+
+/** Lines as the Nano prints them, with a slowly changing reading */
+std::vector<std::string> telemetryLines()
+{
+    std::vector<std::string> lines;
+    for (size_t i = 0; i < LINE_COUNT; i++)
+    {
+        char line[64];
+        snprintf(line, sizeof(line), "[DHT11] Current = %u.%u, Min = 30.0, Max = 60.0,\r\n", 40 + (unsigned)(i % 20),
+                 (unsigned)(i % 10));
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+void setLineCounters(benchmark::State &state, uint64_t allocationsBefore)
+{
+    state.counters["lines_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+    state.counters["allocations_per_line"] = benchmark::Counter(
+        (double)(alloc_counter::allocations() - allocationsBefore), benchmark::Counter::kAvgIterations);
+}
+
+void BM_TelemetryParser(benchmark::State &state)
+{
+    std::vector<std::string> lines = telemetryLines();
+    TelemetryParser parser;
+    size_t next = 0;
+    uint64_t allocationsBefore = alloc_counter::allocations();
+    for (auto _ : state)
+    {
+        const std::string &line = lines[next++ % LINE_COUNT];
+        bool accepted = false;
+        for (char c : line)
+            accepted |= parser.feed(c);
+        benchmark::DoNotOptimize(accepted);
+        benchmark::DoNotOptimize(parser.sample());
+    }
+    setLineCounters(state, allocationsBefore);
+}
+BENCHMARK(BM_TelemetryParser);
+
+/** The loop() body before TelemetryParser: readStringUntil(), trim(), indexOf()/substring()/toFloat() */
+void BM_StringParsingBaseline(benchmark::State &state)
+{
+    std::vector<std::string> lines = telemetryLines();
+    size_t next = 0;
+    float currentHum = 0, minHum = 0, maxHum = 0;
+    uint64_t allocationsBefore = alloc_counter::allocations();
+    for (auto _ : state)
+    {
+        const std::string &line = lines[next++ % LINE_COUNT];
+        String incoming;
+        for (char c : line) // readStringUntil('\n') appends one char at a time
+        {
+            if (c == '\n')
+                break;
+            incoming += c;
+        }
+        incoming.trim();
+        if (incoming.startsWith("[DHT11]"))
+        {
+            int curIdx = incoming.indexOf("Current = ");
+            int minIdx = incoming.indexOf("Min = ");
+            int maxIdx = incoming.indexOf("Max = ");
+            if (curIdx != -1 && minIdx != -1 && maxIdx != -1)
+            {
+                currentHum = incoming.substring(curIdx + 10, incoming.indexOf(",", curIdx)).toFloat();
+                minHum = incoming.substring(minIdx + 6, incoming.indexOf(",", minIdx)).toFloat();
+                maxHum = incoming.substring(maxIdx + 6, incoming.indexOf(",", maxIdx)).toFloat();
+            }
+        }
+        benchmark::DoNotOptimize(currentHum);
+        benchmark::DoNotOptimize(minHum);
+        benchmark::DoNotOptimize(maxHum);
+    }
+    setLineCounters(state, allocationsBefore);
+}
+BENCHMARK(BM_StringParsingBaseline);
+
+} // namespace
@@ -0,0 +1,24 @@
+/**
+ * @file Fuzz.h
+ * @brief What every fuzz target shares: the libFuzzer entry point it defines, and
+ * FUZZ_CHECK() for the invariants it asserts beyond "no sanitizer report".
+ * A failed check aborts, so the driver (libFuzzer or FuzzDriver.cpp) saves the input.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Runs one input; called once per input by the driver. Always returns 0. */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+[[noreturn]] inline void fuzzCheckFailed(const char *condition, const char *file, int line)
+{
+    fprintf(stderr, "[FUZZ] %s:%d: check failed: %s\n", file, line, condition);
+    abort();
+}
+
+#define FUZZ_CHECK(condition) ((condition) ? (void)0 : fuzzCheckFailed(#condition, __FILE__, __LINE__))
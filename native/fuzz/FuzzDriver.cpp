@@ -0,0 +1,464 @@
+/**
+ * @file FuzzDriver.cpp
+ * @brief main() for a fuzz target when the compiler has no libFuzzer (GCC): replays the
+ * corpus, then runs mutations of it. Flags follow libFuzzer's where they overlap:
+ *
+ *     TelemetryIngestFuzz -runs=200000 -seed=1 -max_len=4096 -max_input_us=20000
+ *                         -malloc_limit_mb=1 -rss_limit_mb=128 corpus/TelemetryIngestFuzz
+ *
+ * There is no coverage feedback, so mutations stay close to the corpus: seed it with every
+ * kind of traffic the target parses. For each input the driver measures CPU time (the
+ * thread's own, so preemption on a busy host does not count) and the bytes it allocated,
+ * and prints the worst of each and the peak RSS at the end. It fails, saving the input
+ * under -artifact_prefix, on:
+ *   - a crash, a sanitizer report or a FUZZ_CHECK (crash-<hash>);
+ *   - an input taking more than -max_input_us of CPU time (slow-unit-<hash>);
+ *   - an input allocating more than -malloc_limit_mb in total (oom-<hash>);
+ *   - a peak RSS above -rss_limit_mb.
+ * Replay a saved input by passing its path in place of the corpus, with -runs=0.
+ */
+
+#include "Fuzz.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/common_interface_defs.h>
+// allocator_interface.h, which GCC does not ship
+extern "C" int __sanitizer_install_malloc_and_free_hooks(void (*mallocHook)(const volatile void *, size_t),
+                                                          void (*freeHook)(const volatile void *));
+#else
+#include "AllocCounter.h"
+#endif
+
+namespace
+{
+
+typedef std::vector<uint8_t> Input;
+
+struct Options
+{
+    uint64_t runs = 100000;
+    uint32_t seed = 1;
+    size_t maxLen = 4096;
+    uint64_t maxInputMicros = 0; // 0: not checked
+    uint64_t mallocLimitMb = 0;
+    uint64_t rssLimitMb = 0;
+    std::vector<std::string> paths;
+};
+
+struct Stats
+{
+    uint64_t inputs = 0;
+    uint64_t bytes = 0;
+    uint64_t cpuNanos = 0;
+    uint64_t slowestNanos = 0;
+    size_t slowestSize = 0;
+    uint64_t worstNanosPerByte = 0; // Over inputs of at least PER_BYTE_MIN_SIZE
+    size_t worstPerByteSize = 0;
+    uint64_t mostAllocated = 0;
+};
+
+// Shorter inputs are dominated by the call itself
+const size_t PER_BYTE_MIN_SIZE = 256;
+const uint64_t RSS_CHECK_EVERY = 1024;
+
+// Bytes the mutator likes to insert: the parsers' delimiters, signs and digit edges
+const uint8_t INTERESTING[] = {0x00, '\n', '\r', ' ', '-', '.', ',', ':', '=', '[', ']', '0', '9', 0x7F, 0x80, 0xFF};
+
+// For the crash handlers, which must not allocate
+char artifactPrefix[512] = "./";
+const uint8_t *currentData = nullptr;
+size_t currentSize = 0;
+
+// --- ALLOCATIONS ---
+
+#if defined(__SANITIZE_ADDRESS__)
+uint64_t hookedBytes = 0;
+
+void onMalloc(const volatile void *pointer, size_t size)
+{
+    (void)pointer;
+    hookedBytes += size;
+}
+
+void onFree(const volatile void *pointer) { (void)pointer; }
+
+void trackAllocations() { __sanitizer_install_malloc_and_free_hooks(onMalloc, onFree); }
+uint64_t bytesAllocated() { return hookedBytes; }
+} // namespace
+
+// ASan's default 256 MB quarantine fills with the driver's input copies and hides the
+// target's own RSS; one input's frees are all a use-after-free can come from here
+extern "C" const char *__asan_default_options() { return "quarantine_size_mb=16"; }
+
+namespace
+{
+#else
+void trackAllocations() {}
+uint64_t bytesAllocated() { return alloc_counter::bytesAllocated(); }
+#endif
+
+// --- ARTIFACTS ---
+
+uint64_t fnv1a(const uint8_t *data, size_t size)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ data[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+void writeString(int fd, const char *text) { (void)!write(fd, text, strlen(text)); }
+
+/** Saves data as <prefix><kind>-<hash>; only async-signal-safe calls, for the crash handlers */
+void saveArtifact(const char *kind, const uint8_t *data, size_t size)
+{
+    char path[sizeof(artifactPrefix) + 64];
+    size_t length = strlen(artifactPrefix);
+    memcpy(path, artifactPrefix, length);
+    memcpy(path + length, kind, strlen(kind));
+    length += strlen(kind);
+    path[length++] = '-';
+    uint64_t hash = fnv1a(data, size);
+    for (int shift = 60; shift >= 0; shift -= 4)
+        path[length++] = "0123456789abcdef"[(hash >> shift) & 0xF];
+    path[length] = '\0';
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return;
+    (void)!write(fd, data, size);
+    close(fd);
+    writeString(STDERR_FILENO, "[FUZZ] Input saved to ");
+    writeString(STDERR_FILENO, path);
+    writeString(STDERR_FILENO, "\n");
+}
+
+void onDeath()
+{
+    if (currentData)
+        saveArtifact("crash", currentData, currentSize);
+    currentData = nullptr;
+}
+
+void onSignal(int signal)
+{
+    onDeath();
+    ::signal(signal, SIG_DFL);
+    raise(signal);
+}
+
+void installCrashHandlers()
+{
+#if defined(__SANITIZE_ADDRESS__)
+    // The sanitizers handle the fault signals themselves and report before dying; abort() is ours
+    __sanitizer_set_death_callback(onDeath);
+    ::signal(SIGABRT, onSignal);
+#else
+    for (int signal : {SIGABRT, SIGSEGV, SIGBUS, SIGFPE, SIGILL})
+        ::signal(signal, onSignal);
+#endif
+}
+
+// --- CORPUS AND MUTATION ---
+
+bool loadFile(const std::string &path, std::vector<Input> &corpus, size_t maxLen)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    Input input;
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        input.insert(input.end(), buffer, buffer + n);
+    fclose(file);
+    if (input.size() > maxLen)
+        input.resize(maxLen);
+    corpus.push_back(input);
+    return true;
+}
+
+/** A file, or every file in a directory in name order, so a run is the same everywhere */
+bool loadPath(const std::string &path, std::vector<Input> &corpus, size_t maxLen)
+{
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0)
+        return false;
+    if (!S_ISDIR(info.st_mode))
+        return loadFile(path, corpus, maxLen);
+
+    DIR *dir = opendir(path.c_str());
+    if (!dir)
+        return false;
+    std::vector<std::string> names;
+    while (dirent *entry = readdir(dir))
+    {
+        if (entry->d_name[0] != '.')
+            names.push_back(entry->d_name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    for (const std::string &name : names)
+    {
+        if (!loadFile(path + "/" + name, corpus, maxLen))
+            return false;
+    }
+    return true;
+}
+
+Input mutate(const std::vector<Input> &corpus, std::mt19937 &rng, size_t maxLen)
+{
+    auto below = [&rng](size_t n) { return n ? (size_t)(rng() % n) : 0; };
+    auto interesting = [&below]() { return INTERESTING[below(sizeof(INTERESTING))]; };
+
+    Input input;
+    if (corpus.empty() || below(16) == 0)
+    {
+        input.resize(below(maxLen + 1));
+        for (uint8_t &byte : input)
+            byte = (uint8_t)rng();
+        return input;
+    }
+    input = corpus[below(corpus.size())];
+
+    size_t rounds = 1 + below(8);
+    for (size_t round = 0; round < rounds; round++)
+    {
+        size_t size = input.size();
+        switch (below(8))
+        {
+        case 0: // Flip a bit
+            if (size)
+                input[below(size)] ^= (uint8_t)(1 << below(8));
+            break;
+        case 1: // Overwrite a byte
+            if (size)
+                input[below(size)] = (uint8_t)rng();
+            break;
+        case 2: // Insert a delimiter, sign or digit
+            input.insert(input.begin() + below(size + 1), interesting());
+            break;
+        case 3: // Erase a few bytes
+            if (size)
+            {
+                size_t at = below(size);
+                input.erase(input.begin() + at, input.begin() + at + 1 + below(std::min<size_t>(size - at, 16)));
+            }
+            break;
+        case 4: // Repeat a chunk of the input
+            if (size)
+            {
+                size_t at = below(size);
+                Input chunk(input.begin() + at, input.begin() + at + 1 + below(std::min<size_t>(size - at, 64)));
+                input.insert(input.begin() + below(size + 1), chunk.begin(), chunk.end());
+            }
+            break;
+        case 5: // Splice in a chunk of another input
+        {
+            const Input &other = corpus[below(corpus.size())];
+            if (!other.empty())
+            {
+                size_t at = below(other.size());
+                input.insert(input.begin() + below(size + 1), other.begin() + at,
+                             other.begin() + at + 1 + below(other.size() - at));
+            }
+            break;
+        }
+        case 6: // A long run of one byte: over-long lines, fields and frames
+            input.insert(input.begin() + below(size + 1), 1 + below(512), below(2) ? interesting() : (uint8_t)rng());
+            break;
+        default: // Cut the input short
+            if (size)
+                input.resize(below(size));
+            break;
+        }
+    }
+    if (input.size() > maxLen)
+        input.resize(maxLen);
+    return input;
+}
+
+// --- RUNNING ---
+
+uint64_t threadCpuNanos()
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+uint64_t peakRssMb()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t)usage.ru_maxrss / 1024;
+}
+
+bool rssWithinLimit(const Options &options)
+{
+    uint64_t rss = peakRssMb();
+    if (!options.rssLimitMb || rss <= options.rssLimitMb)
+        return true;
+    fprintf(stderr, "[FUZZ] FAIL: peak RSS %llu MB, limit %llu MB\n", (unsigned long long)rss,
+            (unsigned long long)options.rssLimitMb);
+    return false;
+}
+
+/** @return false if the input broke a time or memory budget */
+bool runOne(const Input &input, const Options &options, Stats &stats)
+{
+    // An exactly sized heap copy, so ASan catches a read one past the end, as with libFuzzer
+    size_t size = input.size();
+    std::unique_ptr<uint8_t[]> data(new uint8_t[size ? size : 1]);
+    if (size)
+        memcpy(data.get(), input.data(), size);
+    currentData = data.get();
+    currentSize = size;
+
+    uint64_t allocatedBefore = bytesAllocated();
+    uint64_t start = threadCpuNanos();
+    LLVMFuzzerTestOneInput(data.get(), size);
+    uint64_t nanos = threadCpuNanos() - start;
+    uint64_t allocated = bytesAllocated() - allocatedBefore;
+
+    stats.inputs++;
+    stats.bytes += size;
+    stats.cpuNanos += nanos;
+    if (nanos > stats.slowestNanos)
+    {
+        stats.slowestNanos = nanos;
+        stats.slowestSize = size;
+    }
+    if (size >= PER_BYTE_MIN_SIZE && nanos / size > stats.worstNanosPerByte)
+    {
+        stats.worstNanosPerByte = nanos / size;
+        stats.worstPerByteSize = size;
+    }
+    stats.mostAllocated = std::max(stats.mostAllocated, allocated);
+
+    bool ok = true;
+    if (options.maxInputMicros && nanos / 1000 > options.maxInputMicros)
+    {
+        fprintf(stderr, "[FUZZ] FAIL: input of %zu bytes took %llu us of CPU, budget %llu us\n", size,
+                (unsigned long long)(nanos / 1000), (unsigned long long)options.maxInputMicros);
+        saveArtifact("slow-unit", data.get(), size);
+        ok = false;
+    }
+    if (options.mallocLimitMb && allocated > options.mallocLimitMb * 1024 * 1024)
+    {
+        fprintf(stderr, "[FUZZ] FAIL: input of %zu bytes allocated %llu bytes, limit %llu MB\n", size,
+                (unsigned long long)allocated, (unsigned long long)options.mallocLimitMb);
+        saveArtifact("oom", data.get(), size);
+        ok = false;
+    }
+    currentData = nullptr;
+    if (ok && stats.inputs % RSS_CHECK_EVERY == 0)
+        ok = rssWithinLimit(options);
+    return ok;
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *equals = strchr(arg, '=');
+        if (arg[0] != '-')
+        {
+            options.paths.push_back(arg);
+            continue;
+        }
+        if (!equals)
+            return false;
+        std::string name(arg + 1, equals);
+        const char *value = equals + 1;
+        if (name == "artifact_prefix")
+        {
+            if (strlen(value) >= sizeof(artifactPrefix))
+                return false;
+            strcpy(artifactPrefix, value);
+            continue;
+        }
+        uint64_t number = strtoull(value, nullptr, 10);
+        if (name == "runs")
+            options.runs = number;
+        else if (name == "seed")
+            options.seed = (uint32_t)number;
+        else if (name == "max_len")
+            options.maxLen = (size_t)number;
+        else if (name == "max_input_us")
+            options.maxInputMicros = number;
+        else if (name == "malloc_limit_mb")
+            options.mallocLimitMb = number;
+        else if (name == "rss_limit_mb")
+            options.rssLimitMb = number;
+        else
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: %s [-runs=N] [-seed=N] [-max_len=N] [-max_input_us=N] [-malloc_limit_mb=N] "
+                        "[-rss_limit_mb=N] [-artifact_prefix=DIR/] [CORPUS_DIR | INPUT]...\n", argv[0]);
+        return 2;
+    }
+    const char *name = strrchr(argv[0], '/');
+    name = name ? name + 1 : argv[0];
+
+    std::vector<Input> corpus;
+    for (const std::string &path : options.paths)
+    {
+        if (!loadPath(path, corpus, options.maxLen))
+        {
+            fprintf(stderr, "[FUZZ] Cannot read %s\n", path.c_str());
+            return 2;
+        }
+    }
+
+    installCrashHandlers();
+    trackAllocations();
+
+    Stats stats;
+    for (const Input &input : corpus)
+    {
+        if (!runOne(input, options, stats))
+            return 1;
+    }
+    std::mt19937 rng(options.seed);
+    for (uint64_t run = 0; run < options.runs; run++)
+    {
+        if (!runOne(mutate(corpus, rng, options.maxLen), options, stats))
+            return 1;
+    }
+
+    printf("[FUZZ] %s: %zu corpus + %llu mutated inputs, %llu bytes, %.2f s CPU\n", name, corpus.size(),
+           (unsigned long long)options.runs, (unsigned long long)stats.bytes, stats.cpuNanos / 1e9);
+    printf("[FUZZ] %s: slowest input %llu us (%zu bytes), worst %llu ns/byte (%zu bytes), "
+           "most allocated by one input %llu bytes, peak RSS %llu MB\n",
+           name, (unsigned long long)(stats.slowestNanos / 1000), stats.slowestSize,
+           (unsigned long long)stats.worstNanosPerByte, stats.worstPerByteSize,
+           (unsigned long long)stats.mostAllocated, (unsigned long long)peakRssMb());
+    return rssWithinLimit(options) ? 0 : 1;
+}
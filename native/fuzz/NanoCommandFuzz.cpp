@@ -0,0 +1,72 @@
+/**
+ * @file NanoCommandFuzz.cpp
+ * @brief The Nano's command path in Arduino_Nano.ino, built into this target so it runs
+ * under the sanitizers too: each input is fed to CommandReader and dispatchCommand() as
+ * ASCII (R:1, M:<text>) and to HubLinkDecoder and dispatchFrame() as binary frames, as
+ * taskCommands() does in either link mode. Beyond crashes, checks that:
+ *   - a command line is NUL-terminated within the buffer and its length is right;
+ *   - whatever was dispatched, both LCD rows hold only printable ASCII.
+ */
+
+#include "Fuzz.h"
+
+#include <string.h>
+#include <string>
+#include <Arduino.h>
+#include <HubLink.h>
+#include <LiquidCrystal_I2C.h>
+#include "CommandReader.h"
+
+// Arduino_Nano.ino
+extern LiquidCrystal_I2C lcd;
+void dispatchCommand(const char *cmd, uint8_t length);
+void dispatchFrame(const HubLinkFrame &frame);
+
+namespace
+{
+
+void checkLcd()
+{
+    for (uint8_t row = 0; row < 2; row++)
+    {
+        std::string text = lcd.shimRow(row);
+        for (char c : text)
+            FUZZ_CHECK(c >= ' ' && c <= '~');
+    }
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static bool booted = false;
+    if (!booted)
+    {
+        shim::clock().useManual(0);
+        setup();
+        booted = true;
+    }
+
+    CommandReader reader;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (reader.feed((char)data[i]))
+        {
+            FUZZ_CHECK(reader.length() < COMMAND_BUFFER_SIZE && strlen(reader.line()) == reader.length());
+            dispatchCommand(reader.line(), reader.length());
+            checkLcd();
+        }
+    }
+
+    HubLinkDecoder decoder;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (decoder.feed(data[i]))
+        {
+            FUZZ_CHECK(decoder.frame().length <= HUBLINK_MAX_PAYLOAD);
+            dispatchFrame(decoder.frame());
+            checkLcd();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file TelemetryIngestFuzz.cpp
+ * @brief The ESP32's receive path: every byte goes through TelemetryParser and
+ * HubLinkDecoder, and telemetry frames through HubLinkSequence, as UartIngest::consume()
+ * does. Beyond crashes, checks that:
+ *   - an accepted [DHT11] line is a possible reading (0-100 %, min <= current <= max);
+ *   - an accepted frame fits the payload and re-encodes to a frame that decodes the same;
+ *   - malformed lines and rejected frames never outnumber the lines and frames received.
+ */
+
+#include "Fuzz.h"
+
+#include <string.h>
+#include <HubLink.h>
+#include "TelemetryParser.h"
+
+namespace
+{
+
+bool sameFrame(const HubLinkFrame &a, const HubLinkFrame &b)
+{
+    return a.type == b.type && a.seq == b.seq && a.length == b.length && memcmp(a.payload, b.payload, a.length) == 0;
+}
+
+void checkRoundTrip(const HubLinkFrame &frame)
+{
+    uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+    size_t length = hubLinkEncode(frame, wire);
+    FUZZ_CHECK(length <= HUBLINK_MAX_WIRE_SIZE);
+
+    HubLinkDecoder decoder;
+    bool decoded = false;
+    for (size_t i = 0; i < length; i++)
+        decoded = decoder.feed(wire[i]) || decoded;
+    FUZZ_CHECK(decoded && sameFrame(decoder.frame(), frame));
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    TelemetryParser parser;
+    HubLinkDecoder decoder;
+    HubLinkSequence sequence;
+    uint32_t lineEnds = 0;
+    uint32_t delimiters = 0;
+    uint32_t tracked = 0;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        lineEnds += data[i] == '\n';
+        delimiters += data[i] == 0;
+
+        if (parser.feed((char)data[i]))
+        {
+            const TelemetrySample &sample = parser.sample();
+            FUZZ_CHECK(sample.min >= 0 && sample.max <= 1000);
+            FUZZ_CHECK(sample.min <= sample.current && sample.current <= sample.max);
+        }
+
+        if (decoder.feed(data[i]))
+        {
+            const HubLinkFrame &frame = decoder.frame();
+            FUZZ_CHECK(frame.length <= HUBLINK_MAX_PAYLOAD);
+            checkRoundTrip(frame);
+
+            TelemetrySample sample;
+            if (hubLinkReadTelemetry(frame, sample.current, sample.min, sample.max))
+            {
+                sequence.track(frame.seq);
+                tracked++;
+            }
+        }
+    }
+
+    // At most one per line, the unterminated last one included
+    FUZZ_CHECK(parser.malformedLines() <= lineEnds + 1);
+    FUZZ_CHECK(decoder.rejectedFrames() <= delimiters);
+    // A jump of 128 or more is a restart, so each frame adds at most 127 gaps
+    FUZZ_CHECK(sequence.gaps() <= 127 * tracked && sequence.restarts() <= tracked);
+    return 0;
+}
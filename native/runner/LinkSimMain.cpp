@@ -0,0 +1,83 @@
+/**
+ * @file LinkSimMain.cpp
+ * @brief main() for link_sim_native: one LinkSim.h run from the command line, e.g.
+ *
+ *     link_sim_native --seed 7 --seconds 86400 --flip-ppm 500 --hub-baud 9900
+ *
+ * Options (defaults in linksim::Config):
+ *   --seed N, --seconds N, --ascii
+ *   --nano-baud N, --hub-baud N                  a mismatch corrupts bits at the receiver
+ *   --drop-ppm N, --flip-ppm N, --burst-ppm N, --burst-length N     line noise, both ways
+ *   --loop-stall-ms N, --loop-stall-every N      loop() blocked N ms every N s
+ *   --ingest-stall-ms N, --ingest-stall-every N  ingest task not reading N ms every N s
+ *   --command-every-ms N, --restart-every N
+ * Prints the [LINKSIM] report; exits 1 if a sample or command was accepted corrupted.
+ */
+
+#include "LinkSim.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+int main(int argc, char **argv)
+{
+    linksim::Config config;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--ascii")
+        {
+            config.format = linksim::Format::Ascii;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return 2;
+        }
+        uint32_t value = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        if (arg == "--seed")
+            config.seed = value;
+        else if (arg == "--seconds")
+            config.seconds = value;
+        else if (arg == "--nano-baud")
+            config.nanoBaud = value;
+        else if (arg == "--hub-baud")
+            config.hubBaud = value;
+        else if (arg == "--drop-ppm")
+            config.faults.dropPpm = value;
+        else if (arg == "--flip-ppm")
+            config.faults.flipPpm = value;
+        else if (arg == "--burst-ppm")
+            config.faults.burstPpm = value;
+        else if (arg == "--burst-length")
+            config.faults.burstLength = (uint16_t)value;
+        else if (arg == "--loop-stall-ms")
+            config.loopStallMs = value;
+        else if (arg == "--loop-stall-every")
+            config.loopStallEverySeconds = value;
+        else if (arg == "--ingest-stall-ms")
+            config.ingestStallMs = value;
+        else if (arg == "--ingest-stall-every")
+            config.ingestStallEverySeconds = value;
+        else if (arg == "--command-every-ms")
+            config.commandEveryMs = value;
+        else if (arg == "--restart-every")
+            config.nanoRestartEverySeconds = value;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return 2;
+        }
+    }
+    if (!config.nanoBaud || !config.hubBaud)
+    {
+        fprintf(stderr, "Baud rates must be non-zero\n");
+        return 2;
+    }
+
+    linksim::Report report = linksim::run(config);
+    linksim::print(config, report, stdout);
+    return report.samplesCorrupted || report.commandsCorrupted ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file ShimMain.cpp
+ * @brief main() for a sketch built against the host shim (nano_native / esp32_native).
+ *
+ * Runs setup() once and then loop() forever, on the real-time virtual clock. The serial
+ * link between the boards goes through file descriptors, so the two programs can be wired
+ * together with a pair of FIFOs:
+ *
+ *     mkfifo /tmp/to_hub /tmp/to_nano
+ *     nano_native  --link-in /tmp/to_nano --link-out /tmp/to_hub &
+ *     esp32_native --link-in /tmp/to_hub  --link-out /tmp/to_nano --port-offset 8000
+ *
+ * The Nano's link is its Serial (stdin/stdout when no --link-* is given). The hub's link
+ * is UART2 and its Serial monitor goes to stdout. Options:
+ *   --link-in PATH, --link-out PATH   serial link input / output (FIFO, pty or file)
+ *   --clock-scale X                   virtual seconds per real second (default 1)
+ *   --port-offset N                   hub: added to the HTTP and WebSocket ports (default 8000)
+ *   --fs DIR                          hub: host directory behind LittleFS (default ./littlefs)
+ *   --humidity N, --temperature N     Nano: what the simulated DHT11 reports
+ */
+
+#include <Arduino.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+
+#if defined(ARDUINO_ARCH_AVR)
+#include "ShimDht11.h"
+const uint8_t SHIM_DHT_PIN = 4; // PIN_DHT in Arduino_Nano.ino
+#elif defined(ARDUINO_ARCH_ESP32)
+#include <LittleFS.h>
+#include <WebServer.h>
+#include <driver/uart.h>
+#endif
+
+const useconds_t SHIM_LOOP_IDLE_US = 200; // Host sleep between loop() passes, so an idle sketch does not spin a core
+
+static int openLink(const char *path, int flags)
+{
+    // O_RDWR keeps a FIFO open without waiting for the other end to appear
+    int fd = open(path, flags == O_RDONLY ? O_RDWR : flags);
+    if (fd < 0)
+    {
+        perror(path);
+        exit(2);
+    }
+    return fd;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [--link-in PATH] [--link-out PATH] [--clock-scale X] [--port-offset N] [--fs DIR]\n"
+            "          [--humidity N] [--temperature N]\n",
+            program);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    int linkIn = -1;
+    int linkOut = -1;
+    double scale = 1.0;
+    int humidity = -1;
+    int temperature = -1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if (i + 1 >= argc)
+            usage(argv[0]);
+        const char *value = argv[++i];
+        if (option == "--link-in")
+            linkIn = openLink(value, O_RDONLY);
+        else if (option == "--link-out")
+            linkOut = openLink(value, O_RDWR);
+        else if (option == "--clock-scale")
+            scale = atof(value);
+#if defined(ARDUINO_ARCH_ESP32)
+        else if (option == "--port-offset")
+            WebServer::shimPortOffset = (uint16_t)atoi(value);
+        else if (option == "--fs")
+            LittleFS.shimSetRoot(value);
+#endif
+        else if (option == "--humidity")
+            humidity = atoi(value);
+        else if (option == "--temperature")
+            temperature = atoi(value);
+        else
+            usage(argv[0]);
+    }
+
+    shim::clock().useRealTime(scale);
+
+#if defined(ARDUINO_ARCH_AVR)
+    shim::dht11().attach(SHIM_DHT_PIN);
+    if (humidity >= 0 || temperature >= 0)
+        shim::dht11().set(humidity >= 0 ? humidity : 45, temperature >= 0 ? temperature : 22);
+    Serial.shimAttach(linkIn >= 0 ? linkIn : STDIN_FILENO, linkOut >= 0 ? linkOut : STDOUT_FILENO);
+#else
+    (void)humidity;
+    (void)temperature;
+    Serial.shimAttach(-1, STDOUT_FILENO);
+    shim::uartAttach(UART_NUM_2, linkIn, linkOut);
+#endif
+
+    setup();
+    for (;;)
+    {
+        loop();
+        usleep(SHIM_LOOP_IDLE_US);
+    }
+}
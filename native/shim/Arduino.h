@@ -0,0 +1,63 @@
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the Arduino core, for building the sketches as Linux programs.
+ *
+ * Compile with ARDUINO_ARCH_AVR for the Nano sketch or ARDUINO_ARCH_ESP32 for the hub;
+ * each pulls in the matching board layer (ShimAvr.h / ShimEsp32.h). Time comes from
+ * shim::clock() (ShimClock.h), so tests can run a sketch on a virtual clock.
+ * Unlike on the boards, unsigned long is 64 bits wide here; millis() and micros() still
+ * wrap at 32 bits like the cores'.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HardwareSerial.h"
+#include "Print.h"
+#include "ShimClock.h"
+#include "WString.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define PROGMEM
+#define F(text) (text)
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+
+inline unsigned long micros() { return (uint32_t)shim::clock().micros(); }
+inline unsigned long millis() { return (uint32_t)(shim::clock().micros() / 1000); }
+inline void delay(unsigned long ms) { shim::clock().sleep((uint64_t)ms * 1000); }
+inline void delayMicroseconds(unsigned int us) { shim::clock().sleep(us); }
+inline void yield() {}
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+#if defined(ARDUINO_ARCH_AVR)
+#include "ShimAvr.h"
+#elif defined(ARDUINO_ARCH_ESP32)
+#include "ShimEsp32.h"
+#endif
+
+// Sketch entry points, called by the host runner (ShimMain.cpp) or by a test
+void setup();
+void loop();
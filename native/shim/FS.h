@@ -0,0 +1,107 @@
+/**
+ * @file FS.h
+ * @brief The ESP32 core's fs::FS / fs::File over a directory of the host filesystem.
+ *
+ * Paths are the sketch's absolute paths ("/log/00000001.seg") below the root given to
+ * the mounted filesystem (LittleFS.h). Directories list in name order, like LittleFS.
+ * flush() is an fsync(), so a test can count the syncs as well as the bytes that reach
+ * the "flash" through the FS's shim counters.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include "HardwareSerial.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+
+class FS;
+
+class File : public Stream
+{
+public:
+    File() {}
+
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+    size_t write(const uint8_t *data, size_t length) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t read(uint8_t *buffer, size_t length);
+    void flush() override;
+    bool seek(uint32_t position);
+    size_t position() const;
+    size_t size() const;
+    void close() { _impl.reset(); }
+    operator bool() const { return _impl != nullptr; }
+
+    /** File name without its directory, as newer cores report it */
+    const char *name() const;
+    const char *path() const;
+    bool isDirectory() const;
+    File openNextFile(const char *mode = FILE_READ);
+
+private:
+    friend class FS;
+    struct Impl;
+    std::shared_ptr<Impl> _impl;
+};
+
+class FS
+{
+public:
+    File open(const char *path, const char *mode = FILE_READ, bool create = false);
+    File open(const String &path, const char *mode = FILE_READ, bool create = false)
+    {
+        return open(path.c_str(), mode, create);
+    }
+    bool exists(const char *path);
+    bool exists(const String &path) { return exists(path.c_str()); }
+    bool remove(const char *path);
+    bool remove(const String &path) { return remove(path.c_str()); }
+    bool rename(const char *from, const char *to);
+    bool mkdir(const char *path);
+    bool mkdir(const String &path) { return mkdir(path.c_str()); }
+    bool rmdir(const char *path);
+
+    // --- Host control ---
+
+    /** Host directory the filesystem lives in; set before the sketch mounts it */
+    void shimSetRoot(const std::string &root) { _root = root; }
+    const std::string &shimRoot() const { return _root; }
+    bool shimMounted() const { return _mounted; }
+
+    // Traffic since mount, to measure write amplification
+    uint64_t shimBytesWritten() const { return _bytesWritten; }
+    uint32_t shimWrites() const { return _writes; }
+    uint32_t shimSyncs() const { return _syncs; }
+    uint64_t shimBytesRead() const { return _bytesRead; }
+    void shimResetCounters() { _bytesWritten = _bytesRead = _writes = _syncs = 0; }
+
+protected:
+    std::string hostPath(const char *path) const;
+
+    std::string _root = "littlefs";
+    bool _mounted = false;
+
+private:
+    friend class File;
+    uint64_t _bytesWritten = 0;
+    uint64_t _bytesRead = 0;
+    uint32_t _writes = 0;
+    uint32_t _syncs = 0;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
@@ -0,0 +1,102 @@
+/**
+ * @file HardwareSerial.h
+ * @brief Stream and HardwareSerial backed by host file descriptors or in-memory buffers.
+ *
+ * Received bytes come from shimReceive() (tests) or from a reader thread on an attached
+ * file descriptor (a pipe, FIFO or pty, so two sketch processes can be wired together).
+ * Bytes from a descriptor, or from shimLineReceive(), arrive one character time apart at
+ * the begin() baud rate (10 bits per byte, on the virtual clock) rather than all at once.
+ * Transmitted bytes go to the attached descriptor, and are also kept for shimTakeOutput()
+ * when capture is on. Like the board's 64-byte RX buffer, input beyond the configured
+ * capacity is lost and counted.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <mutex>
+#include <string>
+#include "Print.h"
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    size_t readBytes(uint8_t *buffer, size_t length);
+    size_t readBytes(char *buffer, size_t length) { return readBytes((uint8_t *)buffer, length); }
+    String readStringUntil(char terminator);
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+
+protected:
+    unsigned long _timeout = 1000;
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    explicit HardwareSerial(size_t rxCapacity) : _rxCapacity(rxCapacity) {}
+
+    void begin(unsigned long baud) { _baud = baud; }
+    void begin(unsigned long baud, uint32_t config, int8_t rxPin = -1, int8_t txPin = -1)
+    {
+        (void)config;
+        (void)rxPin;
+        (void)txPin;
+        begin(baud);
+    }
+    void end() {}
+    operator bool() const { return true; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    int availableForWrite() override { return 64; }
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+    size_t write(const uint8_t *data, size_t length) override;
+    using Print::write;
+
+    // --- Host control ---
+
+    /** Reads input from inFd on a thread and writes output to outFd; -1 leaves a side unattached */
+    void shimAttach(int inFd, int outFd);
+
+    /** Queues bytes as if they had arrived on the line */
+    void shimReceive(const uint8_t *data, size_t length);
+    void shimReceive(const std::string &data) { shimReceive((const uint8_t *)data.data(), data.size()); }
+
+    /** Queues bytes on the line; they reach the RX buffer at the baud rate */
+    void shimLineReceive(const uint8_t *data, size_t length);
+
+    /** Keeps transmitted bytes for shimTakeOutput() */
+    void shimCapture(bool on) { _capture = on; }
+    std::string shimTakeOutput();
+
+    size_t shimRxCapacity() const { return _rxCapacity; }
+    uint32_t shimRxOverflows() const { return _rxOverflows; }
+    unsigned long shimBaud() const { return _baud; }
+
+private:
+    void pump();
+    void push(uint8_t c);
+
+    std::mutex _mutex;
+    std::deque<uint8_t> _line; // Sent but still on the wire
+    uint64_t _lineTime = 0;    // When the first byte of _line has been fully received
+    std::deque<uint8_t> _rx;
+    size_t _rxCapacity;
+    uint32_t _rxOverflows = 0;
+    std::string _captured;
+    bool _capture = false;
+    int _outFd = -1;
+    unsigned long _baud = 0;
+};
+
+extern HardwareSerial Serial;
+#ifdef ARDUINO_ARCH_ESP32
+extern HardwareSerial Serial2;
+#endif
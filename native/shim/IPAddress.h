@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+#include "Print.h"
+
+class IPAddress : public Printable
+{
+public:
+    IPAddress() : IPAddress(0, 0, 0, 0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _octets{a, b, c, d} {}
+
+    uint8_t operator[](int index) const { return _octets[index & 3]; }
+    String toString() const
+    {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", _octets[0], _octets[1], _octets[2], _octets[3]);
+        return String(text);
+    }
+    size_t printTo(Print &out) const override { return out.print(toString()); }
+
+private:
+    uint8_t _octets[4];
+};
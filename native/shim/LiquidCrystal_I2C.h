@@ -0,0 +1,56 @@
+/**
+ * @file LiquidCrystal_I2C.h
+ * @brief HD44780 behind a PCF8574 expander, as driven by the LiquidCrystal_I2C library.
+ *
+ * Every command or character goes over Wire the way the library sends it (two nibbles,
+ * three expander writes each), so Wire's counters show the real bus traffic. The
+ * controller's DDRAM is modelled, including the address auto-increment and the jump
+ * between lines, and shimRow() returns what a row of the panel shows.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include "Print.h"
+
+class LiquidCrystal_I2C : public Print
+{
+public:
+    LiquidCrystal_I2C(uint8_t address, uint8_t columns, uint8_t rows);
+
+    void init();
+    void begin() { init(); }
+    void clear();
+    void home();
+    void setCursor(uint8_t col, uint8_t row);
+    void backlight();
+    void noBacklight();
+    void display() { command(0x0C); }
+    void noDisplay() { command(0x08); }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    // --- Host control ---
+    std::string shimRow(uint8_t row) const;
+    uint32_t shimCharacters() const { return _characters; }
+    uint32_t shimCommands() const { return _commands; }
+    bool shimBacklight() const { return _backlight; }
+
+private:
+    static const uint8_t DDRAM_SIZE = 0x68;
+
+    void command(uint8_t value);
+    void send(uint8_t value, uint8_t mode);
+    void expanderWrite(uint8_t value);
+
+    uint8_t _address;
+    uint8_t _columns;
+    uint8_t _rows;
+    bool _backlight = false;
+    char _ddram[DDRAM_SIZE];
+    uint8_t _cursor = 0;
+    uint32_t _characters = 0;
+    uint32_t _commands = 0;
+};
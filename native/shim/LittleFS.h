@@ -0,0 +1,28 @@
+/**
+ * @file LittleFS.h
+ * @brief LittleFS mount on the host: a directory, by default ./littlefs, created on begin().
+ * Contents persist between runs like the board's flash partition; point a test at a fresh
+ * directory with shimSetRoot() to start from an empty one.
+ */
+
+#pragma once
+
+#include "FS.h"
+
+namespace fs
+{
+
+class LittleFSFS : public FS
+{
+public:
+    bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char *partitionLabel = "spiffs");
+    bool format();
+    void end() { _mounted = false; }
+    size_t totalBytes() { return 1536 * 1024; } // The default 1.5 MB data partition
+    size_t usedBytes();
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
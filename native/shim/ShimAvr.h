@@ -0,0 +1,51 @@
+/**
+ * @file ShimAvr.h
+ * @brief ATmega328P registers and pin mapping the Nano sketch touches directly.
+ *
+ * PINB/PINC/PIND mirror the simulated pin levels (ShimPins.h), and a level change on a
+ * pin whose PCICR group and PCMSK bit are set calls that group's ISR(), as the hardware
+ * would. The stack pointer reads as the heap start, so LoopProfiler's stack painting and
+ * SRAM figures come out empty on the host; the simavr build measures them for real.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Port numbers as in the AVR core's pins_arduino.h
+#define PB 2
+#define PC 3
+#define PD 4
+
+extern volatile uint8_t PINB;
+extern volatile uint8_t PINC;
+extern volatile uint8_t PIND;
+extern volatile uint8_t PCICR;
+extern volatile uint8_t PCMSK0;
+extern volatile uint8_t PCMSK1;
+extern volatile uint8_t PCMSK2;
+extern volatile uint8_t GPIOR0;
+
+#define _BV(bit) (1 << (bit))
+
+// Nano: D0-D7 are port D (PCINT16-23), D8-D13 port B (PCINT0-5), A0-A5 port C (PCINT8-13)
+#define digitalPinToPort(p) ((p) <= 7 ? PD : ((p) <= 13 ? PB : PC))
+#define digitalPinToBitMask(p) ((uint8_t)_BV((p) <= 7 ? (p) : ((p) <= 13 ? (p) - 8 : (p) - 14)))
+#define portInputRegister(port) ((port) == PB ? &PINB : ((port) == PC ? &PINC : &PIND))
+#define digitalPinToPCICR(p) (&PCICR)
+#define digitalPinToPCICRbit(p) ((p) <= 7 ? 2 : ((p) <= 13 ? 0 : 1))
+#define digitalPinToPCMSK(p) ((p) <= 7 ? &PCMSK2 : ((p) <= 13 ? &PCMSK0 : &PCMSK1))
+#define digitalPinToPCMSKbit(p) ((p) <= 7 ? (p) : ((p) <= 13 ? (p) - 8 : (p) - 14))
+
+#define PCINT0_vect shim_avr_pcint0_vect
+#define PCINT1_vect shim_avr_pcint1_vect
+#define PCINT2_vect shim_avr_pcint2_vect
+#define ISR(vector, ...) extern "C" void vector(void)
+
+extern "C" void shim_avr_pcint0_vect(void) __attribute__((weak));
+extern "C" void shim_avr_pcint1_vect(void) __attribute__((weak));
+extern "C" void shim_avr_pcint2_vect(void) __attribute__((weak));
+
+extern uint8_t __heap_start;
+extern void *__brkval;
+#define SP ((uintptr_t)&__heap_start)
@@ -0,0 +1,71 @@
+/**
+ * @file ShimClock.h
+ * @brief Virtual time behind millis(), micros() and delay() on the host.
+ *
+ * Two modes:
+ *   - real time (default): time follows the host's monotonic clock, optionally sped up
+ *     by a scale factor, so a sketch process runs like the board would;
+ *   - manual: time only moves when a test calls advance() or the sketch calls delay(),
+ *     so a test controls exactly when each scheduler task falls due.
+ * Simulated peripherals (DHT11 line, WiFi driver events) schedule events at virtual
+ * times with at(). An event runs the first time anyone reads the clock at or past its
+ * due time, and micros() reads as the event's own due time while it runs, so an ISR
+ * fired from an event timestamps its edge exactly.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace shim
+{
+
+class Clock
+{
+public:
+    typedef std::function<void()> Event;
+
+    /** Switches to manual time, starting at start microseconds; pending events are dropped */
+    void useManual(uint64_t start = 0);
+
+    /** Switches to the host's monotonic clock, scale virtual seconds per real second */
+    void useRealTime(double scale = 1.0);
+
+    bool manual() const { return _manual; }
+
+    /** Current virtual time in microseconds; runs every event due by then */
+    uint64_t micros();
+
+    /** Manual mode: moves time forward by us, running due events in order */
+    void advance(uint64_t us);
+
+    /** delay(): advances in manual mode, sleeps (scaled) in real-time mode */
+    void sleep(uint64_t us);
+
+    /** Runs event at virtual time when (microseconds), or on the next read if already due */
+    void at(uint64_t when, Event event);
+
+    /** Events not run yet */
+    size_t pending();
+
+private:
+    uint64_t elapsed() const;
+    void runDue(uint64_t until);
+
+    std::recursive_mutex _mutex;
+    bool _manual = false;
+    double _scale = 1.0;
+    uint64_t _now = 0;                // Manual mode: the time; real-time mode: time at _origin
+    std::chrono::steady_clock::time_point _origin = std::chrono::steady_clock::now();
+    std::multimap<uint64_t, Event> _events;
+    bool _dispatching = false;
+    uint64_t _dispatchTime = 0;
+};
+
+Clock &clock();
+
+} // namespace shim
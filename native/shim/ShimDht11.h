@@ -0,0 +1,65 @@
+/**
+ * @file ShimDht11.h
+ * @brief DHT11 on a simulated pin, answering start signals on the virtual clock.
+ *
+ * When the sketch has held the line low for at least 18 ms and releases it, the model
+ * schedules the datasheet response: 80 us low, 80 us high, then 40 bits of a 50 us low
+ * and a 26 us (0) or 70 us (1) high, and a final 50 us low. Every phase can be jittered
+ * by a seedable amount, and the sensor can be unplugged or made to send a bad checksum.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace shim
+{
+
+class Dht11
+{
+public:
+    /** Connects the sensor to pin; call once, before the sketch's setup() */
+    void attach(uint8_t pin);
+
+    void set(uint8_t humidity, uint8_t temperature)
+    {
+        _humidity = humidity;
+        _temperature = temperature;
+    }
+
+    /** An absent sensor never answers, so the sketch sees a timeout */
+    void setPresent(bool present) { _present = present; }
+
+    /** Flips the checksum byte of every response while on */
+    void setBadChecksum(bool bad) { _badChecksum = bad; }
+
+    /** Each phase lasts its nominal time +/- up to us microseconds, drawn from seed */
+    void setJitter(uint16_t us, uint32_t seed)
+    {
+        _jitter = us;
+        _rng = seed ? seed : 1;
+    }
+
+    /** Responses started since attach() */
+    uint32_t responses() const { return _responses; }
+
+private:
+    void onSketchChange();
+    void respond(uint64_t start);
+    uint64_t phase(uint64_t at, uint16_t nominal);
+
+    uint8_t _pin = 0xFF;
+    bool _heldLow = false;
+    uint64_t _lowSince = 0;
+    uint8_t _humidity = 45;
+    uint8_t _temperature = 22;
+    bool _present = true;
+    bool _badChecksum = false;
+    uint16_t _jitter = 0;
+    uint32_t _rng = 1;
+    uint32_t _responses = 0;
+};
+
+Dht11 &dht11();
+
+} // namespace shim
@@ -0,0 +1,44 @@
+/**
+ * @file ShimEsp32.h
+ * @brief ESP32 core extras: the ESP object, CPU frequency, hardware RNG and SNTP setup.
+ * The cycle counter runs at a nominal 240 MHz of virtual time; free heap is the host
+ * allocator's view (mallinfo2), so it moves with real allocations.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#define SERIAL_8N1 0x800001c
+
+const uint32_t SHIM_CPU_MHZ = 240;
+
+class EspClass
+{
+public:
+    uint32_t getCycleCount();
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getPsramSize() { return 4 * 1024 * 1024; }
+    void restart();
+};
+
+extern EspClass ESP;
+
+inline uint32_t getCpuFrequencyMhz() { return SHIM_CPU_MHZ; }
+
+uint32_t esp_random();
+
+/** Host time is already wall-clock time, so SNTP has nothing to do */
+inline void configTime(long gmtOffset, int daylightOffset, const char *server1, const char *server2 = nullptr,
+                       const char *server3 = nullptr)
+{
+    (void)gmtOffset;
+    (void)daylightOffset;
+    (void)server1;
+    (void)server2;
+    (void)server3;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file ShimPins.h
+ * @brief Digital pin levels shared between the sketch and simulated devices.
+ * The sketch sets modes and output latches through pinMode()/digitalWrite(); a device
+ * such as the DHT11 model drives or releases the line from its side. A released input
+ * with INPUT_PULLUP reads HIGH, like the open-drain DHT11 line with its pull-up.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+namespace shim
+{
+
+const uint8_t PIN_COUNT = 40;
+
+class Pins
+{
+public:
+    typedef std::function<void(uint8_t pin)> Listener;
+
+    // Sketch side
+    void setMode(uint8_t pin, uint8_t mode);
+    void setLatch(uint8_t pin, uint8_t value);
+
+    // Device side
+    void drive(uint8_t pin, uint8_t level);
+    void release(uint8_t pin);
+
+    uint8_t level(uint8_t pin) const { return pin < PIN_COUNT ? _pins[pin].level : 0; }
+    uint8_t mode(uint8_t pin) const { return pin < PIN_COUNT ? _pins[pin].mode : 0; }
+
+    /** The sketch changed a pin's mode or output latch */
+    void onSketchChange(Listener listener) { _sketchListeners.push_back(listener); }
+
+    /** A pin's level changed, from either side */
+    void onLevelChange(Listener listener) { _levelListeners.push_back(listener); }
+
+private:
+    struct Pin
+    {
+        uint8_t mode = 0;
+        uint8_t latch = 0;
+        bool driven = false;
+        uint8_t drivenLevel = 0;
+        uint8_t level = 0;
+    };
+
+    void update(uint8_t pin);
+
+    Pin _pins[PIN_COUNT];
+    std::vector<Listener> _sketchListeners;
+    std::vector<Listener> _levelListeners;
+};
+
+Pins &pins();
+
+} // namespace shim
@@ -0,0 +1,95 @@
+/**
+ * @file WString.h
+ * @brief Arduino String on top of std::string, with the subset of the API the sketches use.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string>
+
+class String
+{
+public:
+    String(const char *text = "") : _text(text ? text : "") {}
+    String(const char *text, size_t length) : _text(text, length) {}
+    explicit String(char c) : _text(1, c) {}
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(double value, unsigned int decimals = 2);
+
+    const char *c_str() const { return _text.c_str(); }
+    unsigned int length() const { return (unsigned int)_text.size(); }
+    bool isEmpty() const { return _text.empty(); }
+    bool reserve(unsigned int size)
+    {
+        _text.reserve(size);
+        return true;
+    }
+
+    char charAt(unsigned int index) const { return index < _text.size() ? _text[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    String &operator+=(const String &other) { return concat(other); }
+    String &operator+=(const char *text) { return concat(text); }
+    String &operator+=(char c) { return concat(c); }
+    String &concat(const String &other)
+    {
+        _text += other._text;
+        return *this;
+    }
+    String &concat(const char *text)
+    {
+        _text += text ? text : "";
+        return *this;
+    }
+    String &concat(char c)
+    {
+        _text += c;
+        return *this;
+    }
+
+    bool equals(const String &other) const { return _text == other._text; }
+    bool equals(const char *text) const { return _text == (text ? text : ""); }
+    bool operator==(const String &other) const { return equals(other); }
+    bool operator==(const char *text) const { return equals(text); }
+    bool operator!=(const String &other) const { return !equals(other); }
+    bool operator!=(const char *text) const { return !equals(text); }
+
+    bool startsWith(const String &prefix) const { return _text.compare(0, prefix._text.size(), prefix._text) == 0; }
+    bool endsWith(const String &suffix) const
+    {
+        return _text.size() >= suffix._text.size() &&
+               _text.compare(_text.size() - suffix._text.size(), suffix._text.size(), suffix._text) == 0;
+    }
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String &text, unsigned int from = 0) const;
+    String substring(unsigned int begin) const { return substring(begin, length()); }
+    String substring(unsigned int begin, unsigned int end) const;
+
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const;
+    float toFloat() const;
+
+private:
+    std::string _text;
+};
+
+inline String operator+(const String &a, const String &b)
+{
+    String result(a);
+    return result += b;
+}
+
+inline String operator+(const String &a, const char *b)
+{
+    String result(a);
+    return result += b;
+}
+
+inline bool operator==(const char *a, const String &b) { return b == a; }
+inline bool operator!=(const char *a, const String &b) { return b != a; }
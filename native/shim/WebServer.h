@@ -0,0 +1,118 @@
+/**
+ * @file WebServer.h
+ * @brief The ESP32 core's synchronous WebServer on a host TCP socket.
+ *
+ * handleClient() runs the core's per-client states: accept one connection, read its
+ * request, run the matching handler, then hold the connection until the browser closes
+ * it or HTTP_MAX_CLOSE_WAIT (2 s) passes. Nothing else is accepted meanwhile, as on the
+ * board. Responses carry Connection: close, and CONTENT_LENGTH_UNKNOWN switches to
+ * chunked transfer encoding. client() is a reference, as in core 3.x: a handler can take
+ * the socket over by copying it and calling stop() on the server's handle, which releases
+ * the server from the close wait.
+ * Because port 80 needs privileges on a desktop, every port is shifted by
+ * WebServer::shimPortOffset (the host runner's --port-offset, 8000 by default).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "WString.h"
+#include "WiFiClient.h"
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+
+typedef enum
+{
+    HTTP_ANY,
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_PATCH,
+    HTTP_DELETE,
+    HTTP_OPTIONS
+} HTTPMethod;
+
+class WebServer
+{
+public:
+    typedef std::function<void()> THandlerFunction;
+
+    static uint16_t shimPortOffset;
+
+    explicit WebServer(uint16_t port = 80) : _port(port) {}
+    ~WebServer() { close(); }
+
+    void begin();
+    void close();
+    void handleClient();
+
+    void on(const char *uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const char *uri, HTTPMethod method, THandlerFunction handler) { _routes.push_back({uri, method, handler}); }
+    void onNotFound(THandlerFunction handler) { _notFound = handler; }
+
+    String uri() const { return String(_uri.c_str()); }
+    HTTPMethod method() const { return _method; }
+    String arg(const char *name) const;
+    String arg(const String &name) const { return arg(name.c_str()); }
+    bool hasArg(const char *name) const;
+    bool hasArg(const String &name) const { return hasArg(name.c_str()); }
+    int args() const { return (int)_args.size(); }
+    String header(const char *name) const;
+    void collectHeaders(const char *headerKeys[], size_t count);
+    WiFiClient &client() { return _client; }
+
+    void setContentLength(size_t length) { _contentLength = length; }
+    void sendHeader(const String &name, const String &value, bool first = false);
+    void send(int code, const char *contentType = nullptr, const String &content = String());
+    void send(int code, const char *contentType, const char *content) { send(code, contentType, String(content)); }
+    void send_P(int code, const char *contentType, const char *content, size_t length);
+    void sendContent(const String &content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char *content, size_t length);
+
+    /** The port actually listened on, after shimPortOffset */
+    uint16_t shimPort() const { return (uint16_t)(_port + shimPortOffset); }
+
+private:
+    enum ClientStatus
+    {
+        HC_NONE,
+        HC_WAIT_READ,
+        HC_WAIT_CLOSE
+    };
+
+    bool readRequest();
+    void handleRequest();
+    void sendHeaders(int code, const char *contentType, size_t length);
+
+    struct Route
+    {
+        std::string uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+
+    uint16_t _port;
+    int _listenFd = -1;
+    std::vector<Route> _routes;
+    THandlerFunction _notFound;
+    std::vector<std::string> _collected;
+
+    // Current request
+    WiFiClient _client;
+    ClientStatus _status = HC_NONE;
+    unsigned long _statusChange = 0;
+    HTTPMethod _method = HTTP_GET;
+    std::string _uri;
+    std::vector<std::pair<std::string, std::string>> _args;
+    std::vector<std::pair<std::string, std::string>> _headers;
+    std::string _responseHeaders;
+    size_t _contentLength = CONTENT_LENGTH_NOT_SET;
+    bool _chunked = false;
+};
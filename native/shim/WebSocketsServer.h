@@ -0,0 +1,76 @@
+/**
+ * @file WebSocketsServer.h
+ * @brief The arduinoWebSockets server (Links2004) over host sockets.
+ *
+ * Speaks RFC 6455 to real browsers: the upgrade handshake, masked client frames, ping
+ * answered with pong and close. Only the calls the hub makes are provided. Like the
+ * library, at most WEBSOCKETS_SERVER_CLIENT_MAX clients are served; a further one is
+ * refused during the handshake. The port is shifted by WebServer::shimPortOffset.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include "WString.h"
+#include "WiFiClient.h"
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+
+typedef enum
+{
+    WStype_ERROR,
+    WStype_DISCONNECTED,
+    WStype_CONNECTED,
+    WStype_TEXT,
+    WStype_BIN,
+    WStype_FRAGMENT_TEXT_START,
+    WStype_FRAGMENT_BIN_START,
+    WStype_FRAGMENT,
+    WStype_FRAGMENT_FIN,
+    WStype_PING,
+    WStype_PONG
+} WStype_t;
+
+class WebSocketsServer
+{
+public:
+    typedef std::function<void(uint8_t num, WStype_t type, uint8_t *payload, size_t length)> WebSocketServerEvent;
+
+    explicit WebSocketsServer(uint16_t port) : _port(port) {}
+    ~WebSocketsServer() { close(); }
+
+    void begin();
+    void close();
+    void loop();
+    void onEvent(WebSocketServerEvent callback) { _event = callback; }
+
+    bool sendTXT(uint8_t num, const char *payload, size_t length = 0);
+    bool sendTXT(uint8_t num, const String &payload) { return sendTXT(num, payload.c_str(), payload.length()); }
+    bool broadcastTXT(const char *payload, size_t length = 0);
+    bool broadcastTXT(const String &payload) { return broadcastTXT(payload.c_str(), payload.length()); }
+    void disconnect(uint8_t num);
+    uint8_t connectedClients();
+
+private:
+    struct Client
+    {
+        WiFiClient tcp;
+        bool upgraded = false;
+        unsigned long since = 0;
+        std::string input;
+    };
+
+    void accept();
+    void handshake(uint8_t num);
+    void receive(uint8_t num);
+    bool sendFrame(uint8_t num, uint8_t opcode, const uint8_t *payload, size_t length);
+    void drop(uint8_t num);
+
+    uint16_t _port;
+    int _listenFd = -1;
+    Client _clients[WEBSOCKETS_SERVER_CLIENT_MAX];
+    WebSocketServerEvent _event;
+};
@@ -0,0 +1,135 @@
+/**
+ * @file WiFi.h
+ * @brief ESP32 WiFi station with a scriptable access point.
+ *
+ * The real driver reports progress through events on its own task; here they come
+ * from the virtual clock. By default the access point is reachable and begin() leads
+ * to ARDUINO_EVENT_WIFI_STA_GOT_IP after WiFiModel::connectDelayMicros. Tests can make the
+ * AP unreachable, drop the link or raise any event directly through shim::wifi().
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+typedef enum
+{
+    WIFI_OFF,
+    WIFI_STA,
+    WIFI_AP,
+    WIFI_AP_STA
+} wifi_mode_t;
+
+typedef enum
+{
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum
+{
+    ARDUINO_EVENT_WIFI_READY = 0,
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_STOP,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP6,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP,
+    ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+
+typedef struct
+{
+    uint8_t reason; // Disconnect reason, for ARDUINO_EVENT_WIFI_STA_DISCONNECTED
+} arduino_event_info_t;
+
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+
+class WiFiClass
+{
+public:
+    bool mode(wifi_mode_t mode)
+    {
+        _mode = mode;
+        return true;
+    }
+    bool persistent(bool persistent)
+    {
+        (void)persistent;
+        return true;
+    }
+    bool setAutoReconnect(bool autoReconnect)
+    {
+        _autoReconnect = autoReconnect;
+        return true;
+    }
+
+    wl_status_t begin(const char *ssid, const char *password = nullptr);
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+    wl_status_t status();
+    bool isConnected() { return status() == WL_CONNECTED; }
+    IPAddress localIP() { return isConnected() ? IPAddress(127, 0, 0, 1) : IPAddress(); }
+
+    int onEvent(WiFiEventFuncCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+
+private:
+    wifi_mode_t _mode = WIFI_OFF;
+    bool _autoReconnect = true;
+};
+
+extern WiFiClass WiFi;
+
+namespace shim
+{
+
+/** The access point and driver behind WiFi */
+class WiFiModel
+{
+public:
+    uint64_t connectDelayMicros = 50000;
+
+    /** Whether begin() can succeed; an unreachable AP gives no event at all, like a missing SSID */
+    void setReachable(bool reachable) { _reachable = reachable; }
+
+    /** Drops an established link: DISCONNECTED now */
+    void dropLink();
+
+    /** Drops an established link without any event, as when the driver's event is missed */
+    void dropLinkSilently();
+
+    /** Raises event at once, on the caller's thread, as the driver task would */
+    void raise(arduino_event_id_t event);
+
+    bool connected() const { return _connected; }
+    uint32_t begins() const { return _begins; }
+    uint32_t disconnects() const { return _disconnects; }
+
+private:
+    friend class ::WiFiClass;
+    struct Handler
+    {
+        WiFiEventFuncCb callback;
+        arduino_event_id_t event;
+    };
+
+    bool _reachable = true;
+    bool _connected = false;
+    uint32_t _attempt = 0; // Stale connect events from an abandoned attempt are ignored
+    uint32_t _begins = 0;
+    uint32_t _disconnects = 0;
+    std::vector<Handler> _handlers;
+};
+
+WiFiModel &wifi();
+
+} // namespace shim
@@ -0,0 +1,49 @@
+/**
+ * @file WiFiClient.h
+ * @brief TCP client handle over a host socket.
+ * Copies share the socket, as with the ESP32 core's reference-counted socket handle:
+ * stop() only releases the copy it is called on, and the socket is closed when the last
+ * copy lets go of it.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include "HardwareSerial.h"
+
+class WiFiClient : public Stream
+{
+public:
+    WiFiClient() {}
+
+    /** Takes ownership of a connected socket */
+    explicit WiFiClient(int fd);
+
+    uint8_t connected();
+    operator bool() { return connected(); }
+    /** Releases this copy's reference; the socket closes once no copy holds it */
+    void stop();
+    void setNoDelay(bool noDelay);
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    int read(uint8_t *buffer, size_t length);
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+    size_t write(const uint8_t *data, size_t length) override;
+    using Print::write;
+
+    int fd() const { return _socket ? _socket->fd : -1; }
+
+private:
+    struct Socket
+    {
+        explicit Socket(int socketFd) : fd(socketFd) {}
+        ~Socket();
+        int fd;
+    };
+
+    std::shared_ptr<Socket> _socket;
+};
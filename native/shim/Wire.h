@@ -0,0 +1,46 @@
+/**
+ * @file Wire.h
+ * @brief I2C master that only counts traffic: transactions and bytes, address bytes included.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class TwoWire
+{
+public:
+    void begin() {}
+    void setClock(uint32_t) {}
+
+    void beginTransmission(uint8_t address)
+    {
+        (void)address;
+        _bytes++; // Address byte
+    }
+
+    size_t write(uint8_t)
+    {
+        _bytes++;
+        return 1;
+    }
+
+    uint8_t endTransmission(bool stop = true)
+    {
+        (void)stop;
+        _transactions++;
+        return 0;
+    }
+
+    // --- Host control ---
+    uint32_t shimTransactions() const { return _transactions; }
+    uint32_t shimBytes() const { return _bytes; }
+    void shimResetCounters() { _transactions = _bytes = 0; }
+
+private:
+    uint32_t _transactions = 0;
+    uint32_t _bytes = 0;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,91 @@
+/**
+ * @file uart.h
+ * @brief ESP-IDF UART driver on the host.
+ *
+ * Each port has the driver's receive buffer and event queue. Bytes reach it from
+ * shim::uartReceive() (tests) or from a file descriptor attached with shim::uartAttach()
+ * (a pipe, FIFO or pty wired to the Nano process). A chunk that no longer fits the
+ * receive buffer posts UART_BUFFER_FULL and is dropped, like the driver does; when the
+ * event queue is full the event is lost but the bytes stay buffered.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include "freertos/FreeRTOS.h"
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+
+typedef int uart_port_t;
+#define UART_NUM_0 0
+#define UART_NUM_1 1
+#define UART_NUM_2 2
+#define UART_NUM_MAX 3
+#define UART_PIN_NO_CHANGE (-1)
+
+typedef enum { UART_DATA_5_BITS, UART_DATA_6_BITS, UART_DATA_7_BITS, UART_DATA_8_BITS } uart_word_length_t;
+typedef enum { UART_PARITY_DISABLE, UART_PARITY_EVEN = 2, UART_PARITY_ODD } uart_parity_t;
+typedef enum { UART_STOP_BITS_1 = 1, UART_STOP_BITS_1_5, UART_STOP_BITS_2 } uart_stop_bits_t;
+typedef enum { UART_HW_FLOWCTRL_DISABLE } uart_hw_flowcontrol_t;
+
+typedef struct
+{
+    int baud_rate;
+    uart_word_length_t data_bits;
+    uart_parity_t parity;
+    uart_stop_bits_t stop_bits;
+    uart_hw_flowcontrol_t flow_ctrl;
+    uint8_t rx_flow_ctrl_thresh;
+    int source_clk;
+} uart_config_t;
+
+typedef enum
+{
+    UART_DATA,
+    UART_BREAK,
+    UART_BUFFER_FULL,
+    UART_FIFO_OVF,
+    UART_FRAME_ERR,
+    UART_PARITY_ERR,
+    UART_DATA_BREAK,
+    UART_PATTERN_DET,
+    UART_EVENT_MAX
+} uart_event_type_t;
+
+typedef struct
+{
+    uart_event_type_t type;
+    size_t size;
+    bool timeout_flag;
+} uart_event_t;
+
+esp_err_t uart_driver_install(uart_port_t port, int rxBufferSize, int txBufferSize, int queueSize,
+                              QueueHandle_t *queue, int interruptFlags);
+esp_err_t uart_param_config(uart_port_t port, const uart_config_t *config);
+esp_err_t uart_set_pin(uart_port_t port, int txPin, int rxPin, int rtsPin, int ctsPin);
+int uart_read_bytes(uart_port_t port, void *buffer, uint32_t length, TickType_t wait);
+int uart_write_bytes(uart_port_t port, const void *data, size_t length);
+esp_err_t uart_flush_input(uart_port_t port);
+
+namespace shim
+{
+
+/** Bytes arriving at port's RX pin, delivered as one driver chunk */
+void uartReceive(uart_port_t port, const uint8_t *data, size_t length);
+
+/** Feeds port from inFd on a thread and sends its output to outFd; -1 leaves a side unattached */
+void uartAttach(uart_port_t port, int inFd, int outFd);
+
+/** Keeps port's output for uartTakeOutput() */
+void uartCapture(uart_port_t port, bool on);
+std::string uartTakeOutput(uart_port_t port);
+
+/** Baud rate from uart_param_config(), 0 before */
+int uartBaud(uart_port_t port);
+
+} // namespace shim
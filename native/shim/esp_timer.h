@@ -0,0 +1,11 @@
+/**
+ * @file esp_timer.h
+ * @brief The 64-bit microsecond timer since boot, on the virtual clock; unlike millis() it does not wrap.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "ShimClock.h"
+
+inline int64_t esp_timer_get_time() { return (int64_t)shim::clock().micros(); }
@@ -0,0 +1,8 @@
+/**
+ * @file sdkconfig.h
+ * @brief The ESP-IDF options the hub reads, at the values of the arduino-esp32 core's build.
+ */
+
+#pragma once
+
+#define CONFIG_LWIP_MAX_SOCKETS 16
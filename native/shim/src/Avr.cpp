@@ -0,0 +1,53 @@
+#include <Arduino.h>
+#include "ShimPins.h"
+
+#ifndef ARDUINO_ARCH_AVR
+#error "Avr.cpp is the Nano board layer; build it with -DARDUINO_ARCH_AVR (the shim_avr target does)"
+#endif
+
+volatile uint8_t PINB = 0;
+volatile uint8_t PINC = 0;
+volatile uint8_t PIND = 0;
+volatile uint8_t PCICR = 0;
+volatile uint8_t PCMSK0 = 0;
+volatile uint8_t PCMSK1 = 0;
+volatile uint8_t PCMSK2 = 0;
+volatile uint8_t GPIOR0 = 0;
+
+uint8_t __heap_start = 0;
+void *__brkval = nullptr;
+
+namespace
+{
+
+/** Mirrors pin levels into PINx and raises pin-change interrupts */
+struct PinChangeInterrupts
+{
+    PinChangeInterrupts()
+    {
+        shim::pins().onLevelChange([](uint8_t pin) {
+            if (pin > 19)
+                return;
+            uint8_t port = digitalPinToPort(pin);
+            uint8_t mask = digitalPinToBitMask(pin);
+            volatile uint8_t *input = portInputRegister(port);
+            if (shim::pins().level(pin))
+                *input |= mask;
+            else
+                *input &= (uint8_t)~mask;
+
+            uint8_t group = digitalPinToPCICRbit(pin);
+            if (!(PCICR & _BV(group)) || !(*digitalPinToPCMSK(pin) & _BV(digitalPinToPCMSKbit(pin))))
+                return;
+            void (*vector)(void) = group == 0 ? shim_avr_pcint0_vect
+                                 : group == 1 ? shim_avr_pcint1_vect
+                                              : shim_avr_pcint2_vect;
+            if (vector)
+                vector();
+        });
+    }
+};
+
+PinChangeInterrupts pinChangeInterrupts;
+
+} // namespace
@@ -0,0 +1,100 @@
+#include "ShimClock.h"
+
+#include <thread>
+
+namespace shim
+{
+
+Clock &clock()
+{
+    static Clock instance;
+    return instance;
+}
+
+void Clock::useManual(uint64_t start)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _manual = true;
+    _now = start;
+    _events.clear();
+}
+
+void Clock::useRealTime(double scale)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _now = _manual ? _now : elapsed();
+    _manual = false;
+    _scale = scale > 0 ? scale : 1.0;
+    _origin = std::chrono::steady_clock::now();
+}
+
+uint64_t Clock::elapsed() const
+{
+    if (_manual)
+        return _now;
+    std::chrono::duration<double, std::micro> real = std::chrono::steady_clock::now() - _origin;
+    return _now + (uint64_t)(real.count() * _scale);
+}
+
+uint64_t Clock::micros()
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (_dispatching)
+        return _dispatchTime;
+    uint64_t now = elapsed();
+    runDue(now);
+    return now;
+}
+
+void Clock::runDue(uint64_t until)
+{
+    _dispatching = true;
+    while (!_events.empty() && _events.begin()->first <= until)
+    {
+        // An event may schedule further events, so take it out before running it
+        auto next = _events.begin();
+        _dispatchTime = next->first;
+        Event event = std::move(next->second);
+        _events.erase(next);
+        event();
+    }
+    _dispatching = false;
+}
+
+void Clock::advance(uint64_t us)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (!_manual || _dispatching)
+        return;
+    uint64_t target = _now + us;
+    runDue(target);
+    _now = target;
+}
+
+void Clock::sleep(uint64_t us)
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        if (_manual)
+        {
+            advance(us);
+            return;
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double, std::micro>(us / _scale));
+    micros();
+}
+
+void Clock::at(uint64_t when, Event event)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _events.emplace(when, std::move(event));
+}
+
+size_t Clock::pending()
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _events.size();
+}
+
+} // namespace shim
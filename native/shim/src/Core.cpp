@@ -0,0 +1,188 @@
+#include <Arduino.h>
+#include "ShimPins.h"
+
+#include <stdarg.h>
+#include <random>
+
+namespace shim
+{
+
+Pins &pins()
+{
+    static Pins instance;
+    return instance;
+}
+
+void Pins::setMode(uint8_t pin, uint8_t mode)
+{
+    if (pin >= PIN_COUNT)
+        return;
+    _pins[pin].mode = mode;
+    if (mode == INPUT_PULLUP)
+        _pins[pin].latch = HIGH; // The AVR enables the pull-up through the output latch
+    update(pin);
+    for (Listener &listener : _sketchListeners)
+        listener(pin);
+}
+
+void Pins::setLatch(uint8_t pin, uint8_t value)
+{
+    if (pin >= PIN_COUNT)
+        return;
+    _pins[pin].latch = value ? HIGH : LOW;
+    update(pin);
+    for (Listener &listener : _sketchListeners)
+        listener(pin);
+}
+
+void Pins::drive(uint8_t pin, uint8_t level)
+{
+    if (pin >= PIN_COUNT)
+        return;
+    _pins[pin].driven = true;
+    _pins[pin].drivenLevel = level ? HIGH : LOW;
+    update(pin);
+}
+
+void Pins::release(uint8_t pin)
+{
+    if (pin >= PIN_COUNT)
+        return;
+    _pins[pin].driven = false;
+    update(pin);
+}
+
+void Pins::update(uint8_t pin)
+{
+    Pin &p = _pins[pin];
+    uint8_t level;
+    if (p.mode == OUTPUT)
+        level = p.latch;
+    else if (p.driven)
+        level = p.drivenLevel;
+    else
+        level = p.mode == INPUT_PULLUP ? HIGH : LOW;
+
+    if (level == p.level)
+        return;
+    p.level = level;
+    for (Listener &listener : _levelListeners)
+        listener(pin);
+}
+
+static std::mt19937 &generator()
+{
+    static std::mt19937 instance(1);
+    return instance;
+}
+
+} // namespace shim
+
+void pinMode(uint8_t pin, uint8_t mode) { shim::pins().setMode(pin, mode); }
+void digitalWrite(uint8_t pin, uint8_t value) { shim::pins().setLatch(pin, value); }
+int digitalRead(uint8_t pin) { return shim::pins().level(pin); }
+
+long random(long max) { return max > 0 ? random(0, max) : 0; }
+
+long random(long min, long max)
+{
+    if (max <= min)
+        return min;
+    return min + (long)(shim::generator()() % (unsigned long)(max - min));
+}
+
+void randomSeed(unsigned long seed) { shim::generator().seed((std::mt19937::result_type)seed); }
+
+// --- Print ---
+
+size_t Print::write(const uint8_t *data, size_t length)
+{
+    size_t n = 0;
+    while (length--)
+        n += write(*data++);
+    return n;
+}
+
+size_t Print::printUnsigned(unsigned long long value, int base)
+{
+    if (base < 2)
+        base = 10;
+    char digits[65];
+    char *p = digits + sizeof(digits) - 1;
+    *p = '\0';
+    do
+    {
+        int digit = (int)(value % base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value);
+    return write(p);
+}
+
+size_t Print::print(long value, int base) { return print((long long)value, base); }
+size_t Print::print(unsigned long value, int base) { return printUnsigned(value, base); }
+size_t Print::print(unsigned long long value, int base) { return printUnsigned(value, base); }
+
+size_t Print::print(long long value, int base)
+{
+    // Like the cores: only decimal gets a sign, other bases print the two's complement
+    if (base != 10 || value >= 0)
+        return printUnsigned((unsigned long long)value, base);
+    size_t n = print('-');
+    return n + printUnsigned(0ULL - (unsigned long long)value, base);
+}
+
+size_t Print::print(double value, int digits)
+{
+    if (isnan(value))
+        return write("nan");
+    if (isinf(value))
+        return write("inf");
+    if (value > 4294967040.0 || value < -4294967040.0)
+        return write("ovf");
+
+    // The cores' printFloat(): round half up at the last digit, then emit digit by digit
+    size_t n = 0;
+    if (value < 0.0)
+    {
+        n += print('-');
+        value = -value;
+    }
+    double rounding = 0.5;
+    for (int i = 0; i < digits; i++)
+        rounding /= 10.0;
+    value += rounding;
+
+    unsigned long integer = (unsigned long)value;
+    double remainder = value - (double)integer;
+    n += print(integer);
+    if (digits > 0)
+        n += print('.');
+    while (digits-- > 0)
+    {
+        remainder *= 10.0;
+        unsigned int digit = (unsigned int)remainder;
+        n += print(digit);
+        remainder -= digit;
+    }
+    return n;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char small[128];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (length < 0)
+        return 0;
+    if ((size_t)length < sizeof(small))
+        return write((const uint8_t *)small, length);
+
+    std::string large((size_t)length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&large[0], large.size(), format, args);
+    va_end(args);
+    return write((const uint8_t *)large.data(), length);
+}
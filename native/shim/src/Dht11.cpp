@@ -0,0 +1,88 @@
+#include <Arduino.h>
+#include "ShimDht11.h"
+#include "ShimPins.h"
+
+namespace shim
+{
+
+const uint64_t DHT11_MIN_START_US = 18000;
+const uint16_t DHT11_WAIT_US = 30;      // Sensor pause after the host releases the line
+const uint16_t DHT11_PREAMBLE_US = 80;  // Each of the low and the high half
+const uint16_t DHT11_BIT_LOW_US = 50;
+const uint16_t DHT11_ZERO_HIGH_US = 26;
+const uint16_t DHT11_ONE_HIGH_US = 70;
+
+Dht11 &dht11()
+{
+    static Dht11 instance;
+    return instance;
+}
+
+void Dht11::attach(uint8_t pin)
+{
+    _pin = pin;
+    pins().onSketchChange([this](uint8_t changed) {
+        if (changed == _pin)
+            onSketchChange();
+    });
+}
+
+void Dht11::onSketchChange()
+{
+    bool low = pins().mode(_pin) == OUTPUT && pins().level(_pin) == LOW;
+    uint64_t now = clock().micros();
+    if (low && !_heldLow)
+    {
+        _heldLow = true;
+        _lowSince = now;
+    }
+    else if (!low && _heldLow)
+    {
+        _heldLow = false;
+        if (_present && now - _lowSince >= DHT11_MIN_START_US)
+            respond(now);
+    }
+}
+
+uint64_t Dht11::phase(uint64_t at, uint16_t nominal)
+{
+    if (_jitter == 0)
+        return at + nominal;
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    int offset = (int)(_rng % (2u * _jitter + 1)) - _jitter;
+    return at + (uint64_t)((int)nominal + offset);
+}
+
+void Dht11::respond(uint64_t start)
+{
+    _responses++;
+    uint8_t data[5] = {_humidity, 0, _temperature, 0, 0};
+    data[4] = (uint8_t)(data[0] + data[1] + data[2] + data[3]);
+    if (_badChecksum)
+        data[4] ^= 0xFF;
+
+    uint8_t pin = _pin;
+    auto low = [pin]() { pins().drive(pin, LOW); };
+    auto release = [pin]() { pins().release(pin); };
+
+    uint64_t t = phase(start, DHT11_WAIT_US);
+    clock().at(t, low);
+    t = phase(t, DHT11_PREAMBLE_US);
+    clock().at(t, release);
+    t = phase(t, DHT11_PREAMBLE_US);
+    for (uint8_t bit = 0; bit < 40; bit++)
+    {
+        bool one = data[bit / 8] & (0x80 >> (bit % 8));
+        clock().at(t, low);
+        t = phase(t, DHT11_BIT_LOW_US);
+        clock().at(t, release);
+        t = phase(t, one ? DHT11_ONE_HIGH_US : DHT11_ZERO_HIGH_US);
+    }
+    clock().at(t, low);
+    t = phase(t, DHT11_BIT_LOW_US);
+    clock().at(t, release);
+}
+
+} // namespace shim
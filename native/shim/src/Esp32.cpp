@@ -0,0 +1,115 @@
+#include <Arduino.h>
+
+#include <condition_variable>
+#include <deque>
+#include <malloc.h>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+EspClass ESP;
+
+const uint32_t SHIM_HEAP_SIZE = 320 * 1024; // Internal RAM of a WROVER, for getFreeHeap()
+
+uint32_t EspClass::getCycleCount() { return (uint32_t)(shim::clock().micros() * SHIM_CPU_MHZ); }
+
+uint32_t EspClass::getFreeHeap()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks < SHIM_HEAP_SIZE ? SHIM_HEAP_SIZE - (uint32_t)info.uordblks : 0;
+}
+
+uint32_t EspClass::getHeapSize() { return SHIM_HEAP_SIZE; }
+
+void EspClass::restart() { exit(0); }
+
+uint32_t esp_random()
+{
+    static std::mt19937 generator(std::random_device{}());
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    return (uint32_t)generator();
+}
+
+// --- FreeRTOS ---
+
+struct ShimQueue
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length;
+    size_t itemSize;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    ShimQueue *queue = new ShimQueue;
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+/** Waits for ready() under the queue's lock; wait is in ticks (ms) */
+template <typename Ready>
+static bool waitFor(ShimQueue *queue, std::unique_lock<std::mutex> &lock, TickType_t wait, Ready ready)
+{
+    if (wait == portMAX_DELAY)
+    {
+        queue->changed.wait(lock, ready);
+        return true;
+    }
+    return queue->changed.wait_for(lock, std::chrono::milliseconds(wait), ready);
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t wait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue, lock, wait, [queue]() { return queue->items.size() < queue->length; }))
+        return pdFALSE;
+    const uint8_t *bytes = (const uint8_t *)item;
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue, lock, wait, [queue]() { return !queue->items.empty(); }))
+        return pdFALSE;
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->items.clear();
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return (UBaseType_t)queue->items.size();
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stackBytes, void *parameter,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+    (void)name;
+    (void)stackBytes;
+    (void)priority;
+    (void)core;
+    std::thread(function, parameter).detach();
+    if (handle)
+        *handle = nullptr;
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
@@ -0,0 +1,287 @@
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <algorithm>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+fs::LittleFSFS LittleFS;
+
+namespace fs
+{
+
+struct File::Impl
+{
+    ~Impl()
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    FS *fs = nullptr;
+    int fd = -1;
+    bool directory = false;
+    std::string path; // The sketch's path
+    std::string name;
+    std::string hostPath;
+    std::vector<std::string> entries; // Directory listing, in name order
+    size_t next = 0;
+};
+
+// --- File ---
+
+size_t File::write(const uint8_t *data, size_t length)
+{
+    if (!_impl || _impl->fd < 0)
+        return 0;
+    size_t done = 0;
+    while (done < length)
+    {
+        ssize_t n = ::write(_impl->fd, data + done, length - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        done += (size_t)n;
+    }
+    _impl->fs->_bytesWritten += done;
+    _impl->fs->_writes++;
+    return done;
+}
+
+size_t File::read(uint8_t *buffer, size_t length)
+{
+    if (!_impl || _impl->fd < 0)
+        return 0;
+    size_t done = 0;
+    while (done < length)
+    {
+        ssize_t n = ::read(_impl->fd, buffer + done, length - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        done += (size_t)n;
+    }
+    _impl->fs->_bytesRead += done;
+    return done;
+}
+
+int File::read()
+{
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek()
+{
+    if (!_impl || _impl->fd < 0)
+        return -1;
+    uint8_t c;
+    if (::pread(_impl->fd, &c, 1, lseek(_impl->fd, 0, SEEK_CUR)) != 1)
+        return -1;
+    return c;
+}
+
+int File::available()
+{
+    if (!_impl || _impl->fd < 0)
+        return 0;
+    size_t total = size();
+    size_t at = position();
+    return at < total ? (int)(total - at) : 0;
+}
+
+void File::flush()
+{
+    if (!_impl || _impl->fd < 0)
+        return;
+    fsync(_impl->fd);
+    _impl->fs->_syncs++;
+}
+
+bool File::seek(uint32_t position)
+{
+    return _impl && _impl->fd >= 0 && lseek(_impl->fd, position, SEEK_SET) == (off_t)position;
+}
+
+size_t File::position() const
+{
+    if (!_impl || _impl->fd < 0)
+        return 0;
+    off_t at = lseek(_impl->fd, 0, SEEK_CUR);
+    return at < 0 ? 0 : (size_t)at;
+}
+
+size_t File::size() const
+{
+    struct stat info;
+    if (!_impl || _impl->fd < 0 || fstat(_impl->fd, &info) != 0)
+        return 0;
+    return (size_t)info.st_size;
+}
+
+const char *File::name() const { return _impl ? _impl->name.c_str() : ""; }
+const char *File::path() const { return _impl ? _impl->path.c_str() : ""; }
+bool File::isDirectory() const { return _impl && _impl->directory; }
+
+File File::openNextFile(const char *mode)
+{
+    if (!_impl || !_impl->directory || _impl->next >= _impl->entries.size())
+        return File();
+    std::string child = _impl->path;
+    if (child.empty() || child.back() != '/')
+        child += '/';
+    child += _impl->entries[_impl->next++];
+    return _impl->fs->open(child.c_str(), mode);
+}
+
+// --- FS ---
+
+std::string FS::hostPath(const char *path) const
+{
+    std::string host = _root;
+    if (!path || path[0] != '/')
+        host += '/';
+    return host + (path ? path : "");
+}
+
+File FS::open(const char *path, const char *mode, bool create)
+{
+    (void)create;
+    File file;
+    if (!_mounted || !path || path[0] != '/')
+        return file;
+
+    std::string host = hostPath(path);
+    struct stat info;
+    bool exists = stat(host.c_str(), &info) == 0;
+
+    auto impl = std::make_shared<File::Impl>();
+    impl->fs = this;
+    impl->path = path;
+    const char *slash = strrchr(path, '/');
+    impl->name = slash ? slash + 1 : path;
+    impl->hostPath = host;
+
+    if (exists && S_ISDIR(info.st_mode))
+    {
+        if (strcmp(mode, FILE_READ) != 0)
+            return file;
+        DIR *dir = opendir(host.c_str());
+        if (!dir)
+            return file;
+        for (struct dirent *entry = readdir(dir); entry; entry = readdir(dir))
+        {
+            if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+                impl->entries.push_back(entry->d_name);
+        }
+        closedir(dir);
+        std::sort(impl->entries.begin(), impl->entries.end());
+        impl->directory = true;
+        file._impl = impl;
+        return file;
+    }
+
+    int flags;
+    if (strcmp(mode, FILE_WRITE) == 0)
+        flags = O_WRONLY | O_CREAT | O_TRUNC;
+    else if (strcmp(mode, FILE_APPEND) == 0)
+        flags = O_WRONLY | O_CREAT | O_APPEND;
+    else
+        flags = O_RDONLY;
+    impl->fd = ::open(host.c_str(), flags, 0644);
+    if (impl->fd < 0)
+        return file;
+    file._impl = impl;
+    return file;
+}
+
+bool FS::exists(const char *path)
+{
+    struct stat info;
+    return _mounted && stat(hostPath(path).c_str(), &info) == 0;
+}
+
+bool FS::remove(const char *path) { return _mounted && unlink(hostPath(path).c_str()) == 0; }
+
+bool FS::rename(const char *from, const char *to)
+{
+    return _mounted && ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path) { return _mounted && ::mkdir(hostPath(path).c_str(), 0755) == 0; }
+bool FS::rmdir(const char *path) { return _mounted && ::rmdir(hostPath(path).c_str()) == 0; }
+
+// --- LittleFS ---
+
+bool LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenFiles, const char *partitionLabel)
+{
+    (void)basePath;
+    (void)maxOpenFiles;
+    (void)partitionLabel;
+    struct stat info;
+    if (stat(_root.c_str(), &info) != 0)
+    {
+        // An unformatted partition only mounts when the sketch allows formatting it
+        if (!formatOnFail || ::mkdir(_root.c_str(), 0755) != 0)
+            return false;
+    }
+    else if (!S_ISDIR(info.st_mode))
+    {
+        return false;
+    }
+    _mounted = true;
+    return true;
+}
+
+static void removeTree(const std::string &path)
+{
+    DIR *dir = opendir(path.c_str());
+    if (!dir)
+    {
+        unlink(path.c_str());
+        return;
+    }
+    for (struct dirent *entry = readdir(dir); entry; entry = readdir(dir))
+    {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            removeTree(path + "/" + entry->d_name);
+    }
+    closedir(dir);
+    ::rmdir(path.c_str());
+}
+
+bool LittleFSFS::format()
+{
+    removeTree(_root);
+    return ::mkdir(_root.c_str(), 0755) == 0;
+}
+
+static size_t treeBytes(const std::string &path)
+{
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0)
+        return 0;
+    if (!S_ISDIR(info.st_mode))
+        return (size_t)info.st_size;
+    size_t total = 0;
+    DIR *dir = opendir(path.c_str());
+    if (!dir)
+        return 0;
+    for (struct dirent *entry = readdir(dir); entry; entry = readdir(dir))
+    {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            total += treeBytes(path + "/" + entry->d_name);
+    }
+    closedir(dir);
+    return total;
+}
+
+size_t LittleFSFS::usedBytes() { return treeBytes(_root); }
+
+} // namespace fs
@@ -0,0 +1,160 @@
+#include <Arduino.h>
+
+#include <errno.h>
+#include <thread>
+#include <unistd.h>
+
+#if defined(ARDUINO_ARCH_AVR)
+HardwareSerial Serial(64); // The core's RX ring
+#else
+HardwareSerial Serial(256);
+HardwareSerial Serial2(256);
+#endif
+
+size_t Stream::readBytes(uint8_t *buffer, size_t length)
+{
+    size_t count = 0;
+    unsigned long start = millis();
+    while (count < length)
+    {
+        int c = read();
+        if (c < 0)
+        {
+            if (millis() - start >= _timeout)
+                break;
+            delay(1);
+            continue;
+        }
+        buffer[count++] = (uint8_t)c;
+    }
+    return count;
+}
+
+String Stream::readStringUntil(char terminator)
+{
+    String text;
+    uint8_t c;
+    while (readBytes(&c, 1) == 1 && c != (uint8_t)terminator)
+        text += (char)c;
+    return text;
+}
+
+int HardwareSerial::available()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    pump();
+    return (int)_rx.size();
+}
+
+int HardwareSerial::read()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    pump();
+    if (_rx.empty())
+        return -1;
+    uint8_t c = _rx.front();
+    _rx.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    pump();
+    return _rx.empty() ? -1 : _rx.front();
+}
+
+size_t HardwareSerial::write(const uint8_t *data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_capture)
+        _captured.append((const char *)data, length);
+    if (_outFd >= 0)
+    {
+        size_t done = 0;
+        while (done < length)
+        {
+            ssize_t n = ::write(_outFd, data + done, length - done);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                break; // Reader gone: the bytes are lost, as on an unplugged line
+            done += (size_t)n;
+        }
+    }
+    return length;
+}
+
+void HardwareSerial::shimAttach(int inFd, int outFd)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _outFd = outFd;
+    }
+    if (inFd < 0)
+        return;
+
+    std::thread([this, inFd]() {
+        uint8_t buffer[256];
+        for (;;)
+        {
+            ssize_t n = ::read(inFd, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return;
+            shimLineReceive(buffer, (size_t)n);
+        }
+    }).detach();
+}
+
+void HardwareSerial::shimReceive(const uint8_t *data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t i = 0; i < length; i++)
+        push(data[i]);
+}
+
+void HardwareSerial::shimLineReceive(const uint8_t *data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_line.empty())
+    {
+        uint64_t now = shim::clock().micros();
+        _lineTime = (_lineTime > now ? _lineTime : now) + (_baud ? 10000000ULL / _baud : 0);
+    }
+    _line.insert(_line.end(), data, data + length);
+}
+
+void HardwareSerial::pump()
+{
+    if (_line.empty())
+        return;
+    uint64_t now = shim::clock().micros();
+    uint64_t byteTime = _baud ? 10000000ULL / _baud : 0;
+    while (!_line.empty() && _lineTime <= now)
+    {
+        push(_line.front());
+        _line.pop_front();
+        if (!_line.empty())
+            _lineTime += byteTime;
+    }
+}
+
+void HardwareSerial::push(uint8_t c)
+{
+    if (_rx.size() >= _rxCapacity)
+    {
+        _rxOverflows++;
+        return;
+    }
+    _rx.push_back(c);
+}
+
+std::string HardwareSerial::shimTakeOutput()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string output;
+    output.swap(_captured);
+    return output;
+}
@@ -0,0 +1,106 @@
+#include <Arduino.h>
+#include <LiquidCrystal_I2C.h>
+#include <Wire.h>
+
+static const uint8_t LCD_EN = 0x04;
+static const uint8_t LCD_RS = 0x01;
+static const uint8_t LCD_BACKLIGHT = 0x08;
+static const uint8_t ROW_OFFSETS[] = {0x00, 0x40, 0x14, 0x54};
+
+LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t address, uint8_t columns, uint8_t rows)
+    : _address(address), _columns(columns), _rows(rows)
+{
+    memset(_ddram, ' ', sizeof(_ddram));
+}
+
+void LiquidCrystal_I2C::init()
+{
+    Wire.begin();
+    command(0x28); // 4-bit, two lines
+    command(0x0C); // Display on, no cursor
+    clear();
+    command(0x06); // Left to right, no shift
+}
+
+void LiquidCrystal_I2C::clear()
+{
+    command(0x01);
+    memset(_ddram, ' ', sizeof(_ddram));
+    _cursor = 0;
+    delayMicroseconds(2000); // The controller is busy this long; the library waits it out
+}
+
+void LiquidCrystal_I2C::home()
+{
+    command(0x02);
+    _cursor = 0;
+    delayMicroseconds(2000);
+}
+
+void LiquidCrystal_I2C::setCursor(uint8_t col, uint8_t row)
+{
+    if (row >= _rows)
+        row = _rows - 1;
+    _cursor = (uint8_t)(col + ROW_OFFSETS[row]);
+    command((uint8_t)(0x80 | _cursor));
+}
+
+void LiquidCrystal_I2C::backlight()
+{
+    _backlight = true;
+    expanderWrite(0);
+}
+
+void LiquidCrystal_I2C::noBacklight()
+{
+    _backlight = false;
+    expanderWrite(0);
+}
+
+size_t LiquidCrystal_I2C::write(uint8_t c)
+{
+    send(c, LCD_RS);
+    if (_cursor < DDRAM_SIZE)
+        _ddram[_cursor] = (char)c;
+    _characters++;
+
+    // Two-line mode: 0x00-0x27 is line 1, 0x40-0x67 line 2, and each runs into the other
+    _cursor++;
+    if (_cursor == 0x28)
+        _cursor = 0x40;
+    else if (_cursor >= 0x68)
+        _cursor = 0x00;
+    return 1;
+}
+
+std::string LiquidCrystal_I2C::shimRow(uint8_t row) const
+{
+    if (row >= _rows)
+        return std::string();
+    uint8_t start = ROW_OFFSETS[row];
+    return std::string(_ddram + start, _columns);
+}
+
+void LiquidCrystal_I2C::command(uint8_t value)
+{
+    _commands++;
+    send(value, 0);
+}
+
+void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode)
+{
+    uint8_t nibbles[2] = {(uint8_t)(value & 0xF0), (uint8_t)((value << 4) & 0xF0)};
+    for (uint8_t nibble : nibbles)
+    {
+        expanderWrite(nibble | mode);
+        expanderWrite(nibble | mode | LCD_EN);
+        expanderWrite((nibble | mode) & ~LCD_EN);
+    }
+}
+
+void LiquidCrystal_I2C::expanderWrite(uint8_t value)
+{
+    Wire.beginTransmission(_address);
+    Wire.write(value | (_backlight ? LCD_BACKLIGHT : 0));
+    Wire.endTransmission();
+}
@@ -0,0 +1,217 @@
+#include <Arduino.h>
+#include <driver/uart.h>
+
+#include <deque>
+#include <errno.h>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+
+struct UartPort
+{
+    std::mutex mutex;
+    bool installed = false;
+    size_t rxCapacity = 0;
+    std::deque<uint8_t> rx;
+    QueueHandle_t events = nullptr;
+    int baud = 0;
+    int outFd = -1;
+    bool capture = false;
+    std::string captured;
+};
+
+UartPort ports[UART_NUM_MAX];
+
+UartPort *portAt(uart_port_t port) { return port >= 0 && port < UART_NUM_MAX ? &ports[port] : nullptr; }
+
+} // namespace
+
+esp_err_t uart_driver_install(uart_port_t port, int rxBufferSize, int txBufferSize, int queueSize,
+                              QueueHandle_t *queue, int interruptFlags)
+{
+    (void)txBufferSize;
+    (void)interruptFlags;
+    UartPort *p = portAt(port);
+    if (!p || p->installed || rxBufferSize <= 0)
+        return ESP_ERR_INVALID_ARG;
+
+    std::lock_guard<std::mutex> lock(p->mutex);
+    p->installed = true;
+    p->rxCapacity = (size_t)rxBufferSize;
+    if (queue && queueSize > 0)
+    {
+        p->events = xQueueCreate(queueSize, sizeof(uart_event_t));
+        *queue = p->events;
+    }
+    return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t port, const uart_config_t *config)
+{
+    UartPort *p = portAt(port);
+    if (!p || !config)
+        return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> lock(p->mutex);
+    p->baud = config->baud_rate;
+    return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t port, int txPin, int rxPin, int rtsPin, int ctsPin)
+{
+    (void)txPin;
+    (void)rxPin;
+    (void)rtsPin;
+    (void)ctsPin;
+    return portAt(port) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+int uart_read_bytes(uart_port_t port, void *buffer, uint32_t length, TickType_t wait)
+{
+    UartPort *p = portAt(port);
+    if (!p || !p->installed)
+        return -1;
+
+    // The ingest task only reads with wait 0; a blocking read would poll like this
+    uint32_t waited = 0;
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> lock(p->mutex);
+            if (!p->rx.empty())
+            {
+                uint32_t count = 0;
+                uint8_t *out = (uint8_t *)buffer;
+                while (count < length && !p->rx.empty())
+                {
+                    out[count++] = p->rx.front();
+                    p->rx.pop_front();
+                }
+                return (int)count;
+            }
+        }
+        if (waited >= wait)
+            return 0;
+        vTaskDelay(1);
+        waited++;
+    }
+}
+
+int uart_write_bytes(uart_port_t port, const void *data, size_t length)
+{
+    UartPort *p = portAt(port);
+    if (!p || !p->installed)
+        return -1;
+
+    std::lock_guard<std::mutex> lock(p->mutex);
+    if (p->capture)
+        p->captured.append((const char *)data, length);
+    size_t done = 0;
+    while (p->outFd >= 0 && done < length)
+    {
+        ssize_t n = ::write(p->outFd, (const uint8_t *)data + done, length - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        done += (size_t)n;
+    }
+    return (int)length;
+}
+
+esp_err_t uart_flush_input(uart_port_t port)
+{
+    UartPort *p = portAt(port);
+    if (!p)
+        return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> lock(p->mutex);
+    p->rx.clear();
+    return ESP_OK;
+}
+
+namespace shim
+{
+
+void uartReceive(uart_port_t port, const uint8_t *data, size_t length)
+{
+    UartPort *p = portAt(port);
+    if (!p || !p->installed || length == 0)
+        return;
+
+    uart_event_t event = {};
+    {
+        std::lock_guard<std::mutex> lock(p->mutex);
+        if (p->rx.size() + length > p->rxCapacity)
+        {
+            event.type = UART_BUFFER_FULL;
+        }
+        else
+        {
+            p->rx.insert(p->rx.end(), data, data + length);
+            event.type = UART_DATA;
+            event.size = length;
+        }
+    }
+    if (p->events)
+        xQueueSend(p->events, &event, 0);
+}
+
+void uartAttach(uart_port_t port, int inFd, int outFd)
+{
+    UartPort *p = portAt(port);
+    if (!p)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(p->mutex);
+        p->outFd = outFd;
+    }
+    if (inFd < 0)
+        return;
+
+    std::thread([port, inFd]() {
+        // The driver posts an event per FIFO timeout or threshold, i.e. per burst of bytes
+        uint8_t buffer[120];
+        for (;;)
+        {
+            ssize_t n = ::read(inFd, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return;
+            uartReceive(port, buffer, (size_t)n);
+        }
+    }).detach();
+}
+
+void uartCapture(uart_port_t port, bool on)
+{
+    UartPort *p = portAt(port);
+    if (!p)
+        return;
+    std::lock_guard<std::mutex> lock(p->mutex);
+    p->capture = on;
+}
+
+std::string uartTakeOutput(uart_port_t port)
+{
+    UartPort *p = portAt(port);
+    if (!p)
+        return std::string();
+    std::lock_guard<std::mutex> lock(p->mutex);
+    std::string output;
+    output.swap(p->captured);
+    return output;
+}
+
+int uartBaud(uart_port_t port)
+{
+    UartPort *p = portAt(port);
+    if (!p)
+        return 0;
+    std::lock_guard<std::mutex> lock(p->mutex);
+    return p->baud;
+}
+
+} // namespace shim
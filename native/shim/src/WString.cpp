@@ -0,0 +1,92 @@
+#include "WString.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static std::string formatInteger(unsigned long long value, bool negative, unsigned char base)
+{
+    if (base < 2 || base > 36)
+        base = 10;
+    std::string digits;
+    do
+    {
+        int digit = (int)(value % base);
+        digits.insert(digits.begin(), (char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+        value /= base;
+    } while (value);
+    if (negative)
+        digits.insert(digits.begin(), '-');
+    return digits;
+}
+
+String::String(int value, unsigned char base) : String((long)value, base) {}
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base)
+    : _text(base == 10 && value < 0 ? formatInteger(0UL - (unsigned long)value, true, base)
+                                    : formatInteger((unsigned long)value, false, base))
+{
+}
+
+String::String(unsigned long value, unsigned char base) : _text(formatInteger(value, false, base)) {}
+
+String::String(double value, unsigned int decimals)
+{
+    char text[48];
+    snprintf(text, sizeof(text), "%.*f", (int)decimals, value);
+    _text = text;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+    size_t at = _text.find(c, from);
+    return at == std::string::npos ? -1 : (int)at;
+}
+
+int String::indexOf(const String &text, unsigned int from) const
+{
+    size_t at = _text.find(text._text, from);
+    return at == std::string::npos ? -1 : (int)at;
+}
+
+String String::substring(unsigned int begin, unsigned int end) const
+{
+    if (begin > end)
+    {
+        unsigned int swap = begin;
+        begin = end;
+        end = swap;
+    }
+    if (begin >= _text.size())
+        return String();
+    if (end > _text.size())
+        end = (unsigned int)_text.size();
+    return String(_text.data() + begin, end - begin);
+}
+
+void String::trim()
+{
+    size_t begin = 0;
+    while (begin < _text.size() && isspace((unsigned char)_text[begin]))
+        begin++;
+    size_t end = _text.size();
+    while (end > begin && isspace((unsigned char)_text[end - 1]))
+        end--;
+    _text = _text.substr(begin, end - begin);
+}
+
+void String::toLowerCase()
+{
+    for (char &c : _text)
+        c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase()
+{
+    for (char &c : _text)
+        c = (char)toupper((unsigned char)c);
+}
+
+long String::toInt() const { return strtol(_text.c_str(), nullptr, 10); }
+float String::toFloat() const { return strtof(_text.c_str(), nullptr); }
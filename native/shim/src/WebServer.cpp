@@ -0,0 +1,358 @@
+#include <Arduino.h>
+#include <WebServer.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// The core's timeouts (WebServer.h), in ms
+const unsigned long HTTP_MAX_DATA_WAIT = 5000;
+const unsigned long HTTP_MAX_CLOSE_WAIT = 2000;
+const size_t HTTP_MAX_HEADER_BYTES = 8192;
+
+uint16_t WebServer::shimPortOffset = 8000;
+
+static const char *statusText(int code)
+{
+    switch (code)
+    {
+    case 101: return "Switching Protocols";
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return "";
+    }
+}
+
+static std::string urlDecode(const std::string &text)
+{
+    std::string out;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        char c = text[i];
+        if (c == '+')
+        {
+            out += ' ';
+        }
+        else if (c == '%' && i + 2 < text.size() && isxdigit((unsigned char)text[i + 1]) &&
+                 isxdigit((unsigned char)text[i + 2]))
+        {
+            out += (char)strtol(text.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    return out;
+}
+
+void WebServer::begin()
+{
+    close();
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return;
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(shimPort());
+    if (bind(fd, (sockaddr *)&address, sizeof(address)) != 0 || listen(fd, 16) != 0)
+    {
+        perror("WebServer: bind/listen");
+        ::close(fd);
+        return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    _listenFd = fd;
+}
+
+void WebServer::close()
+{
+    if (_listenFd >= 0)
+        ::close(_listenFd);
+    _listenFd = -1;
+    _client = WiFiClient();
+    _status = HC_NONE;
+}
+
+void WebServer::handleClient()
+{
+    if (_listenFd < 0)
+        return;
+
+    if (_status == HC_NONE)
+    {
+        int fd = accept(_listenFd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        _client = WiFiClient(fd);
+        _status = HC_WAIT_READ;
+        _statusChange = millis();
+    }
+
+    // The same states as the core: a request is read, handled and then the connection is
+    // held until the browser closes it or HTTP_MAX_CLOSE_WAIT passes. No other client is
+    // accepted meanwhile.
+    bool keepClient = false;
+    if (_client.connected())
+    {
+        switch (_status)
+        {
+        case HC_NONE:
+            break;
+        case HC_WAIT_READ:
+            if (_client.available())
+            {
+                if (readRequest())
+                {
+                    _contentLength = CONTENT_LENGTH_NOT_SET;
+                    handleRequest();
+                    if (_client.connected())
+                    {
+                        _status = HC_WAIT_CLOSE;
+                        _statusChange = millis();
+                        keepClient = true;
+                    }
+                }
+            }
+            else if (millis() - _statusChange <= HTTP_MAX_DATA_WAIT)
+            {
+                keepClient = true;
+            }
+            break;
+        case HC_WAIT_CLOSE:
+            if (millis() - _statusChange <= HTTP_MAX_CLOSE_WAIT)
+                keepClient = true;
+            break;
+        }
+    }
+
+    if (!keepClient)
+    {
+        _client = WiFiClient();
+        _status = HC_NONE;
+    }
+}
+
+bool WebServer::readRequest()
+{
+    std::string request;
+    unsigned long started = millis();
+    while (request.find("\r\n\r\n") == std::string::npos)
+    {
+        char buffer[512];
+        int n = _client.read((uint8_t *)buffer, sizeof(buffer));
+        if (n > 0)
+        {
+            request.append(buffer, n);
+            if (request.size() > HTTP_MAX_HEADER_BYTES)
+                return false;
+            continue;
+        }
+        if (!_client.connected() || millis() - started > HTTP_MAX_DATA_WAIT)
+            return false;
+        struct pollfd p = {_client.fd(), POLLIN, 0};
+        poll(&p, 1, 10);
+    }
+
+    size_t lineEnd = request.find("\r\n");
+    std::string line = request.substr(0, lineEnd);
+    size_t space1 = line.find(' ');
+    size_t space2 = line.find(' ', space1 + 1);
+    if (space1 == std::string::npos || space2 == std::string::npos)
+        return false;
+
+    std::string method = line.substr(0, space1);
+    std::string target = line.substr(space1 + 1, space2 - space1 - 1);
+    const char *methods[] = {"", "GET", "HEAD", "POST", "PUT", "PATCH", "DELETE", "OPTIONS"};
+    _method = HTTP_GET;
+    for (int i = HTTP_GET; i <= HTTP_OPTIONS; i++)
+    {
+        if (method == methods[i])
+            _method = (HTTPMethod)i;
+    }
+
+    _args.clear();
+    size_t query = target.find('?');
+    _uri = urlDecode(target.substr(0, query));
+    if (query != std::string::npos)
+    {
+        std::string rest = target.substr(query + 1);
+        size_t start = 0;
+        while (start <= rest.size())
+        {
+            size_t end = rest.find('&', start);
+            if (end == std::string::npos)
+                end = rest.size();
+            std::string pair = rest.substr(start, end - start);
+            if (!pair.empty())
+            {
+                size_t equals = pair.find('=');
+                _args.emplace_back(urlDecode(pair.substr(0, equals)),
+                                   equals == std::string::npos ? std::string() : urlDecode(pair.substr(equals + 1)));
+            }
+            start = end + 1;
+        }
+    }
+
+    // Like the core, only the headers named in collectHeaders() are kept
+    _headers.clear();
+    size_t position = lineEnd + 2;
+    for (;;)
+    {
+        size_t end = request.find("\r\n", position);
+        if (end == std::string::npos || end == position)
+            break;
+        std::string header = request.substr(position, end - position);
+        position = end + 2;
+        size_t colon = header.find(':');
+        if (colon == std::string::npos)
+            continue;
+        std::string name = header.substr(0, colon);
+        size_t valueStart = header.find_first_not_of(' ', colon + 1);
+        std::string value = valueStart == std::string::npos ? std::string() : header.substr(valueStart);
+        for (const std::string &collected : _collected)
+        {
+            if (strcasecmp(collected.c_str(), name.c_str()) == 0)
+                _headers.emplace_back(collected, value);
+        }
+    }
+    return true;
+}
+
+void WebServer::handleRequest()
+{
+    _responseHeaders.clear();
+    _chunked = false;
+    for (Route &route : _routes)
+    {
+        if (route.uri == _uri && (route.method == HTTP_ANY || route.method == _method))
+        {
+            route.handler();
+            return;
+        }
+    }
+    if (_notFound)
+        _notFound();
+    else
+        send(404, "text/plain", String("Not found: ") + _uri.c_str());
+}
+
+String WebServer::arg(const char *name) const
+{
+    for (const auto &pair : _args)
+    {
+        if (pair.first == name)
+            return String(pair.second.c_str(), pair.second.size());
+    }
+    return String();
+}
+
+bool WebServer::hasArg(const char *name) const
+{
+    for (const auto &pair : _args)
+    {
+        if (pair.first == name)
+            return true;
+    }
+    return false;
+}
+
+String WebServer::header(const char *name) const
+{
+    for (const auto &pair : _headers)
+    {
+        if (strcasecmp(pair.first.c_str(), name) == 0)
+            return String(pair.second.c_str(), pair.second.size());
+    }
+    return String();
+}
+
+void WebServer::collectHeaders(const char *headerKeys[], size_t count)
+{
+    _collected.clear();
+    for (size_t i = 0; i < count; i++)
+        _collected.push_back(headerKeys[i]);
+}
+
+void WebServer::sendHeader(const String &name, const String &value, bool first)
+{
+    std::string line = std::string(name.c_str()) + ": " + value.c_str() + "\r\n";
+    if (first)
+        _responseHeaders.insert(0, line);
+    else
+        _responseHeaders += line;
+}
+
+void WebServer::sendHeaders(int code, const char *contentType, size_t length)
+{
+    char status[64];
+    snprintf(status, sizeof(status), "HTTP/1.1 %d %s\r\n", code, statusText(code));
+    std::string head = status;
+    head += "Content-Type: ";
+    head += contentType ? contentType : "text/html";
+    head += "\r\n";
+
+    if (_contentLength == CONTENT_LENGTH_NOT_SET)
+        _contentLength = length;
+    if (_contentLength == CONTENT_LENGTH_UNKNOWN)
+    {
+        head += "Transfer-Encoding: chunked\r\n";
+        _chunked = true;
+    }
+    else
+    {
+        head += "Content-Length: " + std::to_string(_contentLength) + "\r\n";
+    }
+    head += _responseHeaders;
+    head += "Connection: close\r\n\r\n";
+
+    _client.write((const uint8_t *)head.data(), head.size());
+    _responseHeaders.clear();
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+}
+
+void WebServer::send(int code, const char *contentType, const String &content)
+{
+    sendHeaders(code, contentType, content.length());
+    if (content.length() > 0)
+        sendContent(content.c_str(), content.length());
+}
+
+void WebServer::send_P(int code, const char *contentType, const char *content, size_t length)
+{
+    sendHeaders(code, contentType, length);
+    if (length > 0)
+        sendContent(content, length);
+}
+
+void WebServer::sendContent(const char *content, size_t length)
+{
+    if (_chunked)
+    {
+        char size[16];
+        int n = snprintf(size, sizeof(size), "%zx\r\n", length);
+        _client.write((const uint8_t *)size, n);
+    }
+    _client.write((const uint8_t *)content, length);
+    if (_chunked)
+    {
+        _client.write((const uint8_t *)"\r\n", 2);
+        if (length == 0)
+            _chunked = false;
+    }
+}
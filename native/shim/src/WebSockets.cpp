@@ -0,0 +1,384 @@
+#include <Arduino.h>
+#include <WebServer.h>
+#include <WebSocketsServer.h>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+const unsigned long WEBSOCKETS_TCP_TIMEOUT = 5000; // Handshake deadline, in ms
+const size_t WEBSOCKETS_MAX_INPUT = 16384;
+
+enum : uint8_t
+{
+    WS_OP_CONTINUATION = 0x0,
+    WS_OP_TEXT = 0x1,
+    WS_OP_BINARY = 0x2,
+    WS_OP_CLOSE = 0x8,
+    WS_OP_PING = 0x9,
+    WS_OP_PONG = 0xA
+};
+
+/** SHA-1 of the handshake key, as RFC 6455 requires */
+static void sha1(const std::string &message, uint8_t digest[20])
+{
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::string data = message;
+    uint64_t bits = (uint64_t)message.size() * 8;
+    data += (char)0x80;
+    while (data.size() % 64 != 56)
+        data += (char)0;
+    for (int i = 7; i >= 0; i--)
+        data += (char)(bits >> (i * 8));
+
+    auto rotate = [](uint32_t value, int shift) { return (value << shift) | (value >> (32 - shift)); };
+    for (size_t block = 0; block < data.size(); block += 64)
+    {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++)
+        {
+            const uint8_t *p = (const uint8_t *)data.data() + block + i * 4;
+            w[i] = (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+        }
+        for (int i = 16; i < 80; i++)
+            w[i] = rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++)
+        {
+            uint32_t f, k;
+            if (i < 20)
+            {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            }
+            else if (i < 40)
+            {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            }
+            else if (i < 60)
+            {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            }
+            else
+            {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t t = rotate(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotate(b, 30);
+            b = a;
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+    for (int i = 0; i < 20; i++)
+        digest[i] = (uint8_t)(h[i / 4] >> (24 - (i % 4) * 8));
+}
+
+static std::string base64(const uint8_t *data, size_t length)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < length; i += 3)
+    {
+        uint32_t chunk = (uint32_t)data[i] << 16;
+        if (i + 1 < length)
+            chunk |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < length)
+            chunk |= data[i + 2];
+        out += alphabet[(chunk >> 18) & 63];
+        out += alphabet[(chunk >> 12) & 63];
+        out += i + 1 < length ? alphabet[(chunk >> 6) & 63] : '=';
+        out += i + 2 < length ? alphabet[chunk & 63] : '=';
+    }
+    return out;
+}
+
+void WebSocketsServer::begin()
+{
+    close();
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return;
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)(_port + WebServer::shimPortOffset));
+    if (bind(fd, (sockaddr *)&address, sizeof(address)) != 0 || listen(fd, 8) != 0)
+    {
+        perror("WebSocketsServer: bind/listen");
+        ::close(fd);
+        return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    _listenFd = fd;
+}
+
+void WebSocketsServer::close()
+{
+    if (_listenFd >= 0)
+        ::close(_listenFd);
+    _listenFd = -1;
+    for (Client &client : _clients)
+        client = Client();
+}
+
+void WebSocketsServer::loop()
+{
+    if (_listenFd < 0)
+        return;
+    accept();
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++)
+    {
+        Client &client = _clients[num];
+        if (client.tcp.fd() < 0)
+            continue;
+        if (!client.tcp.connected())
+        {
+            drop(num);
+            continue;
+        }
+        if (client.upgraded)
+            receive(num);
+        else
+            handshake(num);
+    }
+}
+
+void WebSocketsServer::accept()
+{
+    for (;;)
+    {
+        int fd = ::accept(_listenFd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        WiFiClient tcp(fd);
+        bool placed = false;
+        for (Client &client : _clients)
+        {
+            if (client.tcp.fd() < 0)
+            {
+                client = Client();
+                client.tcp = tcp;
+                client.since = millis();
+                placed = true;
+                break;
+            }
+        }
+        if (!placed)
+        {
+            const char busy[] = "HTTP/1.1 503 Service Unavailable\r\nServer: arduino-WebSocket-Server\r\n"
+                                "Content-Type: text/plain\r\nContent-Length: 32\r\nConnection: close\r\n"
+                                "Sec-WebSocket-Version: 13\r\n\r\nThis is a Websocket server only!";
+            tcp.write((const uint8_t *)busy, sizeof(busy) - 1);
+        }
+    }
+}
+
+void WebSocketsServer::handshake(uint8_t num)
+{
+    Client &client = _clients[num];
+    uint8_t buffer[512];
+    int n;
+    while ((n = client.tcp.read(buffer, sizeof(buffer))) > 0)
+        client.input.append((const char *)buffer, n);
+
+    size_t end = client.input.find("\r\n\r\n");
+    if (end == std::string::npos)
+    {
+        if (client.input.size() > WEBSOCKETS_MAX_INPUT || millis() - client.since > WEBSOCKETS_TCP_TIMEOUT)
+            client = Client();
+        return;
+    }
+
+    std::string head = client.input.substr(0, end + 2);
+    client.input.erase(0, end + 4);
+    std::string key;
+    size_t position = head.find("\r\n") + 2;
+    std::string url = head.substr(head.find(' ') + 1);
+    url = url.substr(0, url.find(' '));
+    while (position < head.size())
+    {
+        size_t lineEnd = head.find("\r\n", position);
+        std::string line = head.substr(position, lineEnd - position);
+        position = lineEnd + 2;
+        size_t colon = line.find(':');
+        if (colon != std::string::npos && strcasecmp(line.substr(0, colon).c_str(), "Sec-WebSocket-Key") == 0)
+        {
+            size_t start = line.find_first_not_of(' ', colon + 1);
+            key = start == std::string::npos ? std::string() : line.substr(start);
+        }
+    }
+    if (key.empty())
+    {
+        const char reply[] = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        client.tcp.write((const uint8_t *)reply, sizeof(reply) - 1);
+        client = Client();
+        return;
+    }
+
+    uint8_t digest[20];
+    sha1(key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11", digest);
+    std::string reply = "HTTP/1.1 101 Switching Protocols\r\nServer: arduino-WebSocketsServer\r\n"
+                        "Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Version: 13\r\n"
+                        "Sec-WebSocket-Accept: " + base64(digest, sizeof(digest)) + "\r\n\r\n";
+    client.tcp.write((const uint8_t *)reply.data(), reply.size());
+    client.upgraded = true;
+    if (_event)
+        _event(num, WStype_CONNECTED, (uint8_t *)url.c_str(), url.size());
+}
+
+void WebSocketsServer::receive(uint8_t num)
+{
+    Client &client = _clients[num];
+    uint8_t buffer[512];
+    int n;
+    while ((n = client.tcp.read(buffer, sizeof(buffer))) > 0)
+        client.input.append((const char *)buffer, n);
+
+    // Whole frames only; clients must mask theirs
+    while (client.upgraded && client.input.size() >= 2)
+    {
+        const uint8_t *data = (const uint8_t *)client.input.data();
+        uint8_t opcode = data[0] & 0x0F;
+        bool masked = data[1] & 0x80;
+        uint64_t length = data[1] & 0x7F;
+        size_t header = 2;
+        if (length == 126)
+        {
+            if (client.input.size() < 4)
+                return;
+            length = (uint64_t)data[2] << 8 | data[3];
+            header = 4;
+        }
+        else if (length == 127)
+        {
+            if (client.input.size() < 10)
+                return;
+            length = 0;
+            for (int i = 0; i < 8; i++)
+                length = length << 8 | data[2 + i];
+            header = 10;
+        }
+        if (!masked || length > WEBSOCKETS_MAX_INPUT)
+        {
+            drop(num);
+            return;
+        }
+        if (client.input.size() < header + 4 + length)
+        {
+            return;
+        }
+
+        const uint8_t *mask = data + header;
+        std::string payload(client.input, header + 4, (size_t)length);
+        for (size_t i = 0; i < payload.size(); i++)
+            payload[i] = (char)(payload[i] ^ mask[i % 4]);
+        client.input.erase(0, header + 4 + (size_t)length);
+
+        switch (opcode)
+        {
+        case WS_OP_TEXT:
+        case WS_OP_BINARY:
+            if (_event)
+                _event(num, opcode == WS_OP_TEXT ? WStype_TEXT : WStype_BIN, (uint8_t *)&payload[0], payload.size());
+            break;
+        case WS_OP_PING:
+            sendFrame(num, WS_OP_PONG, (const uint8_t *)payload.data(), payload.size());
+            break;
+        case WS_OP_CLOSE:
+            sendFrame(num, WS_OP_CLOSE, nullptr, 0);
+            drop(num);
+            return;
+        default:
+            break;
+        }
+    }
+}
+
+bool WebSocketsServer::sendFrame(uint8_t num, uint8_t opcode, const uint8_t *payload, size_t length)
+{
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || !_clients[num].upgraded)
+        return false;
+    uint8_t header[10];
+    size_t headerLength = 2;
+    header[0] = (uint8_t)(0x80 | opcode);
+    if (length < 126)
+    {
+        header[1] = (uint8_t)length;
+    }
+    else if (length <= 0xFFFF)
+    {
+        header[1] = 126;
+        header[2] = (uint8_t)(length >> 8);
+        header[3] = (uint8_t)length;
+        headerLength = 4;
+    }
+    else
+    {
+        header[1] = 127;
+        for (int i = 0; i < 8; i++)
+            header[2 + i] = (uint8_t)((uint64_t)length >> (56 - i * 8));
+        headerLength = 10;
+    }
+    WiFiClient &tcp = _clients[num].tcp;
+    return tcp.write(header, headerLength) == headerLength && (length == 0 || tcp.write(payload, length) == length);
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, const char *payload, size_t length)
+{
+    if (length == 0)
+        length = strlen(payload);
+    return sendFrame(num, WS_OP_TEXT, (const uint8_t *)payload, length);
+}
+
+bool WebSocketsServer::broadcastTXT(const char *payload, size_t length)
+{
+    if (length == 0)
+        length = strlen(payload);
+    bool all = true;
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++)
+    {
+        if (_clients[num].upgraded)
+            all &= sendFrame(num, WS_OP_TEXT, (const uint8_t *)payload, length);
+    }
+    return all;
+}
+
+void WebSocketsServer::disconnect(uint8_t num)
+{
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || !_clients[num].upgraded)
+        return;
+    sendFrame(num, WS_OP_CLOSE, nullptr, 0);
+    drop(num);
+}
+
+uint8_t WebSocketsServer::connectedClients()
+{
+    uint8_t count = 0;
+    for (Client &client : _clients)
+        count += client.upgraded;
+    return count;
+}
+
+void WebSocketsServer::drop(uint8_t num)
+{
+    bool wasUpgraded = _clients[num].upgraded;
+    _clients[num] = Client();
+    if (wasUpgraded && _event)
+        _event(num, WStype_DISCONNECTED, nullptr, 0);
+}
@@ -0,0 +1,181 @@
+#include <Arduino.h>
+#include <WiFi.h>
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+namespace shim
+{
+
+WiFiModel &wifi()
+{
+    static WiFiModel instance;
+    return instance;
+}
+
+void WiFiModel::raise(arduino_event_id_t event)
+{
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP)
+        _connected = true;
+    else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED || event == ARDUINO_EVENT_WIFI_STA_LOST_IP)
+        _connected = false;
+
+    arduino_event_info_t info = {};
+    for (Handler &handler : _handlers)
+    {
+        if (handler.event == ARDUINO_EVENT_MAX || handler.event == event)
+            handler.callback(event, info);
+    }
+}
+
+void WiFiModel::dropLink()
+{
+    _attempt++;
+    raise(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
+
+void WiFiModel::dropLinkSilently()
+{
+    _attempt++;
+    _connected = false;
+}
+
+} // namespace shim
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *password)
+{
+    (void)ssid;
+    (void)password;
+    shim::WiFiModel &model = shim::wifi();
+    model._begins++;
+    uint32_t attempt = ++model._attempt;
+    if (!model._reachable)
+        return WL_DISCONNECTED;
+
+    shim::clock().at(shim::clock().micros() + model.connectDelayMicros, [attempt]() {
+        shim::WiFiModel &model = shim::wifi();
+        if (attempt != model._attempt || !model._reachable)
+            return;
+        model.raise(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+        model.raise(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    });
+    return WL_DISCONNECTED;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp)
+{
+    (void)wifiOff;
+    (void)eraseAp;
+    shim::WiFiModel &model = shim::wifi();
+    model._disconnects++;
+    model._attempt++;
+    bool wasConnected = model._connected;
+    model._connected = false;
+    // The driver reports its own teardown
+    if (wasConnected)
+        model.raise(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    return true;
+}
+
+wl_status_t WiFiClass::status() { return shim::wifi().connected() ? WL_CONNECTED : WL_DISCONNECTED; }
+
+int WiFiClass::onEvent(WiFiEventFuncCb callback, arduino_event_id_t event)
+{
+    shim::wifi()._handlers.push_back({callback, event});
+    return (int)shim::wifi()._handlers.size();
+}
+
+// --- WiFiClient ---
+
+WiFiClient::Socket::~Socket()
+{
+    if (fd >= 0)
+        ::close(fd);
+}
+
+WiFiClient::WiFiClient(int fd) : _socket(std::make_shared<Socket>(fd))
+{
+    // A stalled peer must not block loop() forever; lwIP gives up on a send the same way
+    struct timeval timeout = {5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+uint8_t WiFiClient::connected()
+{
+    if (!_socket || _socket->fd < 0)
+        return 0;
+    char c;
+    ssize_t n = recv(_socket->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+    {
+        stop();
+        return 0;
+    }
+    return 1;
+}
+
+void WiFiClient::stop() { _socket.reset(); }
+
+void WiFiClient::setNoDelay(bool noDelay)
+{
+    int on = noDelay ? 1 : 0;
+    if (_socket && _socket->fd >= 0)
+        setsockopt(_socket->fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+int WiFiClient::available()
+{
+    if (!_socket || _socket->fd < 0)
+        return 0;
+    struct pollfd p = {_socket->fd, POLLIN, 0};
+    if (poll(&p, 1, 0) <= 0)
+        return 0;
+    char buffer[512];
+    ssize_t n = recv(_socket->fd, buffer, sizeof(buffer), MSG_PEEK | MSG_DONTWAIT);
+    return n > 0 ? (int)n : 0;
+}
+
+int WiFiClient::read()
+{
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t length)
+{
+    if (!_socket || _socket->fd < 0)
+        return -1;
+    ssize_t n = recv(_socket->fd, buffer, length, MSG_DONTWAIT);
+    return n > 0 ? (int)n : -1;
+}
+
+int WiFiClient::peek()
+{
+    if (!_socket || _socket->fd < 0)
+        return -1;
+    uint8_t c;
+    return recv(_socket->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+size_t WiFiClient::write(const uint8_t *data, size_t length)
+{
+    if (!_socket || _socket->fd < 0)
+        return 0;
+    size_t done = 0;
+    while (done < length)
+    {
+        ssize_t n = send(_socket->fd, data + done, length - done, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        done += (size_t)n;
+    }
+    return done;
+}
@@ -0,0 +1,96 @@
+#include "AllocCounter.h"
+
+#include <atomic>
+#include <malloc.h>
+#include <stddef.h>
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define ALLOC_COUNTER_ACTIVE 0
+#else
+#define ALLOC_COUNTER_ACTIVE 1
+#endif
+
+namespace
+{
+
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocatedBytes{0};
+std::atomic<int64_t> inUseBytes{0};
+
+void counted(void *pointer, size_t requested)
+{
+    if (!pointer)
+        return;
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(requested, std::memory_order_relaxed);
+    inUseBytes.fetch_add((int64_t)malloc_usable_size(pointer), std::memory_order_relaxed);
+}
+
+void released(void *pointer)
+{
+    if (pointer)
+        inUseBytes.fetch_sub((int64_t)malloc_usable_size(pointer), std::memory_order_relaxed);
+}
+
+} // namespace
+
+namespace alloc_counter
+{
+
+bool active() { return ALLOC_COUNTER_ACTIVE; }
+uint64_t allocations() { return allocationCount.load(std::memory_order_relaxed); }
+uint64_t bytesAllocated() { return allocatedBytes.load(std::memory_order_relaxed); }
+int64_t bytesInUse() { return inUseBytes.load(std::memory_order_relaxed); }
+
+} // namespace alloc_counter
+
+#if ALLOC_COUNTER_ACTIVE
+
+extern "C"
+{
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void __libc_free(void *pointer);
+
+void *malloc(size_t size)
+{
+    void *pointer = __libc_malloc(size);
+    counted(pointer, size);
+    return pointer;
+}
+
+void *calloc(size_t count, size_t size)
+{
+    void *pointer = __libc_calloc(count, size);
+    counted(pointer, count * size);
+    return pointer;
+}
+
+void *realloc(void *pointer, size_t size)
+{
+    released(pointer);
+    void *moved = __libc_realloc(pointer, size);
+    if (moved && moved != pointer)
+    {
+        counted(moved, size);
+    }
+    else if (moved)
+    {
+        inUseBytes.fetch_add((int64_t)malloc_usable_size(moved), std::memory_order_relaxed);
+    }
+    else if (pointer && size)
+    {
+        inUseBytes.fetch_add((int64_t)malloc_usable_size(pointer), std::memory_order_relaxed); // Failed, still held
+    }
+    return moved;
+}
+
+void free(void *pointer)
+{
+    released(pointer);
+    __libc_free(pointer);
+}
+}
+
+#endif
@@ -0,0 +1,29 @@
+/**
+ * @file AllocCounter.h
+ * @brief Process-wide heap allocation counters for host tests and benchmarks.
+ * Linking alloc_counter interposes glibc's malloc/calloc/realloc/free, so every heap
+ * allocation is counted, including those behind operator new and std::string (and so
+ * the shim's String). Sanitizer builds bring their own allocator; there active() is
+ * false and the counters stay at zero.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace alloc_counter
+{
+
+/** Whether allocations are being counted in this build */
+bool active();
+
+/** Allocations since the process started (realloc counts as one when it moves or grows from null) */
+uint64_t allocations();
+
+/** Bytes requested by those allocations */
+uint64_t bytesAllocated();
+
+/** Usable bytes currently allocated and not yet freed */
+int64_t bytesInUse();
+
+} // namespace alloc_counter
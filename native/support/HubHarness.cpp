@@ -0,0 +1,208 @@
+#include "HubHarness.h"
+
+#include <Arduino.h>
+#include <HubLink.h>
+#include <LittleFS.h>
+#include <WebServer.h>
+#include <driver/uart.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+
+// ESP32.ino
+extern bool webStarted;
+extern uint32_t sampleSeq;
+extern WebServer server;
+
+namespace harness
+{
+
+const uint16_t HTTP_SERVER_PORT = 80; // HTTP_SERVER_PORT in ESP32.ino
+const std::chrono::seconds SAMPLE_TIMEOUT(5);
+const size_t RESPONSE_STEPS = 20000;
+
+std::string HttpResponse::header(const std::string &name) const
+{
+    size_t position = headers.find("\r\n");
+    while (position != std::string::npos && position + 2 < headers.size())
+    {
+        size_t start = position + 2;
+        size_t end = headers.find("\r\n", start);
+        std::string line = headers.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos && strcasecmp(line.substr(0, colon).c_str(), name.c_str()) == 0)
+        {
+            size_t value = line.find_first_not_of(' ', colon + 1);
+            return value == std::string::npos ? std::string() : line.substr(value);
+        }
+        position = end;
+    }
+    return std::string();
+}
+
+void boot()
+{
+    static bool booted = false;
+    if (booted)
+        return;
+    booted = true;
+
+    char fsRoot[] = "/tmp/hub_littlefs_XXXXXX";
+    if (mkdtemp(fsRoot))
+        LittleFS.shimSetRoot(fsRoot);
+    // Below Linux's ephemeral range (32768 up), where a lingering client port of an earlier
+    // test process could still hold the address
+    WebServer::shimPortOffset = (uint16_t)(10000 + getpid() % 20000);
+    shim::clock().useManual(0);
+
+    setup();
+    for (int i = 0; i < 1000 && !webStarted; i++)
+        step(1);
+}
+
+uint16_t httpPort() { return (uint16_t)(HTTP_SERVER_PORT + WebServer::shimPortOffset); }
+
+void step(unsigned long ms)
+{
+    shim::clock().advance((uint64_t)ms * 1000);
+    loop();
+}
+
+bool sendSample(int16_t current, int16_t min, int16_t max)
+{
+    static uint8_t seq = 0;
+    HubLinkFrame frame;
+    hubLinkMakeTelemetry(frame, seq++, current, min, max);
+    uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+    size_t length = hubLinkEncode(frame, wire);
+
+    // The ingest task decodes on its own thread, so wait in real time for loop() to see the sample
+    uint32_t before = sampleSeq;
+    shim::uartReceive(UART_NUM_2, wire, length);
+    auto deadline = std::chrono::steady_clock::now() + SAMPLE_TIMEOUT;
+    while (sampleSeq == before)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        loop();
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+int connectHttp()
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(httpPort());
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr *)&address, sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return fd;
+}
+
+bool drain(int fd, std::string &out)
+{
+    char buffer[4096];
+    for (;;)
+    {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0)
+        {
+            out.append(buffer, n);
+            continue;
+        }
+        if (n == 0)
+            return false;
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+}
+
+/** Splits a raw response once it is complete; false while more is expected */
+static bool parseResponse(const std::string &raw, bool peerClosed, HttpResponse &response)
+{
+    size_t headerEnd = raw.find("\r\n\r\n");
+    if (headerEnd == std::string::npos)
+        return false;
+    response.headers = raw.substr(0, headerEnd);
+    response.status = atoi(raw.c_str() + raw.find(' ') + 1);
+    response.wireBytes = raw.size();
+    std::string rest = raw.substr(headerEnd + 4);
+
+    if (strcasecmp(response.header("Transfer-Encoding").c_str(), "chunked") == 0)
+    {
+        std::string body;
+        size_t position = 0;
+        for (;;)
+        {
+            size_t lineEnd = rest.find("\r\n", position);
+            if (lineEnd == std::string::npos)
+                return false;
+            size_t size = strtoul(rest.c_str() + position, nullptr, 16);
+            if (rest.size() < lineEnd + 2 + size + 2)
+                return false;
+            if (size == 0)
+                break;
+            body.append(rest, lineEnd + 2, size);
+            position = lineEnd + 2 + size + 2;
+        }
+        response.body = body;
+        return true;
+    }
+
+    std::string length = response.header("Content-Length");
+    if (length.empty())
+    {
+        response.body = rest;
+        return peerClosed;
+    }
+    if (rest.size() < (size_t)atol(length.c_str()))
+        return false;
+    response.body = rest.substr(0, atol(length.c_str()));
+    return true;
+}
+
+HttpResponse get(const std::string &target, const std::string &extraHeaders)
+{
+    HttpResponse response;
+    int fd = connectHttp();
+    if (fd < 0)
+        return response;
+    std::string request = "GET " + target + " HTTP/1.1\r\nHost: hub\r\n" + extraHeaders + "Connection: close\r\n\r\n";
+    send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+
+    std::string raw;
+    for (size_t i = 0; i < RESPONSE_STEPS; i++)
+    {
+        loop();
+        bool open = drain(fd, raw);
+        if (parseResponse(raw, !open, response))
+            break;
+        if (!open)
+            break;
+        // Real time for the loopback socket, no virtual time: a response must not depend on the clock
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    close(fd);
+    loop(); // The server sees the close and is free for the next client
+    return response;
+}
+
+} // namespace harness
@@ -0,0 +1,55 @@
+/**
+ * @file HubHarness.h
+ * @brief Drives ESP32.ino in-process for tests and benchmarks: boots it on the manual
+ * virtual clock with an empty LittleFS directory, feeds Nano telemetry into UART2 and
+ * talks HTTP to its WebServer over loopback.
+ *
+ * The sketch is single-instance (its globals are the hub), so boot() runs once per
+ * process. Its HTTP and WebSocket ports are shifted by a per-process offset so tests
+ * can run in parallel.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace harness
+{
+
+struct HttpResponse
+{
+    int status = 0;
+    std::string headers; // Raw header block, status line included
+    std::string body;    // De-chunked
+    size_t wireBytes = 0;
+
+    /** Value of a response header, "" if absent (case-insensitive name) */
+    std::string header(const std::string &name) const;
+};
+
+/** setup(), then loop() until WiFi is up and the servers listen; LittleFS gets a fresh temp directory */
+void boot();
+
+uint16_t httpPort();
+
+/** Advances the virtual clock by ms and runs loop() once */
+void step(unsigned long ms = 1);
+
+/** Sends one HubLink telemetry frame to UART2 and runs loop() until the hub has accepted it */
+bool sendSample(int16_t current, int16_t min, int16_t max);
+
+/** Opens a blocking TCP connection to the hub's HTTP port; -1 on failure */
+int connectHttp();
+
+/**
+ * @brief One request on a new connection, running loop() until the response is complete.
+ * The connection is closed afterwards, as a browser would with Connection: close.
+ */
+HttpResponse get(const std::string &target, const std::string &extraHeaders = std::string());
+
+/** Reads whatever fd has without blocking and appends it to out; false once the peer has closed */
+bool drain(int fd, std::string &out);
+
+} // namespace harness
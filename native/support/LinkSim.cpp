@@ -0,0 +1,465 @@
+#include "LinkSim.h"
+
+#include <HubLink.h>
+#include "CommandReader.h"
+#include "TelemetryParser.h"
+#include "UartIngest.h"
+
+#include <algorithm>
+#include <deque>
+#include <math.h>
+#include <random>
+#include <string.h>
+#include <string>
+
+namespace linksim
+{
+
+namespace
+{
+
+// Arduino_Nano.ino
+const uint32_t SENSOR_INTERVAL_MS = 2000;
+const uint32_t NANO_JITTER_MICROS = 2000; // How late a scheduler pass may start the send
+
+// ESP-IDF UART driver defaults: a burst is handed to the ingest task once the line has been
+// idle this many character times, or in pieces once the hardware FIFO holds this many bytes
+const uint32_t DRIVER_RX_TIMEOUT_SYMBOLS = 10;
+const size_t DRIVER_FIFO_THRESHOLD = 120;
+
+// Sent samples searched for a delivered one's values; sampleFor() repeats only every 4200
+const size_t MATCH_WINDOW = 2048;
+
+struct RxByte
+{
+    uint8_t value;
+    bool framingError;
+    uint64_t micros; // When the receiver has it: the end of its stop bit at the receiver's rate
+};
+
+/**
+ * @brief One burst of back-to-back bytes through a UART whose ends may disagree on the rate.
+ * The transmitter shifts 10 bits per byte (start, 8 data LSB first, stop) at txBaud. The
+ * receiver waits for a falling edge, then samples the middle of each of its own bit times
+ * at rxBaud; a stop bit read as 0 is a framing error, and it looks for the next start edge
+ * from there, possibly in the middle of a byte.
+ */
+std::vector<RxByte> transmit(const std::vector<uint8_t> &bytes, uint64_t startMicros, uint32_t txBaud, uint32_t rxBaud)
+{
+    const int64_t bitCount = (int64_t)bytes.size() * 10;
+    auto level = [&](int64_t bit) -> int {
+        if (bit < 0 || bit >= bitCount)
+            return 1; // Idle line
+        int64_t position = bit % 10;
+        if (position == 0)
+            return 0;
+        if (position == 9)
+            return 1;
+        return (bytes[bit / 10] >> (position - 1)) & 1;
+    };
+
+    const double txBit = 1.0 / txBaud;
+    const double rxBit = 1.0 / rxBaud;
+    auto levelAt = [&](double seconds) { return level((int64_t)floor(seconds / txBit)); };
+
+    std::vector<RxByte> received;
+    double searchFrom = 0;
+    for (;;)
+    {
+        int64_t edge = (int64_t)ceil(searchFrom / txBit - 1e-9);
+        while (edge < bitCount && !(level(edge - 1) == 1 && level(edge) == 0))
+            edge++;
+        if (edge >= bitCount)
+            break;
+
+        double start = edge * txBit;
+        uint8_t value = 0;
+        for (int bit = 0; bit < 8; bit++)
+            value |= (uint8_t)(levelAt(start + (bit + 1.5) * rxBit) << bit);
+        bool stop = levelAt(start + 9.5 * rxBit);
+        received.push_back({value, !stop, startMicros + (uint64_t)((start + 10 * rxBit) * 1e6)});
+        searchFrom = start + 9.5 * rxBit;
+    }
+    return received;
+}
+
+/** The first time at or after micros outside the stall windows [k * every, k * every + length), k >= 1 */
+uint64_t afterStall(uint64_t micros, uint32_t lengthMs, uint32_t everySeconds)
+{
+    if (!lengthMs || !everySeconds)
+        return micros;
+    uint64_t every = (uint64_t)everySeconds * 1000000;
+    uint64_t start = micros / every * every;
+    uint64_t length = (uint64_t)lengthMs * 1000;
+    return start > 0 && micros < start + length ? start + length : micros;
+}
+
+/** What the Nano sends for telemetry sample n: distinct over lcm(600, 50, 70) samples, so they can be matched up */
+TelemetrySample sampleFor(uint32_t n)
+{
+    int16_t current = (int16_t)(200 + (n * 37) % 600);
+    return {current, (int16_t)(current - 1 - (int16_t)(n % 50)), (int16_t)(current + 1 + (int16_t)(n % 70))};
+}
+
+bool sameSample(const TelemetrySample &a, const TelemetrySample &b)
+{
+    return a.current == b.current && a.min == b.min && a.max == b.max;
+}
+
+/** Tenths as Serial.print(value, 1) prints the float they came from */
+std::string tenths(int16_t value)
+{
+    char text[16];
+    snprintf(text, sizeof(text), "%s%d.%d", value < 0 ? "-" : "", abs(value) / 10, abs(value) % 10);
+    return text;
+}
+
+/** sendTelemetry() in Arduino_Nano.ino */
+std::vector<uint8_t> encodeTelemetry(Format format, uint8_t seq, const TelemetrySample &sample)
+{
+    if (format == Format::Binary)
+    {
+        HubLinkFrame frame;
+        hubLinkMakeTelemetry(frame, seq, sample.current, sample.min, sample.max);
+        uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+        size_t length = hubLinkEncode(frame, wire);
+        return std::vector<uint8_t>(wire, wire + length);
+    }
+    std::string line = "[DHT11] Current = " + tenths(sample.current) + ", Min = " + tenths(sample.min) +
+                       ", Max = " + tenths(sample.max) + ",\r\n";
+    return std::vector<uint8_t>(line.begin(), line.end());
+}
+
+struct Command
+{
+    bool reset;
+    std::string text;
+};
+
+/** forwardReset() / forwardMessage() in ESP32.ino */
+std::vector<uint8_t> encodeCommand(Format format, uint8_t seq, const Command &command)
+{
+    if (format == Format::Binary)
+    {
+        HubLinkFrame frame;
+        hubLinkMakeCommand(frame, command.reset ? HUBLINK_RESET : HUBLINK_MESSAGE, seq,
+                           command.text.c_str(), command.text.size());
+        uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+        size_t length = hubLinkEncode(frame, wire);
+        return std::vector<uint8_t>(wire, wire + length);
+    }
+    std::string line = command.reset ? "R:1\r\n" : "M:" + command.text + "\r\n";
+    return std::vector<uint8_t>(line.begin(), line.end());
+}
+
+/** The ESP32 end: UART driver buffer, ingest task and loop() draining the ring */
+class Hub
+{
+public:
+    Hub(const Config &config, const std::vector<std::pair<TelemetrySample, uint64_t>> &sent, Report &report)
+        : _config(config), _sent(sent), _report(report)
+    {
+        LinkFaultConfig faults = config.faults;
+        faults.seed = config.seed ^ 0x9E3779B9u;
+        _faults.begin(faults);
+    }
+
+    /** The driver hands over a chunk at micros; the task reads it now or when its stall ends */
+    void receive(const std::vector<uint8_t> &chunk, uint64_t micros)
+    {
+        if (!_events.empty() && _resumeAt <= micros)
+            readDriver(_resumeAt);
+
+        if (_buffer.size() + chunk.size() > (size_t)UART_INGEST_RX_BUFFER)
+        {
+            postEvent(UART_BUFFER_FULL);
+        }
+        else
+        {
+            _buffer.insert(_buffer.end(), chunk.begin(), chunk.end());
+            postEvent(UART_DATA);
+        }
+        _resumeAt = afterStall(micros, _config.ingestStallMs, _config.ingestStallEverySeconds);
+        if (_resumeAt == micros)
+            readDriver(micros);
+    }
+
+    /** Lets everything still buffered or queued reach loop() */
+    void finish()
+    {
+        if (!_events.empty())
+            readDriver(_resumeAt);
+        while (!_ring.empty())
+            take();
+
+        _report.rejectedFrames = _decoder.rejectedFrames();
+        _report.malformedLines = _parser.malformedLines();
+        _report.sequenceGaps = _sequence.gaps();
+        _report.senderRestarts = _sequence.restarts();
+        _report.faultDrops = _faults.droppedBytes();
+        _report.faultFlips = _faults.flippedBits();
+    }
+
+private:
+    void postEvent(uart_event_type_t type)
+    {
+        if (_events.size() < (size_t)UART_INGEST_EVENT_QUEUE)
+            _events.push_back(type); // A full queue loses the event; the bytes stay buffered
+    }
+
+    /** UartIngest::run() working through its event queue at micros */
+    void readDriver(uint64_t micros)
+    {
+        for (uart_event_type_t event : _events)
+        {
+            if (event == UART_BUFFER_FULL)
+            {
+                _report.uartOverflows++;
+                _buffer.clear();
+                break;
+            }
+            if (!_buffer.empty())
+            {
+                consume(_buffer, micros);
+                _buffer.clear();
+            }
+        }
+        _events.clear();
+    }
+
+    /** UartIngest::consume() */
+    void consume(std::vector<uint8_t> bytes, uint64_t micros)
+    {
+        size_t length = _faults.apply(bytes.data(), bytes.size());
+        for (size_t i = 0; i < length; i++)
+        {
+            if (_parser.feed((char)bytes[i]))
+                publish(_parser.sample(), micros);
+
+            TelemetrySample sample;
+            if (_decoder.feed(bytes[i]) && hubLinkReadTelemetry(_decoder.frame(), sample.current, sample.min, sample.max))
+            {
+                _sequence.track(_decoder.frame().seq);
+                publish(sample, micros);
+            }
+        }
+    }
+
+    /**
+     * UartIngest::publish(), after loop() has taken whatever it found before now; a pass at
+     * this very instant cannot cut into the batch the task is decoding
+     */
+    void publish(const TelemetrySample &sample, uint64_t micros)
+    {
+        while (!_ring.empty() && pollTime(_ring.front().second) < micros)
+            take();
+        if (_ring.size() >= UART_INGEST_RING)
+        {
+            _report.ringDrops++;
+            return;
+        }
+        _ring.push_back({sample, micros});
+    }
+
+    /** The loop() pass that finds a sample decoded at micros */
+    uint64_t pollTime(uint64_t micros) const
+    {
+        uint64_t period = _config.loopPeriodMicros ? _config.loopPeriodMicros : 1;
+        uint64_t tick = (micros + period - 1) / period * period;
+        return afterStall(tick, _config.loopStallMs, _config.loopStallEverySeconds);
+    }
+
+    /** UartIngest::poll() handing the oldest sample to loop(), matched against what was sent */
+    void take()
+    {
+        std::pair<TelemetrySample, uint64_t> item = _ring.front();
+        _ring.pop_front();
+        uint64_t polled = pollTime(item.second);
+
+        size_t end = std::min(_sent.size(), _nextSent + MATCH_WINDOW);
+        for (size_t i = _nextSent; i < end; i++)
+        {
+            if (sameSample(_sent[i].first, item.first) && _sent[i].second <= polled)
+            {
+                _report.samplesDelivered++;
+                _report.latencyMicros.push_back((uint32_t)(polled - _sent[i].second));
+                _nextSent = i + 1;
+                return;
+            }
+        }
+        _report.samplesCorrupted++;
+    }
+
+    const Config &_config;
+    const std::vector<std::pair<TelemetrySample, uint64_t>> &_sent;
+    Report &_report;
+
+    LinkFaultInjector _faults;
+    TelemetryParser _parser;
+    HubLinkDecoder _decoder;
+    HubLinkSequence _sequence;
+
+    std::vector<uint8_t> _buffer;           // Driver receive buffer
+    std::vector<uart_event_type_t> _events; // Driver event queue
+    uint64_t _resumeAt = 0;                 // When the ingest task next reads the driver
+
+    std::deque<std::pair<TelemetrySample, uint64_t>> _ring; // Sample, when it was decoded
+    size_t _nextSent = 0;
+};
+
+/** Delivery times of a received burst: per FIFO threshold, then after the line goes idle */
+template <typename OnChunk>
+void deliver(const std::vector<RxByte> &received, uint32_t rxBaud, uint32_t *framingErrors, OnChunk onChunk)
+{
+    std::vector<uint8_t> chunk;
+    for (size_t i = 0; i < received.size(); i++)
+    {
+        chunk.push_back(received[i].value);
+        if (framingErrors && received[i].framingError)
+            (*framingErrors)++;
+        if (chunk.size() == DRIVER_FIFO_THRESHOLD)
+        {
+            onChunk(chunk, received[i].micros);
+            chunk.clear();
+        }
+    }
+    if (!chunk.empty())
+        onChunk(chunk, received.back().micros + (uint64_t)DRIVER_RX_TIMEOUT_SYMBOLS * 10 * 1000000 / rxBaud);
+}
+
+void runTelemetry(const Config &config, Report &report)
+{
+    std::mt19937 rng(config.seed);
+    std::uniform_int_distribution<uint32_t> jitter(0, NANO_JITTER_MICROS);
+
+    // Every sample is fixed before the run so the hub side can match deliveries as it goes
+    std::vector<std::pair<TelemetrySample, uint64_t>> sent;
+    for (uint64_t ms = SENSOR_INTERVAL_MS; ms <= (uint64_t)config.seconds * 1000; ms += SENSOR_INTERVAL_MS)
+        sent.push_back({sampleFor((uint32_t)sent.size()), ms * 1000 + jitter(rng)});
+    report.samplesSent = (uint32_t)sent.size();
+
+    Hub hub(config, sent, report);
+    uint8_t seq = 0;
+    uint64_t nextRestart = (uint64_t)config.nanoRestartEverySeconds * 1000000;
+    for (const std::pair<TelemetrySample, uint64_t> &sample : sent)
+    {
+        if (nextRestart && sample.second >= nextRestart)
+        {
+            seq = 0; // linkTxSeq starts over with the sketch
+            nextRestart += (uint64_t)config.nanoRestartEverySeconds * 1000000;
+        }
+        std::vector<uint8_t> bytes = encodeTelemetry(config.format, seq++, sample.first);
+        deliver(transmit(bytes, sample.second, config.nanoBaud, config.hubBaud), config.hubBaud, &report.framingErrors,
+                [&](const std::vector<uint8_t> &chunk, uint64_t micros) { hub.receive(chunk, micros); });
+    }
+    hub.finish();
+    report.samplesLost = report.samplesSent - report.samplesDelivered;
+}
+
+void runCommands(const Config &config, Report &report)
+{
+    if (!config.commandEveryMs)
+        return;
+    LinkFaultConfig faults = config.faults;
+    faults.seed = config.seed ^ 0x85EBCA6Bu;
+    LinkFaultInjector line;
+    line.begin(faults);
+    HubLinkDecoder decoder;
+    CommandReader reader;
+    uint8_t seq = 0;
+    // A frame whose closing delimiter was lost is only completed by the next frame's opening
+    // one, so a binary command can execute one command late; it is matched up by seq
+    std::deque<std::pair<uint8_t, Command>> recent;
+
+    // Offset by half a period so commands also land between telemetry frames
+    for (uint64_t ms = config.commandEveryMs / 2; ms < (uint64_t)config.seconds * 1000; ms += config.commandEveryMs)
+    {
+        Command command = {report.commandsSent % 2 == 0, std::string()};
+        if (!command.reset)
+            command.text = "LCD TEXT " + std::to_string(report.commandsSent % 1000);
+        report.commandsSent++;
+        recent.push_back({seq, command});
+        if (recent.size() > 2)
+            recent.pop_front();
+
+        std::vector<uint8_t> bytes;
+        for (const RxByte &byte : transmit(encodeCommand(config.format, seq++, command), ms * 1000, config.hubBaud, config.nanoBaud))
+            bytes.push_back(byte.value);
+        bytes.resize(line.apply(bytes.data(), bytes.size()));
+
+        // taskCommands(): dispatchFrame() / dispatchCommand()
+        for (uint8_t byte : bytes)
+        {
+            bool executed = false;
+            bool exact = false;
+            if (config.format == Format::Binary)
+            {
+                if (decoder.feed(byte))
+                {
+                    const HubLinkFrame &frame = decoder.frame();
+                    executed = frame.type == HUBLINK_RESET || frame.type == HUBLINK_MESSAGE;
+                    for (const std::pair<uint8_t, Command> &sent : recent)
+                    {
+                        if (sent.first == frame.seq)
+                            exact = frame.type == (sent.second.reset ? HUBLINK_RESET : HUBLINK_MESSAGE) &&
+                                    frame.length == sent.second.text.size() &&
+                                    memcmp(frame.payload, sent.second.text.data(), frame.length) == 0;
+                    }
+                }
+            }
+            else if (reader.feed((char)byte))
+            {
+                std::string text(reader.line(), reader.length());
+                executed = text == "R:1" || text.compare(0, 2, "M:") == 0;
+                exact = command.reset ? text == "R:1" : text == "M:" + command.text;
+            }
+            if (exact)
+                report.commandsAccepted++;
+            else if (executed)
+                report.commandsCorrupted++;
+        }
+    }
+}
+
+} // namespace
+
+uint32_t Report::latencyPercentile(double p) const
+{
+    if (latencyMicros.empty())
+        return 0;
+    std::vector<uint32_t> sorted = latencyMicros;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[(size_t)(p * (sorted.size() - 1) + 0.5)];
+}
+
+Report run(const Config &config)
+{
+    Report report;
+    runTelemetry(config, report);
+    runCommands(config, report);
+    return report;
+}
+
+void print(const Config &config, const Report &report, FILE *out)
+{
+    auto percent = [](uint32_t part, uint32_t whole) { return whole ? 100.0 * part / whole : 0.0; };
+    fprintf(out, "[LINKSIM] seed=%u seconds=%u format=%s nano_baud=%u hub_baud=%u drop=%u flip=%u burst=%u/%u ppm\n",
+            config.seed, config.seconds, config.format == Format::Binary ? "binary" : "ascii", config.nanoBaud,
+            config.hubBaud, config.faults.dropPpm, config.faults.flipPpm, config.faults.burstPpm,
+            config.faults.burstLength);
+    fprintf(out, "[LINKSIM] samples sent=%u delivered=%u (%.2f%%) corrupted=%u lost=%u\n", report.samplesSent,
+            report.samplesDelivered, percent(report.samplesDelivered, report.samplesSent), report.samplesCorrupted,
+            report.samplesLost);
+    fprintf(out, "[LINKSIM] latency_ms p50=%.1f p90=%.1f p99=%.1f max=%.1f\n", report.latencyPercentile(0.5) / 1000.0,
+            report.latencyPercentile(0.9) / 1000.0, report.latencyPercentile(0.99) / 1000.0,
+            report.latencyPercentile(1.0) / 1000.0);
+    fprintf(out,
+            "[LINKSIM] hub framing_errors=%u rejected_frames=%u malformed_lines=%u sequence_gaps=%u sender_restarts=%u "
+            "uart_overflows=%u ring_drops=%u fault_drops=%u fault_flips=%u\n",
+            report.framingErrors, report.rejectedFrames, report.malformedLines, report.sequenceGaps,
+            report.senderRestarts, report.uartOverflows, report.ringDrops, report.faultDrops, report.faultFlips);
+    fprintf(out, "[LINKSIM] commands sent=%u accepted=%u (%.2f%%) corrupted=%u\n", report.commandsSent,
+            report.commandsAccepted, percent(report.commandsAccepted, report.commandsSent), report.commandsCorrupted);
+}
+
+} // namespace linksim
@@ -0,0 +1,87 @@
+/**
+ * @file LinkSim.h
+ * @brief Deterministic simulation of the Nano <-> ESP32 serial link on virtual time.
+ *
+ * Both ends run the sketches' own link code: the Nano encodes telemetry as sendTelemetry()
+ * does (HubLink frames or [DHT11] lines) and assembles commands with HubLinkDecoder or
+ * CommandReader; the ESP32 side repeats UartIngest::consume() (LinkFaultInjector, then
+ * TelemetryParser, HubLinkDecoder and HubLinkSequence) with UartIngest's buffer and ring
+ * sizes. Between them:
+ *   - a bit-level UART: each byte is sent at one end's baud rate and sampled at the other's,
+ *     so a baud mismatch shifts bits and breaks stop bits the way real hardware does;
+ *   - line noise from LinkFaultInjector (byte loss, bursts, bit flips), in both directions;
+ *   - back-pressure: loop() blocked (the ingest ring fills) or the ingest task not reading
+ *     (the driver's receive buffer fills and overflows);
+ *   - optional Nano restarts, which start its frame counter over.
+ * Everything is derived from Config::seed, so a run is reproduced exactly by its config.
+ * Latency is end to end: from the Nano starting to write a sample to loop() taking it
+ * from the ingest ring.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "LinkFaults.h"
+
+namespace linksim
+{
+
+enum class Format : uint8_t
+{
+    Binary, // HubLink frames (USE_BINARY_LINK = true)
+    Ascii   // [DHT11] lines and R:1 / M: commands
+};
+
+struct Config
+{
+    uint32_t seed = 1;
+    uint32_t seconds = 3600; // Simulated time
+    Format format = Format::Binary;
+    uint32_t nanoBaud = 9600; // Nano's Serial
+    uint32_t hubBaud = 9600;  // ESP32's UART2; anything else is a baud mismatch
+    LinkFaultConfig faults = {0, 0, 0, 0, 0}; // Per direction; the injectors' seeds come from seed
+    uint32_t loopPeriodMicros = 1000;         // How often loop() drains the ingest ring
+    uint32_t loopStallMs = 0;                 // Back-pressure: loop() blocked this long...
+    uint32_t loopStallEverySeconds = 0;       // ...this often (0: never)
+    uint32_t ingestStallMs = 0;               // The ingest task not reading the driver this long...
+    uint32_t ingestStallEverySeconds = 0;     // ...this often (0: never)
+    uint32_t commandEveryMs = 5000;           // ESP32 -> Nano, alternating reset and LCD text (0: none)
+    uint32_t nanoRestartEverySeconds = 0;     // Nano resets, restarting its frame counter (0: never)
+};
+
+struct Report
+{
+    uint32_t samplesSent = 0;
+    uint32_t samplesDelivered = 0; // Reached loop() with the values the Nano sent
+    uint32_t samplesCorrupted = 0; // Accepted by a decoder with values the Nano never sent
+    uint32_t samplesLost = 0;      // Sent, never delivered
+
+    // The ESP32's own counters, as /api/stats would show them
+    uint32_t framingErrors = 0; // Bytes whose stop bit read as 0 (baud mismatch)
+    uint32_t rejectedFrames = 0;
+    uint32_t malformedLines = 0;
+    uint32_t sequenceGaps = 0;
+    uint32_t senderRestarts = 0;
+    uint32_t uartOverflows = 0;
+    uint32_t ringDrops = 0;
+    uint32_t faultDrops = 0;
+    uint32_t faultFlips = 0;
+
+    uint32_t commandsSent = 0;
+    uint32_t commandsAccepted = 0;  // Executed by the Nano exactly as sent
+    uint32_t commandsCorrupted = 0; // Executed, but not as sent (e.g. garbled LCD text)
+
+    std::vector<uint32_t> latencyMicros; // One per delivered sample, in delivery order
+
+    /** Nearest-rank percentile of latencyMicros, 0 if nothing was delivered */
+    uint32_t latencyPercentile(double p) const;
+};
+
+Report run(const Config &config);
+
+/** Human-readable summary, one [LINKSIM] line per aspect */
+void print(const Config &config, const Report &report, FILE *out);
+
+} // namespace linksim
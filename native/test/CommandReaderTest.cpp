@@ -0,0 +1,101 @@
+/**
+ * @file CommandReaderTest.cpp
+ * @brief The Nano's ASCII command assembler: lines split across reads, trimming, CRLF,
+ * line noise, truncation at the buffer size and several lines in one read.
+ */
+
+#include <gtest/gtest.h>
+#include "CommandReader.h"
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/** Feeds text and collects the lines the reader completes */
+std::vector<std::string> feedAll(CommandReader &reader, const std::string &text)
+{
+    std::vector<std::string> lines;
+    for (char c : text)
+    {
+        if (reader.feed(c))
+        {
+            EXPECT_EQ(strlen(reader.line()), reader.length());
+            lines.push_back(reader.line());
+        }
+    }
+    return lines;
+}
+
+} // namespace
+
+TEST(CommandReader, LineSplitAcrossReadsCompletesOnce)
+{
+    CommandReader reader;
+    EXPECT_TRUE(feedAll(reader, "M:HEL").empty());
+    EXPECT_TRUE(feedAll(reader, "LO").empty());
+    EXPECT_EQ(feedAll(reader, "\n"), std::vector<std::string>{"M:HELLO"});
+}
+
+TEST(CommandReader, TrimsLeadingAndTrailingWhitespace)
+{
+    CommandReader reader;
+    EXPECT_EQ(feedAll(reader, " \t R:1 \t \n"), std::vector<std::string>{"R:1"});
+    // Only the ends: spaces inside a message are kept
+    EXPECT_EQ(feedAll(reader, "  M:A  B  \n"), std::vector<std::string>{"M:A  B"});
+}
+
+TEST(CommandReader, AcceptsCrLf)
+{
+    CommandReader reader;
+    EXPECT_EQ(feedAll(reader, "R:1\r\nM:HI\r\n"), (std::vector<std::string>{"R:1", "M:HI"}));
+}
+
+TEST(CommandReader, BlankLinesAreNotCommands)
+{
+    CommandReader reader;
+    EXPECT_TRUE(feedAll(reader, "\n \r\n\t\n").empty());
+    EXPECT_EQ(reader.overflows(), 0u);
+}
+
+TEST(CommandReader, SkipsEmbeddedNul)
+{
+    CommandReader reader;
+    // A NUL would otherwise end the line early for strcmp(): "R:1\0junk" must not read as R:1
+    EXPECT_EQ(feedAll(reader, std::string("R:1\0junk\n", 9)), std::vector<std::string>{"R:1junk"});
+    EXPECT_EQ(feedAll(reader, std::string("R\0:1\n", 5)), std::vector<std::string>{"R:1"});
+}
+
+TEST(CommandReader, LongestLineThatFitsIsNotTruncated)
+{
+    CommandReader reader;
+    std::string line = "M:" + std::string(COMMAND_BUFFER_SIZE - 3, 'A'); // 23 bytes
+    EXPECT_EQ(feedAll(reader, line + "\n"), std::vector<std::string>{line});
+    EXPECT_FALSE(reader.truncated());
+    EXPECT_EQ(reader.overflows(), 0u);
+}
+
+TEST(CommandReader, OneByteMoreIsTruncatedAndCounted)
+{
+    CommandReader reader;
+    std::string line = "M:" + std::string(COMMAND_BUFFER_SIZE - 2, 'A'); // 24 bytes
+    EXPECT_EQ(feedAll(reader, line + "\n"), std::vector<std::string>{line.substr(0, COMMAND_BUFFER_SIZE - 1)});
+    EXPECT_TRUE(reader.truncated());
+    EXPECT_EQ(reader.overflows(), 1u);
+
+    // The next line starts clean
+    EXPECT_EQ(feedAll(reader, "R:1\n"), std::vector<std::string>{"R:1"});
+    EXPECT_FALSE(reader.truncated());
+    EXPECT_EQ(reader.overflows(), 1u);
+}
+
+TEST(CommandReader, BackToBackLinesInOneRead)
+{
+    CommandReader reader;
+    std::string garbage(40, 'x');
+    EXPECT_EQ(feedAll(reader, "R:1\nM:ONE\n" + garbage + "\nM:TWO\n"),
+              (std::vector<std::string>{"R:1", "M:ONE", garbage.substr(0, COMMAND_BUFFER_SIZE - 1), "M:TWO"}));
+    EXPECT_EQ(reader.overflows(), 1u);
+}
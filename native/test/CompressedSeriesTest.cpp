@@ -0,0 +1,134 @@
+/**
+ * @file CompressedSeriesTest.cpp
+ * @brief CompressedSeries: round trips at every prefix-code boundary of the timestamp and
+ * value encodings, block rollover and the ring's oldest-block eviction.
+ */
+
+#include <gtest/gtest.h>
+#include "CompressedSeries.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+typedef std::vector<std::pair<uint32_t, int16_t>> Samples;
+
+/** Writes samples into one block and reads them back; the block must have room for all of them */
+Samples roundTrip(const Samples &samples)
+{
+    static SampleBlock block;
+    SampleBlockWriter writer;
+    writer.start(block, samples[0].first, samples[0].second);
+    for (size_t i = 1; i < samples.size(); i++)
+        EXPECT_TRUE(writer.append(samples[i].first, samples[i].second)) << "sample " << i;
+
+    Samples decoded;
+    SampleBlockReader reader(block);
+    uint32_t time;
+    int16_t value;
+    while (reader.next(time, value))
+        decoded.emplace_back(time, value);
+    return decoded;
+}
+
+/** Three samples whose second timestamp delta-of-delta is dod: the first delta is base, the second base + dod */
+Samples withDeltaOfDelta(int32_t dod, uint32_t base)
+{
+    const uint32_t start = 1000;
+    return {{start, 450}, {start + base, 450}, {start + base + base + dod, 450}};
+}
+
+} // namespace
+
+TEST(CompressedSeries, RestartAfterAGapDecodes)
+{
+    // 2 s cadence, then a 66 s gap: delta-of-delta 64, one past the 7-bit field
+    Samples samples = {{1000, 450}, {1002, 451}, {1068, 452}};
+    EXPECT_EQ(roundTrip(samples), samples);
+}
+
+TEST(CompressedSeries, DeltaOfDeltaBoundariesRoundTrip)
+{
+    // The edges of the 7-, 9- and 12-bit fields and one step past each, both signs
+    const int32_t boundaries[] = {-64, -65, 63, 64, -256, -257, 255, 256, -2048, -2049, 2047, 2048, -100000, 100000};
+    for (int32_t dod : boundaries)
+    {
+        Samples samples = withDeltaOfDelta(dod, 200000);
+        EXPECT_EQ(roundTrip(samples), samples) << "delta-of-delta " << dod;
+    }
+
+    // The first delta in a block is coded against 0, so it crosses the same boundaries
+    const uint32_t deltas[] = {63, 64, 255, 256, 2047, 2048};
+    for (uint32_t delta : deltas)
+    {
+        Samples samples = {{5000, 450}, {5000 + delta, 450}};
+        EXPECT_EQ(roundTrip(samples), samples) << "first delta " << delta;
+    }
+}
+
+TEST(CompressedSeries, ValueDeltaBoundariesRoundTrip)
+{
+    // Zigzag 15/16 and 255/256 are the 4-/8-bit field edges; the extremes take the 16-bit escape
+    const int32_t deltas[] = {0, -8, 7, -9, 8, -128, 127, -129, 128, 1000, -1000};
+    for (int32_t delta : deltas)
+    {
+        Samples samples = {{0, 450}, {2, (int16_t)(450 + delta)}};
+        EXPECT_EQ(roundTrip(samples), samples) << "value delta " << delta;
+    }
+    Samples extremes = {{0, INT16_MIN}, {2, INT16_MAX}, {4, INT16_MIN}, {6, 0}};
+    EXPECT_EQ(roundTrip(extremes), extremes);
+}
+
+TEST(CompressedSeries, RandomWalkAcrossBlocksRoundTrips)
+{
+    std::mt19937 rng(12);
+    CompressedSeries series;
+    ASSERT_TRUE(series.begin(64));
+
+    Samples written;
+    uint32_t time = 1700000000UL;
+    int16_t value = 450;
+    for (int i = 0; i < 5000; i++)
+    {
+        // Mostly the 2 s cadence, with occasional late samples and gaps of every size
+        uint32_t roll = rng() % 100;
+        time += roll < 90 ? 2 : roll < 97 ? 1 + rng() % 10 : 1 + rng() % 5000;
+        if (rng() % 8 == 0)
+            value += (int16_t)(rng() % 21) - 10;
+        series.append(time, value);
+        written.emplace_back(time, value);
+    }
+    ASSERT_LT(series.blocks(), 64u) << "nothing may be evicted for this test";
+
+    Samples read;
+    series.forEach(0, UINT32_MAX, [&](uint32_t t, int16_t v) { read.emplace_back(t, v); });
+    EXPECT_EQ(read, written);
+}
+
+TEST(CompressedSeries, FullRingEvictsOldestBlock)
+{
+    CompressedSeries series;
+    ASSERT_TRUE(series.begin(4));
+    uint32_t time = 0;
+    // Alternating values keep every sample at a few bits, so blocks fill at a steady rate
+    while (!series.full() || series.block(0).firstTime == 0)
+    {
+        series.append(time, (int16_t)(450 + (time / 2) % 2));
+        time += 2;
+    }
+    EXPECT_EQ(series.blocks(), 4u);
+    EXPECT_GT(series.block(0).firstTime, 0u);
+
+    uint32_t last = 0;
+    size_t count = 0;
+    series.forEach(0, UINT32_MAX, [&](uint32_t t, int16_t) {
+        EXPECT_TRUE(count == 0 || t == last + 2);
+        last = t;
+        count++;
+    });
+    EXPECT_EQ(last, time - 2);
+    EXPECT_EQ(series.samplesAppended(), time / 2);
+}
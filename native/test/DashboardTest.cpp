@@ -0,0 +1,83 @@
+/**
+ * @file DashboardTest.cpp
+ * @brief ESP32.ino's "/" over HTTP: the gzip body must inflate to exactly the minified
+ * web/index.html, under the ETag of IndexHtml.h, and a browser holding that ETag gets a 304.
+ */
+
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <zlib.h>
+#include "HubHarness.h"
+#include "IndexHtml.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+/** Inflates a gzip member; "" if the stream is corrupt or has trailing bytes */
+std::string gunzip(const std::string &compressed)
+{
+    z_stream stream = {};
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) // 16: gzip header and trailer
+        return std::string();
+    stream.next_in = (Bytef *)compressed.data();
+    stream.avail_in = (uInt)compressed.size();
+
+    std::string out;
+    char buffer[4096];
+    int result = Z_OK;
+    while (result == Z_OK)
+    {
+        stream.next_out = (Bytef *)buffer;
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        out.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+    bool complete = result == Z_STREAM_END && stream.avail_in == 0;
+    inflateEnd(&stream);
+    return complete ? out : std::string();
+}
+
+std::string readFile(const char *path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+} // namespace
+
+TEST(Dashboard, GzipBodyInflatesToMinifiedPage)
+{
+    harness::boot();
+    std::string minified = readFile(HUB_DASHBOARD_MINIFIED);
+    ASSERT_FALSE(minified.empty()) << HUB_DASHBOARD_MINIFIED;
+
+    harness::HttpResponse page = harness::get("/", "Accept-Encoding: gzip, deflate\r\n");
+    ASSERT_EQ(page.status, 200) << page.headers;
+    EXPECT_EQ(page.header("Content-Encoding"), "gzip");
+    EXPECT_EQ(page.header("Content-Type"), "text/html");
+    EXPECT_EQ(page.header("ETag"), INDEX_HTML_ETAG);
+    EXPECT_EQ(page.body.size(), INDEX_HTML_GZ_LENGTH);
+    EXPECT_EQ(gunzip(page.body), minified);
+}
+
+TEST(Dashboard, CurrentEtagIsAnsweredWith304)
+{
+    harness::boot();
+
+    harness::HttpResponse cached =
+        harness::get("/", std::string("Accept-Encoding: gzip\r\nIf-None-Match: ") + INDEX_HTML_ETAG + "\r\n");
+    EXPECT_EQ(cached.status, 304) << cached.headers;
+    EXPECT_EQ(cached.header("ETag"), INDEX_HTML_ETAG);
+    EXPECT_TRUE(cached.body.empty());
+
+    // A page from an older build is sent again in full
+    harness::HttpResponse stale = harness::get("/", "Accept-Encoding: gzip\r\nIf-None-Match: \"0000000000000000\"\r\n");
+    EXPECT_EQ(stale.status, 200) << stale.headers;
+    EXPECT_EQ(stale.body.size(), INDEX_HTML_GZ_LENGTH);
+}
@@ -0,0 +1,183 @@
+/**
+ * @file DhtTraceTest.cpp
+ * @brief Replays DHT11 pulse traces (data/dht11_traces.txt) through dhtDecode() directly and
+ * through DhtReader's pin-change interrupt path on the simulated pin.
+ */
+
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include "DhtReader.h"
+#include "ShimPins.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const uint8_t DHT_PIN = 4;           // PIN_DHT in Arduino_Nano.ino, on PCINT2
+const uint16_t SENSOR_WAIT_US = 30;  // Sensor pause between the host's release and its first low
+
+struct Trace
+{
+    std::string name;
+    DhtStatus status;
+    DhtReading reading;
+    std::vector<uint16_t> phases; // Alternating low/high durations, first one low
+};
+
+std::string trim(const std::string &text)
+{
+    size_t start = text.find_first_not_of(' ');
+    size_t end = text.find_last_not_of(' ');
+    return start == std::string::npos ? std::string() : text.substr(start, end - start + 1);
+}
+
+std::vector<Trace> loadTraces()
+{
+    std::vector<Trace> traces;
+    std::ifstream file(HUB_TEST_DATA_DIR "/dht11_traces.txt");
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::vector<std::string> fields;
+        std::stringstream row(line);
+        std::string field;
+        while (std::getline(row, field, '|'))
+            fields.push_back(trim(field));
+        if (fields.size() != 4)
+            continue;
+
+        Trace trace;
+        trace.name = fields[0];
+        trace.reading = {0, 0, 0, 0};
+        std::stringstream expected(fields[1]);
+        std::string status;
+        expected >> status;
+        if (status == "ok")
+        {
+            unsigned values[4];
+            expected >> values[0] >> values[1] >> values[2] >> values[3];
+            trace.status = DhtStatus::Ok;
+            trace.reading = {(uint8_t)values[0], (uint8_t)values[1], (uint8_t)values[2], (uint8_t)values[3]};
+        }
+        else
+        {
+            trace.status = status == "timeout"        ? DhtStatus::Timeout
+                           : status == "bad_checksum" ? DhtStatus::BadChecksum
+                                                      : DhtStatus::BadTiming;
+        }
+        std::stringstream phases(fields[3]);
+        unsigned us;
+        while (phases >> us)
+            trace.phases.push_back((uint16_t)us);
+        traces.push_back(trace);
+    }
+    return traces;
+}
+
+/** Falling edges of a trace whose first low starts at start, as 16-bit micros() would read them */
+std::vector<uint16_t> fallingEdges(const Trace &trace, uint32_t start)
+{
+    std::vector<uint16_t> edges;
+    uint32_t at = start;
+    for (size_t i = 0; i < trace.phases.size() && edges.size() < DHT_EDGE_COUNT; i++)
+    {
+        if (i % 2 == 0)
+            edges.push_back((uint16_t)at);
+        at += trace.phases[i];
+    }
+    return edges;
+}
+
+DhtReader *activeReader = nullptr;
+
+} // namespace
+
+ISR(PCINT2_vect)
+{
+    if (activeReader)
+        activeReader->handleEdge();
+}
+
+TEST(DhtTrace, TraceFileLoads)
+{
+    std::vector<Trace> traces = loadTraces();
+    ASSERT_GE(traces.size(), 10u);
+    for (const Trace &trace : traces)
+        EXPECT_FALSE(trace.phases.empty()) << trace.name;
+}
+
+TEST(DhtTrace, DecoderReplay)
+{
+    // Starting offsets include a micros() wrap of the 16-bit timestamps in mid-response
+    const uint32_t starts[] = {0, 1000, 65000, 65400, 65535};
+    for (const Trace &trace : loadTraces())
+    {
+        for (uint32_t start : starts)
+        {
+            std::vector<uint16_t> edges = fallingEdges(trace, start);
+            DhtReading reading = {0, 0, 0, 0};
+            DhtStatus status = dhtDecode(edges.data(), (uint8_t)edges.size(), reading);
+            EXPECT_EQ((int)status, (int)trace.status) << trace.name << " from " << start;
+            if (trace.status == DhtStatus::Ok && status == DhtStatus::Ok)
+            {
+                EXPECT_EQ(reading.humidity, trace.reading.humidity) << trace.name;
+                EXPECT_EQ(reading.humidityDecimal, trace.reading.humidityDecimal) << trace.name;
+                EXPECT_EQ(reading.temperature, trace.reading.temperature) << trace.name;
+                EXPECT_EQ(reading.temperatureDecimal, trace.reading.temperatureDecimal) << trace.name;
+            }
+        }
+    }
+}
+
+TEST(DhtTrace, InterruptReplayOnPin)
+{
+    shim::clock().useManual(0);
+    for (const Trace &trace : loadTraces())
+    {
+        DhtReader reader(DHT_PIN);
+        activeReader = &reader;
+        reader.begin();
+
+        ASSERT_TRUE(reader.start(millis()));
+        shim::clock().advance(DHT_START_SIGNAL_MS * 1000UL);
+        ASSERT_FALSE(reader.poll(millis())) << "releases the line and arms the interrupt";
+
+        // The sensor's side of the line, phase by phase on the virtual clock
+        uint64_t at = shim::clock().micros() + SENSOR_WAIT_US;
+        for (size_t i = 0; i < trace.phases.size(); i++)
+        {
+            bool low = i % 2 == 0;
+            shim::clock().at(at, [low]() {
+                if (low)
+                    shim::pins().drive(DHT_PIN, LOW);
+                else
+                    shim::pins().release(DHT_PIN);
+            });
+            at += trace.phases[i];
+        }
+        shim::clock().at(at, []() { shim::pins().release(DHT_PIN); });
+
+        bool done = false;
+        for (int step = 0; step < 200 && !done; step++)
+        {
+            shim::clock().advance(100);
+            done = reader.poll(millis());
+        }
+        ASSERT_TRUE(done) << trace.name;
+        EXPECT_EQ((int)reader.status(), (int)trace.status) << trace.name;
+        if (trace.status == DhtStatus::Ok)
+        {
+            EXPECT_FLOAT_EQ(reader.humidity(), trace.reading.humidity + trace.reading.humidityDecimal * 0.1f)
+                << trace.name;
+        }
+
+        shim::clock().advance(5000); // Idle gap before the next read
+        activeReader = nullptr;
+    }
+}
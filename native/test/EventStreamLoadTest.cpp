@@ -0,0 +1,175 @@
+/**
+ * @file EventStreamLoadTest.cpp
+ * @brief As many dashboards as ESP32.ino can stream to: live /api/stream subscribers against
+ * the 3 s /api/data polling they replace, over the same minute of virtual time with a sample every 2 s.
+ * Compares TCP connections and bytes, reports the host CPU time of each run (socket
+ * draining included, so only indicative) and checks that subscribing never stalls the
+ * WebServer in its close wait.
+ */
+
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include "EventStream.h"
+#include "HubHarness.h"
+
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int VIEWERS = SSE_MAX_CLIENTS;
+const unsigned long RUN_MS = 60000;
+const unsigned long STEP_MS = 10;
+const unsigned long SAMPLE_INTERVAL_MS = 2000; // SENSOR_INTERVAL on the Nano
+const unsigned long POLL_INTERVAL_MS = 3000;   // The dashboard's old setInterval(fetchData, 3000)
+
+double threadCpuMs()
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1e3 + now.tv_nsec / 1e6;
+}
+
+struct RunStats
+{
+    int connections = 0;
+    size_t bytes = 0;
+    double cpuMs = 0;
+};
+
+int16_t sampleAt(unsigned long ms) { return (int16_t)(450 + (ms / SAMPLE_INTERVAL_MS) % 20); }
+
+size_t countOf(const std::string &text, const std::string &what)
+{
+    size_t count = 0;
+    for (size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1))
+        count++;
+    return count;
+}
+
+/** Opens /api/stream and runs loop() without advancing the clock until the response starts */
+int openStream(std::string &received)
+{
+    int fd = harness::connectHttp();
+    if (fd < 0)
+        return -1;
+    const char request[] = "GET /api/stream HTTP/1.1\r\nHost: hub\r\nAccept: text/event-stream\r\n\r\n";
+    send(fd, request, sizeof(request) - 1, MSG_NOSIGNAL);
+    for (int i = 0; i < 2000 && received.find("\r\n\r\n") == std::string::npos; i++)
+    {
+        loop();
+        harness::drain(fd, received);
+        usleep(50);
+    }
+    return fd;
+}
+
+} // namespace
+
+TEST(EventStreamLoad, FullHouseStreamsInsteadOfPolling)
+{
+    harness::boot();
+    ASSERT_TRUE(harness::sendSample(450, 300, 600));
+
+    // --- Live stream ---
+    std::vector<int> streams;
+    std::vector<std::string> received(VIEWERS);
+    unsigned long subscribedAt = millis();
+    for (int i = 0; i < VIEWERS; i++)
+    {
+        int fd = openStream(received[i]);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(received[i].rfind("HTTP/1.1 200", 0), 0u) << "viewer " << i << " got: " << received[i];
+        streams.push_back(fd);
+    }
+    // Every subscription was served back to back: none waited out the 2 s close wait
+    EXPECT_EQ(millis(), subscribedAt);
+
+    std::string refused;
+    int extra = openStream(refused);
+    EXPECT_EQ(refused.rfind("HTTP/1.1 503", 0), 0u) << refused;
+    close(extra);
+    loop();
+
+    RunStats stream;
+    stream.connections = VIEWERS;
+    double cpuStart = threadCpuMs();
+    for (unsigned long ms = STEP_MS; ms <= RUN_MS; ms += STEP_MS)
+    {
+        harness::step(STEP_MS);
+        if (ms % SAMPLE_INTERVAL_MS == 0)
+        {
+            ASSERT_TRUE(harness::sendSample(sampleAt(ms), 300, 600));
+        }
+        for (int i = 0; i < VIEWERS; i++)
+            harness::drain(streams[i], received[i]);
+    }
+    stream.cpuMs = threadCpuMs() - cpuStart;
+
+    const size_t samples = RUN_MS / SAMPLE_INTERVAL_MS;
+    for (int i = 0; i < VIEWERS; i++)
+    {
+        // The initial event plus one per sample, each pushed in the loop pass that accepted it
+        EXPECT_EQ(countOf(received[i], "data: "), samples + 1) << "viewer " << i;
+        stream.bytes += received[i].size();
+        close(streams[i]);
+    }
+    harness::step(STEP_MS);
+
+    // --- Polling, staggered like independently opened tabs ---
+    RunStats polling;
+    std::vector<int> pending(VIEWERS, -1);
+    std::vector<std::string> responses(VIEWERS);
+    cpuStart = threadCpuMs();
+    for (unsigned long ms = STEP_MS; ms <= RUN_MS; ms += STEP_MS)
+    {
+        for (int i = 0; i < VIEWERS; i++)
+        {
+            if (ms % POLL_INTERVAL_MS == (unsigned long)i * (POLL_INTERVAL_MS / VIEWERS / STEP_MS) * STEP_MS &&
+                pending[i] < 0)
+            {
+                pending[i] = harness::connectHttp();
+                const char request[] = "GET /api/data HTTP/1.1\r\nHost: hub\r\nConnection: close\r\n\r\n";
+                send(pending[i], request, sizeof(request) - 1, MSG_NOSIGNAL);
+                polling.connections++;
+            }
+        }
+        harness::step(STEP_MS);
+        if (ms % SAMPLE_INTERVAL_MS == 0)
+        {
+            ASSERT_TRUE(harness::sendSample(sampleAt(ms), 300, 600));
+        }
+        for (int i = 0; i < VIEWERS; i++)
+        {
+            if (pending[i] < 0)
+                continue;
+            harness::drain(pending[i], responses[i]);
+            size_t headerEnd = responses[i].find("\r\n\r\n");
+            if (headerEnd != std::string::npos && responses[i].back() == '}')
+            {
+                polling.bytes += responses[i].size();
+                responses[i].clear();
+                close(pending[i]);
+                pending[i] = -1;
+            }
+        }
+    }
+    polling.cpuMs = threadCpuMs() - cpuStart;
+
+    printf("[LOAD] %d viewers, %lu s: stream %d connections %zu bytes %.1f ms CPU; "
+           "polling %d connections %zu bytes %.1f ms CPU\n",
+           VIEWERS, RUN_MS / 1000, stream.connections, stream.bytes, stream.cpuMs, polling.connections,
+           polling.bytes, polling.cpuMs);
+    RecordProperty("stream_connections", stream.connections);
+    RecordProperty("polling_connections", polling.connections);
+    RecordProperty("stream_bytes", (int)stream.bytes);
+    RecordProperty("polling_bytes", (int)polling.bytes);
+
+    EXPECT_EQ(polling.connections, VIEWERS * (int)(RUN_MS / POLL_INTERVAL_MS));
+    EXPECT_LT(stream.connections * 10, polling.connections);
+    EXPECT_LT(stream.bytes, polling.bytes);
+}
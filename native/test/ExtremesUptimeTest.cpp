@@ -0,0 +1,56 @@
+/**
+ * @file ExtremesUptimeTest.cpp
+ * @brief ESP32.ino's sliding min / max windows across the 49.7-day millis() wrap: a spike
+ * recorded before the wrap must still leave the 1 h window on time after it.
+ */
+
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include "HubHarness.h"
+
+#include <string>
+
+// ESP32.ino
+extern char dataJson[];
+
+namespace
+{
+
+const uint64_t MILLIS_WRAP_MS = 1ULL << 32;
+const unsigned long HOUR_MS = 3600UL * 1000;
+
+/** The tenths after "key": in the /api/data body, as its text */
+std::string field(const char *key)
+{
+    std::string json = dataJson;
+    std::string quoted = std::string("\"") + key + "\":";
+    size_t at = json.find(quoted);
+    if (at == std::string::npos)
+        return std::string();
+    at += quoted.size();
+    return json.substr(at, json.find_first_of(",}", at) - at);
+}
+
+} // namespace
+
+TEST(ExtremesUptime, WindowsKeepSlidingAfterMillisWraps)
+{
+    harness::boot();
+
+    // Half an hour before millis() wraps: one spike, then ordinary readings
+    harness::step((unsigned long)(MILLIS_WRAP_MS - millis() - HOUR_MS / 2));
+    ASSERT_TRUE(harness::sendSample(900, 300, 900));
+    EXPECT_EQ(field("max1h"), "90.0");
+
+    // Two hours on, well past the wrap
+    for (int i = 0; i < 4; i++)
+    {
+        harness::step(HOUR_MS / 2);
+        ASSERT_TRUE(harness::sendSample(450, 300, 900));
+    }
+    EXPECT_LT(millis(), 2 * HOUR_MS) << "the clock should have wrapped";
+
+    EXPECT_EQ(field("max1h"), "45.0") << dataJson;
+    EXPECT_EQ(field("min1h"), "45.0") << dataJson;
+    EXPECT_EQ(field("max24h"), "90.0") << dataJson;
+}
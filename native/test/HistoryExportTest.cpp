@@ -0,0 +1,226 @@
+/**
+ * @file HistoryExportTest.cpp
+ * @brief /api/export on ESP32.ino: a week of 2 s samples streamed as CSV and as binary.
+ * The hub's history is filled directly, then a reader thread downloads the export while
+ * loop() serves it, de-chunking on the fly into fixed buffers so that the only heap in
+ * play is the hub's. It samples the process heap throughout: the export must peak no
+ * higher than an hour's export does and give every byte back. Throughput is reported.
+ */
+
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <WebServer.h>
+#include "AllocCounter.h"
+#include "HistoryStore.h"
+#include "HubHarness.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+// ESP32.ino
+extern WebServer server;
+extern HistoryStore history;
+void handleExport();
+
+namespace
+{
+
+const uint32_t SAMPLE_INTERVAL = 2; // s
+const uint32_t START = 1700000000UL;
+const uint32_t HOUR = 3600;
+const uint32_t WEEK = 7 * 86400;
+const size_t BIN_RECORD_SIZE = 6;
+
+int64_t heapBefore = 0;
+int64_t heapAfter = 0;
+uint64_t handlerAllocations = 0;
+
+/** Streaming view of a chunked response, kept in fixed storage */
+struct Download
+{
+    size_t wireBytes = 0;
+    size_t bodyBytes = 0;
+    size_t lines = 0;
+    char tail[32] = {};   // Last bytes of the body
+    bool complete = false; // Zero-length chunk seen
+    int64_t peakHeap = 0;
+};
+
+/** Receives a chunked response on fd; runs on its own thread while loop() writes */
+void download(int fd, Download &result)
+{
+    enum { HEADERS, SIZE, SIZE_LF, DATA, DATA_CR, DATA_LF, TRAILER } state = HEADERS;
+    uint32_t headerMatch = 0; // Bytes of "\r\n\r\n" matched so far
+    size_t chunk = 0;
+    char buffer[4096];
+    result.peakHeap = alloc_counter::bytesInUse();
+
+    while (!result.complete)
+    {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            return;
+        result.wireBytes += (size_t)n;
+        result.peakHeap = std::max(result.peakHeap, alloc_counter::bytesInUse());
+
+        for (ssize_t i = 0; i < n && !result.complete; i++)
+        {
+            char c = buffer[i];
+            switch (state)
+            {
+            case HEADERS:
+                headerMatch = c == "\r\n\r\n"[headerMatch] ? headerMatch + 1 : c == '\r' ? 1 : 0;
+                if (headerMatch == 4)
+                    state = SIZE;
+                break;
+            case SIZE:
+                if (c == '\r')
+                    state = SIZE_LF;
+                else
+                    chunk = chunk * 16 + (c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+                break;
+            case SIZE_LF:
+                state = chunk == 0 ? TRAILER : DATA;
+                break;
+            case DATA:
+                memmove(result.tail, result.tail + 1, sizeof(result.tail) - 1);
+                result.tail[sizeof(result.tail) - 1] = c;
+                result.bodyBytes++;
+                result.lines += c == '\n';
+                if (--chunk == 0)
+                    state = DATA_CR;
+                break;
+            case DATA_CR:
+                state = DATA_LF;
+                break;
+            case DATA_LF:
+                state = SIZE;
+                break;
+            case TRAILER:
+                result.complete = c == '\n';
+                break;
+            }
+        }
+    }
+}
+
+struct Export
+{
+    Download received;
+    double seconds = 0;
+};
+
+Export runExport(uint32_t from, uint32_t to, const char *format)
+{
+    Export result;
+    int fd = harness::connectHttp();
+    EXPECT_GE(fd, 0);
+    char request[160];
+    int length = snprintf(request, sizeof(request),
+                          "GET /test/export?from=%lu&to=%lu&format=%s HTTP/1.1\r\nHost: hub\r\n\r\n",
+                          (unsigned long)from, (unsigned long)to, format);
+    send(fd, request, length, MSG_NOSIGNAL);
+
+    std::thread reader(download, fd, std::ref(result.received));
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100000 && !result.received.complete; i++)
+    {
+        loop(); // Serves the whole export in one pass once the request is in
+        if (!result.received.complete)
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    reader.join();
+    close(fd);
+    harness::step(1);
+    return result;
+}
+
+} // namespace
+
+class HistoryExport : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        harness::boot();
+        for (uint32_t t = START; t < START + WEEK; t += SAMPLE_INTERVAL)
+            history.add(t, (int16_t)(450 + (t / 600) % 50));
+        server.on("/test/export", [] {
+            heapBefore = alloc_counter::bytesInUse();
+            uint64_t allocations = alloc_counter::allocations();
+            handleExport();
+            handlerAllocations = alloc_counter::allocations() - allocations;
+            heapAfter = alloc_counter::bytesInUse();
+        });
+
+        // The first response of the process sets up buffers that stay (stdio, the server's strings)
+        runExport(START, START, "csv");
+    }
+};
+
+TEST_F(HistoryExport, WeekOfCsvStreamsInConstantMemory)
+{
+    if (!alloc_counter::active())
+        GTEST_SKIP() << "heap counters are off in sanitizer builds";
+
+    Export hour = runExport(START, START + HOUR - 1, "csv");
+    ASSERT_TRUE(hour.received.complete);
+    EXPECT_EQ(hour.received.lines, 1 + HOUR / SAMPLE_INTERVAL);
+    int64_t hourPeak = hour.received.peakHeap - heapBefore;
+    uint64_t hourAllocations = handlerAllocations;
+
+    Export week = runExport(START, START + WEEK - 1, "csv");
+    ASSERT_TRUE(week.received.complete);
+    const size_t samples = WEEK / SAMPLE_INTERVAL;
+    EXPECT_EQ(week.received.lines, 1 + samples); // Header line, then one per sample
+    uint32_t last = START + WEEK - SAMPLE_INTERVAL;
+    char lastLine[32];
+    snprintf(lastLine, sizeof(lastLine), "\n%lu,%d.%d\n", (unsigned long)last, (450 + (last / 600) % 50) / 10,
+             (450 + (last / 600) % 50) % 10);
+    EXPECT_EQ(std::string(week.received.tail, sizeof(week.received.tail)).substr(sizeof(week.received.tail) -
+                                                                                  strlen(lastLine)),
+              lastLine);
+
+    // A week costs what an hour does: no more allocations, no higher peak, nothing kept
+    int64_t weekPeak = week.received.peakHeap - heapBefore;
+    EXPECT_LE(handlerAllocations, hourAllocations);
+    EXPECT_LE(weekPeak, std::max<int64_t>(hourPeak, 0));
+    EXPECT_EQ(heapAfter, heapBefore);
+
+    printf("[EXPORT] csv: %zu samples, %zu bytes in %.1f ms (%.1f MB/s, %.0f samples/ms); "
+           "%llu allocations, peak heap growth %lld bytes (hour: %lld)\n",
+           samples, week.received.bodyBytes, week.seconds * 1e3, week.received.bodyBytes / week.seconds / 1e6,
+           samples / (week.seconds * 1e3), (unsigned long long)handlerAllocations, (long long)weekPeak,
+           (long long)hourPeak);
+    RecordProperty("csv_bytes", (int)week.received.bodyBytes);
+    RecordProperty("csv_us", (int)(week.seconds * 1e6));
+}
+
+TEST_F(HistoryExport, WeekOfBinaryIsSixBytesPerSample)
+{
+    Export week = runExport(START, START + WEEK - 1, "bin");
+    ASSERT_TRUE(week.received.complete);
+    const size_t samples = WEEK / SAMPLE_INTERVAL;
+    EXPECT_EQ(week.received.bodyBytes, samples * BIN_RECORD_SIZE);
+
+    const uint8_t *record = (const uint8_t *)week.received.tail + sizeof(week.received.tail) - BIN_RECORD_SIZE;
+    uint32_t time = record[0] | record[1] << 8 | record[2] << 16 | (uint32_t)record[3] << 24;
+    int16_t value = (int16_t)(record[4] | record[5] << 8);
+    EXPECT_EQ(time, START + WEEK - SAMPLE_INTERVAL);
+    EXPECT_EQ(value, (int16_t)(450 + (time / 600) % 50));
+    if (alloc_counter::active())
+    {
+        EXPECT_EQ(heapAfter, heapBefore);
+    }
+
+    printf("[EXPORT] bin: %zu samples, %zu bytes in %.1f ms (%.1f MB/s)\n", samples, week.received.bodyBytes,
+           week.seconds * 1e3, week.received.bodyBytes / week.seconds / 1e6);
+    RecordProperty("bin_bytes", (int)week.received.bodyBytes);
+    RecordProperty("bin_us", (int)(week.seconds * 1e6));
+}
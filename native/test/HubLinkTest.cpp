@@ -0,0 +1,203 @@
+/**
+ * @file HubLinkTest.cpp
+ * @brief HubLink codec: CRC and COBS vectors, frame round trips and seeded fuzzing of the decoder.
+ */
+
+#include <gtest/gtest.h>
+#include <HubLink.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+std::vector<uint8_t> wire(const HubLinkFrame &frame)
+{
+    uint8_t out[HUBLINK_MAX_WIRE_SIZE];
+    size_t length = hubLinkEncode(frame, out);
+    return std::vector<uint8_t>(out, out + length);
+}
+
+/** Feeds bytes and collects the frames the decoder reports */
+std::vector<HubLinkFrame> decodeAll(HubLinkDecoder &decoder, const std::vector<uint8_t> &bytes)
+{
+    std::vector<HubLinkFrame> frames;
+    for (uint8_t byte : bytes)
+    {
+        if (decoder.feed(byte))
+            frames.push_back(decoder.frame());
+    }
+    return frames;
+}
+
+bool sameFrame(const HubLinkFrame &a, const HubLinkFrame &b)
+{
+    return a.type == b.type && a.seq == b.seq && a.length == b.length && memcmp(a.payload, b.payload, a.length) == 0;
+}
+
+HubLinkFrame randomFrame(std::mt19937 &rng)
+{
+    HubLinkFrame frame;
+    frame.type = (uint8_t)rng();
+    frame.seq = (uint8_t)rng();
+    frame.length = (uint8_t)(rng() % (HUBLINK_MAX_PAYLOAD + 1));
+    for (uint8_t i = 0; i < frame.length; i++)
+        frame.payload[i] = (uint8_t)(rng() % 4 == 0 ? 0 : rng()); // Plenty of zeros for COBS
+    return frame;
+}
+
+} // namespace
+
+TEST(HubLinkCrc, MatchesCcittFalseCheckValue)
+{
+    const char check[] = "123456789";
+    EXPECT_EQ(hubLinkCrc16((const uint8_t *)check, 9), 0x29B1);
+}
+
+TEST(HubLinkCobs, RoundTripsAndRemovesZeros)
+{
+    std::mt19937 rng(2);
+    for (size_t length = 0; length < 600; length += 1 + length / 8)
+    {
+        std::vector<uint8_t> data(length);
+        for (uint8_t &byte : data)
+            byte = (uint8_t)(rng() % 3 == 0 ? 0 : rng());
+
+        std::vector<uint8_t> encoded(length + length / 254 + 1);
+        size_t encodedLength = hubLinkCobsEncode(data.data(), length, encoded.data());
+        ASSERT_LE(encodedLength, encoded.size());
+        for (size_t i = 0; i < encodedLength; i++)
+            ASSERT_NE(encoded[i], 0) << "length " << length << " byte " << i;
+
+        std::vector<uint8_t> decoded(encodedLength);
+        size_t decodedLength = hubLinkCobsDecode(encoded.data(), encodedLength, decoded.data());
+        ASSERT_EQ(decodedLength, length);
+        EXPECT_TRUE(std::equal(data.begin(), data.end(), decoded.begin()));
+    }
+}
+
+TEST(HubLinkFrame, TelemetryRoundTripsAtExtremes)
+{
+    const int16_t values[] = {-32768, -1, 0, 1, 453, 1000, 32767};
+    HubLinkDecoder decoder;
+    for (int16_t current : values)
+    {
+        HubLinkFrame frame;
+        hubLinkMakeTelemetry(frame, 7, current, (int16_t)(current / 2), (int16_t)~current);
+        std::vector<HubLinkFrame> frames = decodeAll(decoder, wire(frame));
+        ASSERT_EQ(frames.size(), 1u);
+
+        int16_t current2, min2, max2;
+        ASSERT_TRUE(hubLinkReadTelemetry(frames[0], current2, min2, max2));
+        EXPECT_EQ(current2, current);
+        EXPECT_EQ(min2, (int16_t)(current / 2));
+        EXPECT_EQ(max2, (int16_t)~current);
+        EXPECT_EQ(frames[0].seq, 7);
+    }
+}
+
+TEST(HubLinkFrame, RandomFramesRoundTrip)
+{
+    std::mt19937 rng(1);
+    HubLinkDecoder decoder;
+    for (int i = 0; i < 5000; i++)
+    {
+        HubLinkFrame frame = randomFrame(rng);
+        std::vector<uint8_t> bytes = wire(frame);
+        ASSERT_LE(bytes.size(), HUBLINK_MAX_WIRE_SIZE);
+        std::vector<HubLinkFrame> frames = decodeAll(decoder, bytes);
+        ASSERT_EQ(frames.size(), 1u);
+        EXPECT_TRUE(sameFrame(frames[0], frame));
+    }
+    EXPECT_EQ(decoder.rejectedFrames(), 0u);
+}
+
+TEST(HubLinkFrame, OversizedPayloadIsNotEncoded)
+{
+    HubLinkFrame frame = {};
+    frame.length = HUBLINK_MAX_PAYLOAD + 1;
+    uint8_t out[HUBLINK_MAX_WIRE_SIZE];
+    EXPECT_EQ(hubLinkEncode(frame, out), 0u);
+}
+
+TEST(HubLinkDecoderFuzz, EverySingleBitFlipIsRejected)
+{
+    HubLinkFrame frame;
+    hubLinkMakeTelemetry(frame, 42, 453, 300, 600);
+    std::vector<uint8_t> clean = wire(frame);
+
+    // Delimiters excluded: flipping one only splits or joins frames
+    for (size_t byte = 1; byte + 1 < clean.size(); byte++)
+    {
+        for (int bit = 0; bit < 8; bit++)
+        {
+            std::vector<uint8_t> damaged = clean;
+            damaged[byte] ^= (uint8_t)(1 << bit);
+            HubLinkDecoder decoder;
+            EXPECT_TRUE(decodeAll(decoder, damaged).empty()) << "byte " << byte << " bit " << bit;
+        }
+    }
+}
+
+TEST(HubLinkDecoderFuzz, ResyncsAfterGarbage)
+{
+    std::mt19937 rng(3);
+    HubLinkDecoder decoder;
+    size_t recovered = 0;
+    const int rounds = 2000;
+    for (int i = 0; i < rounds; i++)
+    {
+        // Random bytes, sometimes longer than any frame, then a valid frame
+        std::vector<uint8_t> garbage(rng() % 120);
+        for (uint8_t &byte : garbage)
+            byte = (uint8_t)rng();
+        decodeAll(decoder, garbage);
+
+        HubLinkFrame frame = randomFrame(rng);
+        std::vector<HubLinkFrame> frames = decodeAll(decoder, wire(frame));
+        ASSERT_FALSE(frames.empty());
+        recovered += sameFrame(frames.back(), frame);
+    }
+    EXPECT_EQ(recovered, (size_t)rounds);
+}
+
+TEST(HubLinkSequence, CountsLostFramesAcrossTheWrap)
+{
+    HubLinkSequence sequence;
+    EXPECT_EQ(sequence.track(250), 0); // The first frame heard sets the baseline
+    EXPECT_EQ(sequence.track(251), 0);
+    EXPECT_EQ(sequence.track(254), 2);
+    EXPECT_EQ(sequence.track(255), 0);
+    EXPECT_EQ(sequence.track(0), 0); // The ordinary wrap
+    EXPECT_EQ(sequence.track(3), 2);
+    EXPECT_EQ(sequence.gaps(), 4u);
+    EXPECT_EQ(sequence.restarts(), 0u);
+}
+
+TEST(HubLinkSequence, NanoRestartIsNotLoss)
+{
+    // A restart after seq N used to count as 255 - N lost frames whenever that was under 128,
+    // i.e. up to 127 phantom gaps for any restart after seq 128 or later
+    for (uint8_t last : {(uint8_t)5, (uint8_t)40, (uint8_t)130, (uint8_t)200})
+    {
+        HubLinkSequence sequence;
+        for (uint8_t seq = 0; seq <= last; seq++)
+            sequence.track(seq);
+        EXPECT_EQ(sequence.track(0), 0) << "restart after " << (int)last;
+        EXPECT_EQ(sequence.track(1), 0);
+        EXPECT_EQ(sequence.gaps(), 0u) << "restart after " << (int)last;
+        EXPECT_EQ(sequence.restarts(), 1u) << "restart after " << (int)last;
+    }
+}
+
+TEST(HubLinkSequence, LostRestartFrameIsOneJump)
+{
+    // The documented bias: with seq 0 lost, the restart shows only as a jump back
+    HubLinkSequence sequence;
+    for (uint8_t seq = 0; seq <= 100; seq++)
+        sequence.track(seq);
+    EXPECT_EQ(sequence.track(1), 0); // 156 ahead: past half the space, so a restart
+    EXPECT_EQ(sequence.restarts(), 1u);
+    EXPECT_EQ(sequence.gaps(), 0u);
+}
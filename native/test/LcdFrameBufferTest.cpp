@@ -0,0 +1,139 @@
+/**
+ * @file LcdFrameBufferTest.cpp
+ * @brief I2C traffic of LcdFrameBuffer on the simulated PCF8574/HD44780, counted at the Wire level,
+ * for the sensor screen updates the Nano makes, against redrawing both rows each time.
+ */
+
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <LiquidCrystal_I2C.h>
+#include <Wire.h>
+#include "LcdFrameBuffer.h"
+
+namespace
+{
+
+// Each HD44780 byte: two nibbles, three expander writes each, one I2C transaction per write
+const uint32_t TRANSACTIONS_PER_LCD_BYTE = 6;
+
+class LcdFrameBufferTest : public ::testing::Test
+{
+protected:
+    LcdFrameBufferTest() : lcd(0x27, 16, 2), screen(lcd)
+    {
+        lcd.init();
+        lcd.backlight();
+        Wire.shimResetCounters();
+    }
+
+    /** The sensor screen as drawSensorScreen() in Arduino_Nano.ino composes it */
+    void drawSensorScreen(float current, float min, float max)
+    {
+        screen.clear();
+        screen.setCursor(0, 0);
+        screen.print("Humidity: ");
+        screen.print(current, 1);
+        screen.print("%");
+        screen.setCursor(0, 1);
+        screen.print("L:");
+        screen.print(min, 0);
+        screen.print("%  H:");
+        screen.print(max, 0);
+        screen.print("%");
+        screen.render();
+    }
+
+    /** The sketch before the framebuffer: clear() and both rows on every sample */
+    void redrawSensorScreen(float current, float min, float max)
+    {
+        lcd.clear();
+        lcd.setCursor(0, 0);
+        lcd.print("Humidity: ");
+        lcd.print(current, 1);
+        lcd.print("%");
+        lcd.setCursor(0, 1);
+        lcd.print("L:");
+        lcd.print(min, 0);
+        lcd.print("%  H:");
+        lcd.print(max, 0);
+        lcd.print("%");
+    }
+
+    LiquidCrystal_I2C lcd;
+    LcdFrameBuffer<16, 2> screen;
+};
+
+} // namespace
+
+TEST_F(LcdFrameBufferTest, FirstFrameWritesOnlyNonBlankCells)
+{
+    drawSensorScreen(45.0, 30, 60);
+    EXPECT_EQ(lcd.shimRow(0), "Humidity: 45.0% ");
+    EXPECT_EQ(lcd.shimRow(1), "L:30%  H:60%    ");
+
+    // "Humidity:" and "45.0%" are split by a blank, as are "L:30%" and "H:60%"
+    EXPECT_EQ(screen.stats().cursorMoves, 4);
+    EXPECT_EQ(screen.stats().cellsWritten, 24);
+    EXPECT_EQ(Wire.shimTransactions(), (4u + 24u) * TRANSACTIONS_PER_LCD_BYTE);
+    EXPECT_EQ(Wire.shimBytes(), screen.stats().busBytes);
+}
+
+TEST_F(LcdFrameBufferTest, TenthChangeCostsOneCell)
+{
+    drawSensorScreen(45.0, 30, 60);
+    Wire.shimResetCounters();
+
+    drawSensorScreen(45.1, 30, 60);
+    EXPECT_EQ(lcd.shimRow(0), "Humidity: 45.1% ");
+    EXPECT_EQ(screen.stats().cursorMoves, 1);
+    EXPECT_EQ(screen.stats().cellsWritten, 1);
+    EXPECT_EQ(Wire.shimTransactions(), 2 * TRANSACTIONS_PER_LCD_BYTE);
+    EXPECT_EQ(Wire.shimBytes(), screen.stats().busBytes);
+}
+
+TEST_F(LcdFrameBufferTest, UnchangedFrameSendsNothing)
+{
+    drawSensorScreen(45.0, 30, 60);
+    Wire.shimResetCounters();
+
+    drawSensorScreen(45.0, 30, 60);
+    EXPECT_EQ(screen.stats().cellsWritten, 0);
+    EXPECT_EQ(Wire.shimTransactions(), 0u);
+}
+
+TEST_F(LcdFrameBufferTest, NewMaximumTouchesBothRows)
+{
+    drawSensorScreen(59.0, 30, 60);
+    Wire.shimResetCounters();
+
+    drawSensorScreen(61.0, 30, 61);
+    EXPECT_EQ(lcd.shimRow(0), "Humidity: 61.0% ");
+    EXPECT_EQ(lcd.shimRow(1), "L:30%  H:61%    ");
+    EXPECT_EQ(screen.stats().cursorMoves, 2);
+    EXPECT_EQ(screen.stats().cellsWritten, 3); // "61" on row 0, "1" on row 1
+    EXPECT_EQ(Wire.shimTransactions(), 5 * TRANSACTIONS_PER_LCD_BYTE);
+}
+
+TEST_F(LcdFrameBufferTest, TypicalSamplesUseFarLessBusThanRedrawing)
+{
+    // A slow drift of one tenth per sample, as the DHT11 usually reports
+    const int samples = 50;
+    drawSensorScreen(45.0, 30, 60);
+    Wire.shimResetCounters();
+    for (int i = 1; i <= samples; i++)
+        drawSensorScreen(45.0f + i / 10.0f, 30, 60);
+    uint32_t diffTransactions = Wire.shimTransactions();
+
+    redrawSensorScreen(45.0, 30, 60);
+    Wire.shimResetCounters();
+    for (int i = 1; i <= samples; i++)
+        redrawSensorScreen(45.0f + i / 10.0f, 30, 60);
+    uint32_t redrawTransactions = Wire.shimTransactions();
+
+    // Redrawing: clear + 2 cursor moves + 27 characters per sample
+    EXPECT_EQ(redrawTransactions, samples * 30 * TRANSACTIONS_PER_LCD_BYTE);
+    // Diffing: one or two cells (a carry into the units digit) per sample
+    EXPECT_LE(diffTransactions, samples * 3 * TRANSACTIONS_PER_LCD_BYTE);
+    RecordProperty("transactions_per_sample_diff", (int)(diffTransactions / samples));
+    RecordProperty("transactions_per_sample_redraw", (int)(redrawTransactions / samples));
+}
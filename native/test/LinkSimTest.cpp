@@ -0,0 +1,164 @@
+/**
+ * @file LinkSimTest.cpp
+ * @brief The Nano -> ESP32 link under LinkSim.h: clean delivery and its latency, seeded
+ * reproducibility, noise in either link format, baud mismatch, both kinds of back-pressure
+ * and Nano restarts. Each run prints its [LINKSIM] report.
+ */
+
+#include <gtest/gtest.h>
+#include "LinkSim.h"
+
+namespace
+{
+
+linksim::Report runAndPrint(const linksim::Config &config)
+{
+    linksim::Report report = linksim::run(config);
+    linksim::print(config, report, stdout);
+    return report;
+}
+
+linksim::Config noisy(uint32_t seed)
+{
+    linksim::Config config;
+    config.seed = seed;
+    config.faults = {0, 1000, 2000, 200, 16};
+    return config;
+}
+
+/** Frame on the wire, the driver's idle timeout, one loop() pass and the Nano's scheduling jitter */
+uint32_t cleanLatencyBoundMicros(size_t wireBytes)
+{
+    return (uint32_t)(wireBytes * 10 * 1000000 / 9600 + 10 * 10 * 1000000 / 9600 + 1000 + 2000);
+}
+
+} // namespace
+
+TEST(LinkSim, CleanLinkDeliversEverySampleAndCommand)
+{
+    for (linksim::Format format : {linksim::Format::Binary, linksim::Format::Ascii})
+    {
+        linksim::Config config;
+        config.format = format;
+        linksim::Report report = runAndPrint(config);
+        EXPECT_EQ(report.samplesSent, config.seconds / 2);
+        EXPECT_EQ(report.samplesDelivered, report.samplesSent);
+        EXPECT_EQ(report.samplesCorrupted, 0u);
+        EXPECT_EQ(report.commandsAccepted, report.commandsSent);
+        EXPECT_EQ(report.sequenceGaps, 0u);
+        // 15 bytes for a HubLink telemetry frame, up to 52 for a [DHT11] line
+        size_t wireBytes = format == linksim::Format::Binary ? 15 : 52;
+        EXPECT_LE(report.latencyPercentile(1.0), cleanLatencyBoundMicros(wireBytes));
+    }
+}
+
+TEST(LinkSim, SameSeedReproducesTheRun)
+{
+    linksim::Report first = linksim::run(noisy(7));
+    linksim::Report again = linksim::run(noisy(7));
+    linksim::Report other = linksim::run(noisy(8));
+
+    EXPECT_EQ(again.latencyMicros, first.latencyMicros);
+    EXPECT_EQ(again.samplesDelivered, first.samplesDelivered);
+    EXPECT_EQ(again.rejectedFrames, first.rejectedFrames);
+    EXPECT_EQ(again.sequenceGaps, first.sequenceGaps);
+    EXPECT_EQ(again.commandsAccepted, first.commandsAccepted);
+    EXPECT_NE(other.latencyMicros, first.latencyMicros);
+}
+
+TEST(LinkSim, BinaryLinkNeverAcceptsNoise)
+{
+    for (uint32_t seed = 1; seed <= 5; seed++)
+    {
+        linksim::Config config = noisy(seed);
+        config.seconds = 86400;
+        linksim::Report report = runAndPrint(config);
+        EXPECT_EQ(report.samplesCorrupted, 0u) << "seed " << seed;
+        EXPECT_EQ(report.commandsCorrupted, 0u) << "seed " << seed;
+        EXPECT_GT(report.rejectedFrames, 0u) << "seed " << seed;
+        EXPECT_GT(report.samplesDelivered, report.samplesSent * 9 / 10) << "seed " << seed;
+        // Gaps only see losses between two frames that arrived, never more than were lost
+        EXPECT_GT(report.sequenceGaps, 0u) << "seed " << seed;
+        EXPECT_LE(report.sequenceGaps, report.samplesLost) << "seed " << seed;
+    }
+}
+
+TEST(LinkSim, AsciiLinkCanAcceptDamagedLines)
+{
+    // No checksum: a flipped digit can still make a plausible line. Why binary is the default.
+    linksim::Config config = noisy(1);
+    config.format = linksim::Format::Ascii;
+    config.seconds = 86400;
+    linksim::Report report = runAndPrint(config);
+    EXPECT_GT(report.malformedLines, 0u);
+    EXPECT_GT(report.samplesCorrupted, 0u);
+    RecordProperty("ascii_corrupted_samples", (int)report.samplesCorrupted);
+}
+
+TEST(LinkSim, BaudMismatchWithinToleranceIsHarmless)
+{
+    for (uint32_t hubBaud : {9312u, 9600u, 9888u}) // -3%, 0, +3%
+    {
+        linksim::Config config;
+        config.hubBaud = hubBaud;
+        linksim::Report report = runAndPrint(config);
+        EXPECT_EQ(report.framingErrors, 0u) << hubBaud << " baud";
+        EXPECT_EQ(report.samplesDelivered, report.samplesSent) << hubBaud << " baud";
+        EXPECT_EQ(report.commandsAccepted, report.commandsSent) << hubBaud << " baud";
+    }
+}
+
+TEST(LinkSim, BaudMismatchBeyondToleranceLosesTheLinkCleanly)
+{
+    for (uint32_t hubBaud : {8832u, 10368u}) // -8%, +8%
+    {
+        linksim::Config config;
+        config.hubBaud = hubBaud;
+        linksim::Report report = runAndPrint(config);
+        EXPECT_GT(report.framingErrors, 0u) << hubBaud << " baud";
+        EXPECT_LT(report.samplesDelivered, report.samplesSent / 100) << hubBaud << " baud";
+        EXPECT_EQ(report.samplesCorrupted, 0u) << hubBaud << " baud";
+        EXPECT_EQ(report.commandsCorrupted, 0u) << hubBaud << " baud";
+    }
+}
+
+TEST(LinkSim, LoopStallsDelayUntilTheRingIsFull)
+{
+    // The ring holds 16 samples, 32 s at the Nano's cadence
+    linksim::Config config;
+    config.loopStallEverySeconds = 300;
+    config.loopStallMs = 20000;
+    linksim::Report report = runAndPrint(config);
+    EXPECT_EQ(report.ringDrops, 0u);
+    EXPECT_EQ(report.samplesDelivered, report.samplesSent);
+    EXPECT_GE(report.latencyPercentile(1.0), 18000000u);
+
+    config.loopStallMs = 40000;
+    report = runAndPrint(config);
+    EXPECT_GT(report.ringDrops, 0u);
+    EXPECT_EQ(report.samplesLost, report.ringDrops);
+    EXPECT_EQ(report.sequenceGaps, 0u); // Lost after decoding, so the sequence saw them all
+}
+
+TEST(LinkSim, IngestStallsOverflowTheDriverBuffer)
+{
+    // 1024 bytes of driver buffer hold about 68 binary frames, 136 s of telemetry
+    linksim::Config config;
+    config.ingestStallEverySeconds = 600;
+    config.ingestStallMs = 200000;
+    linksim::Report report = runAndPrint(config);
+    EXPECT_GT(report.sequenceGaps, 0u); // Dropped by the driver, before any decoder saw them
+    EXPECT_GT(report.ringDrops, 0u);    // The backlog arrives at once, more than the ring holds
+    EXPECT_EQ(report.samplesCorrupted, 0u);
+    EXPECT_EQ(report.samplesLost, report.sequenceGaps + report.ringDrops);
+}
+
+TEST(LinkSim, NanoRestartsAreNotCountedAsGaps)
+{
+    linksim::Config config;
+    config.nanoRestartEverySeconds = 500;
+    linksim::Report report = runAndPrint(config);
+    EXPECT_EQ(report.senderRestarts, config.seconds / config.nanoRestartEverySeconds);
+    EXPECT_EQ(report.sequenceGaps, 0u);
+    EXPECT_EQ(report.samplesDelivered, report.samplesSent);
+}
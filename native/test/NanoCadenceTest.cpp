@@ -0,0 +1,83 @@
+/**
+ * @file NanoCadenceTest.cpp
+ * @brief Runs Arduino_Nano.ino on the virtual clock and checks that telemetry keeps its
+ * SENSOR_INTERVAL cadence while reset and web-message overlays are on the LCD.
+ */
+
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include <HubLink.h>
+#include <LiquidCrystal_I2C.h>
+#include "ShimDht11.h"
+
+#include <string>
+#include <vector>
+
+// Arduino_Nano.ino
+extern LiquidCrystal_I2C lcd;
+
+namespace
+{
+
+const long SENSOR_INTERVAL_MS = 2000; // SENSOR_INTERVAL in Arduino_Nano.ino
+const uint8_t DHT_PIN = 4;            // PIN_DHT
+const uint64_t STEP_US = 1000;
+
+void sendCommand(uint8_t type, const char *text = nullptr)
+{
+    static uint8_t seq = 0;
+    HubLinkFrame frame;
+    hubLinkMakeCommand(frame, type, seq++, text, text ? strlen(text) : 0);
+    uint8_t wire[HUBLINK_MAX_WIRE_SIZE];
+    Serial.shimLineReceive(wire, hubLinkEncode(frame, wire));
+}
+
+} // namespace
+
+TEST(NanoCadence, TelemetryKeepsIntervalWhileOverlaysShow)
+{
+    shim::clock().useManual(0);
+    shim::dht11().attach(DHT_PIN);
+    shim::dht11().set(48, 21);
+    Serial.shimCapture(true);
+    setup();
+
+    HubLinkDecoder decoder;
+    std::vector<unsigned long> telemetryTimes;
+    std::vector<std::string> overlaysSeen;
+
+    // One minute of loop() passes, one per virtual millisecond, with commands arriving meanwhile
+    for (unsigned long ms = 0; ms < 60000; ms++)
+    {
+        if (ms == 5000)
+            sendCommand(HUBLINK_MESSAGE, "hello");
+        if (ms == 7000 || ms == 21000)
+            sendCommand(HUBLINK_RESET);
+        if (ms == 20000)
+            sendCommand(HUBLINK_MESSAGE, "second message");
+
+        shim::clock().advance(STEP_US);
+        loop();
+
+        for (char c : Serial.shimTakeOutput())
+        {
+            if (decoder.feed((uint8_t)c) && decoder.frame().type == HUBLINK_TELEMETRY)
+                telemetryTimes.push_back(millis());
+        }
+        std::string row0 = lcd.shimRow(0);
+        if (row0.find("WEB MESSAGE") == 0 || row0.find(">> RESETTING") == 0)
+        {
+            if (overlaysSeen.empty() || overlaysSeen.back() != row0)
+                overlaysSeen.push_back(row0);
+        }
+    }
+
+    ASSERT_GE(overlaysSeen.size(), 4u) << "every command should have shown its overlay";
+    ASSERT_GE(telemetryTimes.size(), 29u);
+    for (size_t i = 1; i < telemetryTimes.size(); i++)
+    {
+        long interval = (long)(telemetryTimes[i] - telemetryTimes[i - 1]);
+        EXPECT_NEAR(interval, SENSOR_INTERVAL_MS, 1) << "sample " << i << " at " << telemetryTimes[i] << " ms";
+    }
+    EXPECT_EQ(Serial.shimRxOverflows(), 0u);
+}
@@ -0,0 +1,149 @@
+/**
+ * @file SpscRingStressTest.cpp
+ * @brief SpscRing between two host threads, built with ThreadSanitizer when the compiler
+ * has it (see CMakeLists.txt): a producer and a consumer hammer rings from 1 to 256 slots
+ * with multi-word items. Every item must arrive once, in order and untorn, and TSAN must
+ * see no race on the slots or the indices.
+ */
+
+#include <gtest/gtest.h>
+#include "SpscRing.h"
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+
+const size_t UART_INGEST_RING = 16; // UartIngest.h
+const uint32_t ITEMS = 200000;
+
+/** Larger than any atomic, so a slot read while being written shows up as a bad check */
+struct Item
+{
+    uint32_t seq;
+    uint32_t words[5];
+    uint32_t check;
+};
+
+Item makeItem(uint32_t seq)
+{
+    Item item;
+    item.seq = seq;
+    item.check = seq;
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        item.words[i] = seq * 2654435761u + i;
+        item.check ^= item.words[i];
+    }
+    return item;
+}
+
+bool intact(const Item &item)
+{
+    uint32_t check = item.seq;
+    for (uint32_t i = 0; i < 5; i++)
+        check ^= item.words[i];
+    return check == item.check && item.words[0] == item.seq * 2654435761u;
+}
+
+struct Result
+{
+    uint32_t received = 0;
+    uint32_t outOfOrder = 0;
+    uint32_t torn = 0;
+    uint32_t fullPushes = 0; // Producer found the ring full
+    uint32_t emptyPops = 0;  // Consumer found it empty
+    size_t maxDepth = 0;     // Deepest the consumer saw it
+};
+
+template <size_t Capacity> Result stress()
+{
+    static SpscRing<Item, Capacity> ring;
+    Result result;
+    std::atomic<bool> start{false};
+
+    std::thread producer([&] {
+        while (!start.load(std::memory_order_acquire))
+            std::this_thread::yield();
+        for (uint32_t seq = 0; seq < ITEMS;)
+        {
+            if (ring.push(makeItem(seq)))
+                seq++;
+            else
+            {
+                result.fullPushes++;
+                std::this_thread::yield(); // Lets the consumer run on a single-core host
+            }
+        }
+    });
+
+    std::thread consumer([&] {
+        while (!start.load(std::memory_order_acquire))
+            std::this_thread::yield();
+        uint32_t expected = 0;
+        Item item;
+        while (expected < ITEMS)
+        {
+            size_t depth = ring.size(); // Exact from the consumer's side
+            if (depth > result.maxDepth)
+                result.maxDepth = depth;
+            if (!ring.pop(item))
+            {
+                result.emptyPops++;
+                std::this_thread::yield();
+                continue;
+            }
+            if (item.seq != expected)
+                result.outOfOrder++;
+            if (!intact(item))
+                result.torn++;
+            expected = item.seq + 1;
+            result.received++;
+        }
+    });
+
+    start.store(true, std::memory_order_release);
+    producer.join();
+    consumer.join();
+    return result;
+}
+
+template <size_t Capacity> void expectClean(const Result &result)
+{
+    EXPECT_EQ(result.received, ITEMS);
+    EXPECT_EQ(result.outOfOrder, 0u);
+    EXPECT_EQ(result.torn, 0u);
+    EXPECT_LE(result.maxDepth, Capacity);
+    printf("[SPSC] capacity %zu: %u items, %u full pushes, %u empty pops, max depth %zu\n", Capacity,
+           result.received, result.fullPushes, result.emptyPops, result.maxDepth);
+}
+
+} // namespace
+
+TEST(SpscRingStress, SingleSlotHandsOverEveryItem) { expectClean<1>(stress<1>()); }
+
+TEST(SpscRingStress, IngestSizedRing) { expectClean<UART_INGEST_RING>(stress<UART_INGEST_RING>()); }
+
+TEST(SpscRingStress, LargeRingRunsAhead) { expectClean<256>(stress<256>()); }
+
+TEST(SpscRingStress, FullAndEmptyEdges)
+{
+    static SpscRing<Item, 4> ring;
+    Item item;
+    EXPECT_FALSE(ring.pop(item));
+    for (uint32_t round = 0; round < 3; round++)
+    {
+        for (uint32_t i = 0; i < 4; i++)
+            ASSERT_TRUE(ring.push(makeItem(round * 4 + i)));
+        EXPECT_FALSE(ring.push(makeItem(99))) << "all four slots are usable, no fifth";
+        EXPECT_EQ(ring.size(), 4u);
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            ASSERT_TRUE(ring.pop(item));
+            EXPECT_EQ(item.seq, round * 4 + i);
+        }
+        EXPECT_FALSE(ring.pop(item));
+        EXPECT_EQ(ring.size(), 0u);
+    }
+}
@@ -0,0 +1,216 @@
+/**
+ * @file StatisticsTest.cpp
+ * @brief Statistics.h against exact references: two-pass mean / stddev in long double over
+ * the same windows, the EWMA recurrence in double and sorted-array quantiles for P-square.
+ */
+
+#include <gtest/gtest.h>
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+struct Exact
+{
+    long double mean;
+    long double stddev;
+};
+
+/** Two-pass mean and sample stddev of values[first, last) */
+Exact twoPass(const std::vector<int16_t> &values, size_t first, size_t last)
+{
+    long double sum = 0;
+    for (size_t i = first; i < last; i++)
+        sum += values[i];
+    long double mean = sum / (last - first);
+    long double squares = 0;
+    for (size_t i = first; i < last; i++)
+        squares += (values[i] - mean) * (values[i] - mean);
+    return {mean, last - first > 1 ? sqrtl(squares / (last - first - 1)) : 0};
+}
+
+/** Nearest-rank quantile of a sorted copy, the definition P2Quantile uses for its first samples */
+float sortedQuantile(std::vector<float> values, float p)
+{
+    std::sort(values.begin(), values.end());
+    return values[(size_t)(p * (values.size() - 1) + 0.5f)];
+}
+
+/** A DHT11 indoors: whole percents drifting over the day, some sensor noise */
+std::vector<int16_t> humidityTrace(size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, 8.0f);
+    std::vector<int16_t> values;
+    for (size_t i = 0; i < count; i++)
+    {
+        float daily = 100.0f * sinf((float)i * 2 * (float)M_PI / 43200);
+        values.push_back((int16_t)(lroundf((450 + daily + noise(rng)) / 10) * 10));
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(Statistics, RollingWindowMatchesTwoPassAsItSlides)
+{
+    const size_t capacity = 150;
+    std::vector<int16_t> values = humidityTrace(100000, 1);
+    RollingWindow window;
+    ASSERT_TRUE(window.begin(capacity));
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        window.add(values[i]);
+        if (i % 997 != 0 && i + 1 != values.size() && i > 3)
+            continue;
+        size_t first = i + 1 > capacity ? i + 1 - capacity : 0;
+        Exact exact = twoPass(values, first, i + 1);
+        ASSERT_EQ(window.size(), i + 1 - first);
+        // Exact integer sums: the only error is the final float conversion, however long it runs
+        ASSERT_NEAR(window.mean(), (float)exact.mean, 1e-6 * fabsl(exact.mean)) << "after " << i + 1;
+        ASSERT_NEAR(window.stddev(), (float)exact.stddev, 1e-5 * exact.stddev + 1e-6) << "after " << i + 1;
+    }
+}
+
+TEST(Statistics, RollingWindowOfOneAndConstantInput)
+{
+    RollingWindow window;
+    ASSERT_TRUE(window.begin(1));
+    window.add(450);
+    window.add(-20);
+    EXPECT_EQ(window.size(), 1u);
+    EXPECT_FLOAT_EQ(window.mean(), -20.0f);
+    EXPECT_FLOAT_EQ(window.stddev(), 0.0f);
+
+    RollingWindow constant;
+    ASSERT_TRUE(constant.begin(10));
+    for (int i = 0; i < 25; i++)
+        constant.add(INT16_MAX);
+    EXPECT_FLOAT_EQ(constant.mean(), (float)INT16_MAX);
+    EXPECT_FLOAT_EQ(constant.stddev(), 0.0f);
+}
+
+TEST(Statistics, WelfordMatchesTwoPassWithLargeOffset)
+{
+    // Large mean, small spread: where the naive sum-of-squares formula cancels catastrophically
+    std::mt19937 rng(2);
+    std::uniform_int_distribution<int> jitter(-5, 5);
+    std::vector<int16_t> values;
+    for (int i = 0; i < 200000; i++)
+        values.push_back((int16_t)(32000 + jitter(rng)));
+
+    Welford welford;
+    for (int16_t value : values)
+        welford.add(value);
+    Exact exact = twoPass(values, 0, values.size());
+    EXPECT_EQ(welford.count(), values.size());
+    EXPECT_NEAR(welford.mean(), (float)exact.mean, 1e-3);
+    EXPECT_NEAR(welford.stddev(), (float)exact.stddev, 1e-4 * exact.stddev);
+}
+
+TEST(Statistics, EwmaFollowsItsRecurrence)
+{
+    std::vector<int16_t> values = humidityTrace(5000, 3);
+    const double alpha = 0.1;
+    Ewma ewma((float)alpha);
+    double reference = values[0];
+    ewma.add(values[0]);
+    EXPECT_FLOAT_EQ(ewma.value(), values[0]); // Primed by the first sample, not pulled from 0
+    for (size_t i = 1; i < values.size(); i++)
+    {
+        ewma.add(values[i]);
+        reference += alpha * (values[i] - reference);
+        ASSERT_NEAR(ewma.value(), reference, 1e-3) << "after " << i + 1;
+    }
+
+    // A step settles as (1 - alpha)^n
+    Ewma step((float)alpha);
+    step.add(0);
+    for (int n = 1; n <= 30; n++)
+        step.add(1000);
+    EXPECT_NEAR(step.value(), 1000 * (1 - pow(1 - alpha, 30)), 1e-2);
+}
+
+TEST(Statistics, P2QuantileIsExactBeforeItHasFiveMarkers)
+{
+    const float samples[] = {470, 430, 510, 450};
+    P2Quantile p50(0.5f);
+    P2Quantile p95(0.95f);
+    std::vector<float> seen;
+    for (float sample : samples)
+    {
+        p50.add(sample);
+        p95.add(sample);
+        seen.push_back(sample);
+        EXPECT_FLOAT_EQ(p50.value(), sortedQuantile(seen, 0.5f)) << seen.size() << " samples";
+        EXPECT_FLOAT_EQ(p95.value(), sortedQuantile(seen, 0.95f)) << seen.size() << " samples";
+    }
+}
+
+TEST(Statistics, P2QuantileTracksSortedQuantiles)
+{
+    struct Case
+    {
+        const char *name;
+        std::vector<float> values;
+        float resolution; // Spacing of the input values; 0 for continuous data
+    };
+    std::mt19937 rng(4);
+    std::normal_distribution<float> normal(450, 60);
+    std::exponential_distribution<float> exponential(1.0f / 40);
+    std::vector<float> gaussian, skewed, trace;
+    for (int i = 0; i < 20000; i++)
+    {
+        gaussian.push_back(normal(rng));
+        skewed.push_back(300 + exponential(rng));
+    }
+    for (int16_t value : humidityTrace(43200, 5))
+        trace.push_back(value);
+    const Case cases[] = {{"normal", gaussian, 0}, {"exponential", skewed, 0}, {"dht11 day", trace, 10}};
+
+    for (const Case &c : cases)
+    {
+        for (float p : {0.5f, 0.95f})
+        {
+            P2Quantile estimate(p);
+            for (float value : c.values)
+                estimate.add(value);
+            float exact = sortedQuantile(c.values, p);
+            std::vector<float> sorted = c.values;
+            std::sort(sorted.begin(), sorted.end());
+            float range = sorted.back() - sorted.front();
+            // P-square is an estimate: within 2% of the data's range of the true quantile, plus
+            // one reading step when the input is quantized, as the DHT11's whole percents are
+            EXPECT_NEAR(estimate.value(), exact, 0.02f * range + c.resolution) << c.name << " p" << (int)(p * 100);
+            EXPECT_EQ(estimate.count(), c.values.size());
+        }
+    }
+}
+
+TEST(Statistics, HumidityStatsFeedsEveryEstimator)
+{
+    const size_t windows[STATS_WINDOW_COUNT] = {30, 300, 1800};
+    HumidityStats stats;
+    ASSERT_TRUE(stats.begin(windows));
+    std::vector<int16_t> values = humidityTrace(2000, 6);
+    for (int16_t value : values)
+        stats.add(value);
+
+    for (uint8_t i = 0; i < STATS_WINDOW_COUNT; i++)
+    {
+        Exact exact = twoPass(values, values.size() - windows[i], values.size());
+        EXPECT_NEAR(stats.window(i).mean(), (float)exact.mean, 1e-3) << "window " << (int)i;
+        EXPECT_NEAR(stats.window(i).stddev(), (float)exact.stddev, 1e-3) << "window " << (int)i;
+    }
+    Exact all = twoPass(values, 0, values.size());
+    EXPECT_NEAR(stats.lifetime().mean(), (float)all.mean, 1e-3);
+    EXPECT_NEAR(stats.lifetime().stddev(), (float)all.stddev, 1e-3);
+    EXPECT_EQ(stats.p50().count(), values.size());
+    EXPECT_LE(stats.p50().value(), stats.p95().value());
+}
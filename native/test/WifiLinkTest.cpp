@@ -0,0 +1,165 @@
+/**
+ * @file WifiLinkTest.cpp
+ * @brief WifiLink against the shim's scripted access point on manual time: first connect,
+ * a dropped link and its reconnect, an unreachable AP backing off, and the two ways the
+ * driver's events can mislead the state machine (coalesced and missed events).
+ */
+
+#include <gtest/gtest.h>
+#include <Arduino.h>
+#include "WifiLink.h"
+
+namespace
+{
+
+const unsigned long STEP_MS = 10; // loop() runs far more often; this is enough resolution here
+
+uint32_t ups = 0;
+uint32_t downs = 0;
+
+void onUp() { ups++; }
+void onDown() { downs++; }
+
+class WifiLinkTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        shim::clock().useManual(1000000);
+        shim::wifi().setReachable(true);
+        ups = 0;
+        downs = 0;
+        link.begin("ssid", "password", onUp, onDown, millis());
+    }
+
+    void TearDown() override { WiFi.disconnect(); } // While the link still exists to hear it
+
+    /** Runs loop() for ms of virtual time */
+    void run(unsigned long ms)
+    {
+        for (unsigned long elapsed = 0; elapsed < ms; elapsed += STEP_MS)
+        {
+            shim::clock().advance(STEP_MS * 1000);
+            link.update(millis());
+        }
+    }
+
+    WifiLink link;
+};
+
+} // namespace
+
+TEST_F(WifiLinkTest, ConnectsWithoutBlocking)
+{
+    EXPECT_EQ(link.state(), WIFI_LINK_CONNECTING);
+    run(100);
+    EXPECT_TRUE(link.connected());
+    EXPECT_EQ(link.connects(), 1u);
+    EXPECT_EQ(ups, 1u);
+    EXPECT_EQ(downs, 0u);
+}
+
+TEST_F(WifiLinkTest, DroppedLinkReconnectsAfterBackoff)
+{
+    run(100);
+    ASSERT_TRUE(link.connected());
+
+    shim::wifi().dropLink();
+    run(STEP_MS);
+    EXPECT_EQ(link.state(), WIFI_LINK_BACKOFF);
+    EXPECT_EQ(downs, 1u);
+    EXPECT_EQ(link.retryDelay(), WIFI_BACKOFF_MIN_MS);
+
+    run(WIFI_BACKOFF_MIN_MS + 100);
+    EXPECT_TRUE(link.connected());
+    EXPECT_EQ(link.connects(), 2u);
+    EXPECT_EQ(ups, 2u);
+    EXPECT_EQ(link.failedAttempts(), 0u);
+}
+
+TEST_F(WifiLinkTest, UnreachableApBacksOffExponentially)
+{
+    shim::wifi().setReachable(false);
+    uint32_t beginsBefore = shim::wifi().begins();
+    unsigned long expected = WIFI_BACKOFF_MIN_MS;
+    for (int attempt = 1; attempt <= 8; attempt++)
+    {
+        run(WIFI_CONNECT_TIMEOUT_MS);
+        ASSERT_EQ(link.state(), WIFI_LINK_BACKOFF) << "attempt " << attempt;
+        EXPECT_EQ(link.retryDelay(), expected) << "attempt " << attempt;
+        EXPECT_EQ(link.failedAttempts(), (uint32_t)attempt);
+        run(link.retryDelay());
+        expected = expected * 2 > WIFI_BACKOFF_MAX_MS ? WIFI_BACKOFF_MAX_MS : expected * 2;
+    }
+    EXPECT_EQ(link.retryDelay(), WIFI_BACKOFF_MAX_MS);
+    EXPECT_EQ(shim::wifi().begins() - beginsBefore, 8u); // One begin() per attempt, nothing in between
+    EXPECT_EQ(ups, 0u);
+
+    // The attempt under way when the AP returns still times out; the next one connects and
+    // resets the backoff
+    shim::wifi().setReachable(true);
+    run(WIFI_CONNECT_TIMEOUT_MS + WIFI_BACKOFF_MAX_MS + 100);
+    ASSERT_TRUE(link.connected());
+    shim::wifi().dropLink();
+    run(STEP_MS);
+    EXPECT_EQ(link.retryDelay(), WIFI_BACKOFF_MIN_MS);
+}
+
+TEST_F(WifiLinkTest, LostAfterGotIpInOneUpdateIsNotAConnection)
+{
+    // Both events land between two update() calls, the IP already gone again
+    shim::wifi().raise(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    shim::wifi().raise(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    link.update(millis());
+    EXPECT_EQ(link.state(), WIFI_LINK_BACKOFF);
+    EXPECT_EQ(link.failedAttempts(), 1u);
+    EXPECT_EQ(ups, 0u);
+
+    run(WIFI_BACKOFF_MIN_MS + 100);
+    EXPECT_TRUE(link.connected());
+}
+
+TEST_F(WifiLinkTest, DisconnectThenGotIpInOneUpdateConnects)
+{
+    // The teardown's disconnect around WiFi.begin(), then the attempt succeeds, all before update()
+    shim::wifi().raise(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    shim::wifi().raise(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    link.update(millis());
+    EXPECT_TRUE(link.connected());
+    EXPECT_EQ(link.connects(), 1u);
+    EXPECT_EQ(link.failedAttempts(), 0u);
+    EXPECT_EQ(ups, 1u);
+}
+
+TEST_F(WifiLinkTest, MissedDisconnectEventIsCaughtByStatus)
+{
+    run(100);
+    ASSERT_TRUE(link.connected());
+
+    shim::wifi().dropLinkSilently();
+    run(STEP_MS);
+    EXPECT_EQ(link.state(), WIFI_LINK_BACKOFF);
+    EXPECT_EQ(downs, 1u);
+
+    run(WIFI_BACKOFF_MIN_MS + 100);
+    EXPECT_TRUE(link.connected());
+    EXPECT_EQ(link.connects(), 2u);
+}
+
+TEST_F(WifiLinkTest, FlappingLinkRecoversEveryTime)
+{
+    run(100);
+    for (int drop = 1; drop <= 20; drop++)
+    {
+        ASSERT_TRUE(link.connected()) << "drop " << drop;
+        if (drop % 2)
+            shim::wifi().dropLink();
+        else
+            shim::wifi().dropLinkSilently();
+        run(WIFI_BACKOFF_MIN_MS + 100);
+    }
+    EXPECT_TRUE(link.connected());
+    EXPECT_EQ(link.connects(), 21u);
+    EXPECT_EQ(downs, 20u);
+    EXPECT_EQ(link.failedAttempts(), 0u);
+}
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+Packs ESP32/web/index.html into ESP32/IndexHtml.h for the web hub.
+
+The page is minified, gzip-compressed and emitted as a PROGMEM byte array,
+together with a strong ETag derived from the compressed content. handleRoot()
+serves the array as-is with Content-Encoding: gzip and answers 304 when the
+browser already holds the current ETag.
+
+Run after every edit of index.html:
+    python3 tools/build_dashboard.py
+Verify the committed header is up to date (non-zero exit if stale):
+    python3 tools/build_dashboard.py --check
+Write the minified page the header inflates to, for the host tests:
+    python3 tools/build_dashboard.py --minified index.min.html
+"""
+
+import argparse
+import gzip
+import hashlib
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SOURCE = ROOT / "ESP32" / "web" / "index.html"
+OUTPUT = ROOT / "ESP32" / "IndexHtml.h"
+
+BYTES_PER_LINE = 16
+
+
+def minify(html: str) -> str:
+    """Conservative minification: trims indentation and drops blank and whole-line // comments.
+    Line breaks are kept so JavaScript automatic semicolon insertion behaves as in the source."""
+    lines = []
+    for line in html.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    text = "\n".join(lines)
+    # Whitespace between tags carries no meaning in this page
+    return re.sub(r">\n<", "><", text)
+
+
+def compress(text: str) -> bytes:
+    # mtime=0 keeps the output, and therefore the ETag, reproducible
+    return gzip.compress(text.encode("utf-8"), compresslevel=9, mtime=0)
+
+
+def render_header(original: str, minified: str, payload: bytes) -> str:
+    etag = hashlib.sha256(payload).hexdigest()[:16]
+    rows = []
+    for offset in range(0, len(payload), BYTES_PER_LINE):
+        chunk = payload[offset:offset + BYTES_PER_LINE]
+        rows.append("    " + ", ".join(f"0x{b:02x}" for b in chunk) + ",")
+
+    return "\n".join([
+        "/**",
+        " * @file IndexHtml.h",
+        " * @brief Gzip-compressed dashboard page. GENERATED by tools/build_dashboard.py",
+        " * from web/index.html - edit the HTML and re-run the script instead of this file.",
+        f" * Source {len(original.encode('utf-8'))} bytes, minified {len(minified.encode('utf-8'))} bytes, "
+        f"gzip {len(payload)} bytes.",
+        " */",
+        "",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        f"const char INDEX_HTML_ETAG[] = \"\\\"{etag}\\\"\";",
+        f"const size_t INDEX_HTML_GZ_LENGTH = {len(payload)};",
+        "const uint8_t INDEX_HTML_GZ[] PROGMEM = {",
+        *rows,
+        "};",
+        "",
+    ])
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--check", action="store_true", help="fail if IndexHtml.h does not match index.html")
+    parser.add_argument("--minified", type=Path, metavar="PATH", help="only write the minified page to PATH")
+    args = parser.parse_args()
+
+    original = SOURCE.read_text(encoding="utf-8")
+    minified = minify(original)
+    if args.minified:
+        args.minified.write_bytes(minified.encode("utf-8"))
+        return 0
+    payload = compress(minified)
+
+    # The bytes that will be served must inflate back to exactly the minified page
+    if gzip.decompress(payload).decode("utf-8") != minified:
+        print("error: compressed dashboard does not round-trip", file=sys.stderr)
+        return 1
+
+    header = render_header(original, minified, payload)
+    if args.check:
+        if not OUTPUT.exists() or OUTPUT.read_text(encoding="utf-8") != header:
+            print(f"error: {OUTPUT.relative_to(ROOT)} is stale, run tools/build_dashboard.py", file=sys.stderr)
+            return 1
+        print(f"{OUTPUT.relative_to(ROOT)} is up to date")
+        return 0
+
+    OUTPUT.write_text(header, encoding="utf-8")
+    print(f"{SOURCE.relative_to(ROOT)}: {len(original)} -> {len(minified)} minified -> {len(payload)} gzip bytes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""
+Turns an Arduino sketch (.ino) into a C++ translation unit for the native build.
+
+The Arduino IDE lets a sketch call functions before they are defined: it adds
+#include <Arduino.h> and a prototype for every top-level function before
+compiling. This does the same for CMake, inserting the prototypes just before
+the first function definition (after the sketch's own includes and types) and
+#line directives so diagnostics point into the .ino.
+
+    python3 tools/ino_to_cpp.py Arduino_Nano/Arduino_Nano.ino build/Arduino_Nano.cpp
+"""
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+# A definition's signature: return type tokens, a name and a parameter list on one line,
+# with the opening brace on the same or the next line
+SIGNATURE = re.compile(r"^([A-Za-z_][\w:<>,]*(?:[\s\*&]+[A-Za-z_][\w:<>,]*)*[\s\*&]+)([A-Za-z_]\w*)\s*\(([^()]*)\)\s*(\{.*)?$")
+NOT_TYPES = {"return", "else", "new", "delete", "case", "goto", "typedef", "using"}
+
+
+def strip_code(line: str, in_comment: bool):
+    """Removes comments and string/char literals so braces can be counted; returns (code, in_comment)."""
+    out = []
+    i = 0
+    while i < len(line):
+        if in_comment:
+            end = line.find("*/", i)
+            if end < 0:
+                return "".join(out), True
+            i = end + 2
+            in_comment = False
+            continue
+        c = line[i]
+        if line.startswith("//", i):
+            break
+        if line.startswith("/*", i):
+            in_comment = True
+            i += 2
+            continue
+        if c in "\"'":
+            j = i + 1
+            while j < len(line) and line[j] != c:
+                j += 2 if line[j] == "\\" else 1
+            out.append(c + c)
+            i = j + 1
+            continue
+        out.append(c)
+        i += 1
+    return "".join(out), in_comment
+
+
+def find_functions(lines):
+    """Returns (index of the first definition, prototypes) for the top-level function definitions."""
+    prototypes = []
+    first = None
+    depth = 0
+    in_comment = False
+    for index, line in enumerate(lines):
+        code, in_comment = strip_code(line, in_comment)
+        stripped = code.strip()
+        if depth == 0 and stripped and not stripped.startswith("#"):
+            match = SIGNATURE.match(stripped)
+            following = ""
+            if match and not match.group(4):
+                for later in lines[index + 1:]:
+                    following = later.strip()
+                    if following:
+                        break
+            if match and (match.group(4) or following.startswith("{")):
+                return_type = " ".join(match.group(1).split())
+                if return_type.split()[0] not in NOT_TYPES and "=" not in stripped:
+                    prototypes.append(f"{return_type} {match.group(2)}({match.group(3).strip()});")
+                    if first is None:
+                        first = index
+        depth += code.count("{") - code.count("}")
+    return first, prototypes
+
+
+def convert(source: Path) -> str:
+    lines = source.read_text(encoding="utf-8").splitlines()
+    first, prototypes = find_functions(lines)
+    if first is None:
+        first = len(lines)
+    # Keep the first function's doc comment attached to it
+    while first > 0 and lines[first - 1].strip().startswith(("/*", "*", "//")):
+        first -= 1
+
+    path = source.resolve().as_posix()
+    out = ["#include <Arduino.h>", f'#line 1 "{path}"']
+    out += lines[:first]
+    out += prototypes
+    out.append(f'#line {first + 1} "{path}"')
+    out += lines[first:]
+    return "\n".join(out) + "\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("sketch", type=Path)
+    parser.add_argument("output", type=Path)
+    args = parser.parse_args()
+
+    text = convert(args.sketch)
+    # Leave an unchanged output alone so the build does not recompile it
+    if not args.output.exists() or args.output.read_text(encoding="utf-8") != text:
+        args.output.parent.mkdir(parents=True, exist_ok=True)
+        args.output.write_text(text, encoding="utf-8")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())